@@ -49,9 +49,9 @@ int main(int argc, char* argv[]) {
         std::tm* local_time = std::localtime(&now_time);
 
         // Extract hour, minute, second as integers
-        hours = local_time->tm_hour;     // 0-23
-        minutes = local_time->tm_min;    // 0-59
-        seconds = local_time->tm_sec;    // 0-59
+        hours.post(local_time->tm_hour);     // 0-23
+        minutes.post(local_time->tm_min);    // 0-59
+        seconds.post(local_time->tm_sec);    // 0-59
     }, 1000);
 
     return app.exec();
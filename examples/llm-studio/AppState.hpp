@@ -4,6 +4,8 @@
 #include <Flux/Core/Typography.hpp>
 #include <string>
 #include <vector>
+#include <atomic>
+#include <memory>
 #include <chrono>
 #include <optional>
 #include <filesystem>
@@ -98,10 +100,13 @@ struct AppState {
     flux::Property<bool> leftSidebarExpanded = true;
 
     flux::Property<bool> isGenerating = false;
-    flux::Property<std::string> streamingToken = std::string("");
+    // Shared: the generation thread posts tokens to it.
+    flux::Property<std::string> streamingToken = flux::Property<std::string>::shared("");
     flux::Property<std::string> chatInput = std::string("");
 
     flux::Property<std::optional<DownloadJob>> activeDownload = std::optional<DownloadJob>(std::nullopt);
+    // Set to cancel activeDownload; its worker holds a reference and never reads the property.
+    std::shared_ptr<std::atomic<bool>> downloadCancelled;
     flux::Property<std::string> hubSearchQuery = std::string("");
 
     flux::Property<AppSettings> settings = AppSettings{};
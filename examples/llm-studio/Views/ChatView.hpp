@@ -3,6 +3,7 @@
 #include <Flux/Core/View.hpp>
 #include <Flux/Core/Types.hpp>
 #include <Flux/Core/Property.hpp>
+#include <Flux/Core/MainThreadQueue.hpp>
 #include <Flux/Core/Typography.hpp>
 #include <Flux/Views/VStack.hpp>
 #include <Flux/Views/HStack.hpp>
@@ -427,19 +428,21 @@ private:
             std::string accumulated;
             for (size_t i = 0; i < response.size(); i++) {
                 accumulated += response[i];
-                s->streamingToken = accumulated;
+                s->streamingToken.post(accumulated);
                 std::this_thread::sleep_for(std::chrono::milliseconds(15));
             }
 
-            s->updateActiveSession([&](ChatSession& session) {
-                session.messages.push_back(ChatMessage{
-                    .role = ChatMessage::Role::Assistant,
-                    .content = accumulated,
-                    .timestamp = std::chrono::system_clock::now()
+            postToMainThread([s, accumulated = std::move(accumulated)]() {
+                s->updateActiveSession([&](ChatSession& session) {
+                    session.messages.push_back(ChatMessage{
+                        .role = ChatMessage::Role::Assistant,
+                        .content = accumulated,
+                        .timestamp = std::chrono::system_clock::now()
+                    });
                 });
+                s->isGenerating = false;
+                s->streamingToken = std::string("");
             });
-            s->isGenerating = false;
-            s->streamingToken = std::string("");
         }).detach();
     }
 };
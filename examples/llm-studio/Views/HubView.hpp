@@ -3,6 +3,7 @@
 #include <Flux/Core/View.hpp>
 #include <Flux/Core/Types.hpp>
 #include <Flux/Core/Property.hpp>
+#include <Flux/Core/MainThreadQueue.hpp>
 #include <Flux/Core/Typography.hpp>
 #include <Flux/Views/VStack.hpp>
 #include <Flux/Views/HStack.hpp>
@@ -139,35 +140,45 @@ private:
             .totalBytes = size
         };
 
-        std::thread([this, repoId, quant, size]() {
+        if (state->downloadCancelled) state->downloadCancelled->store(true);
+        auto cancelled = std::make_shared<std::atomic<bool>>(false);
+        state->downloadCancelled = cancelled;
+
+        // Updates are applied on the main thread only while the download is still the current
+        // one, so a progress post already queued when Cancel is clicked cannot revive it.
+        std::thread([s = state, cancelled, repoId, quant, size]() {
             for (int i = 0; i <= 100; i++) {
-                auto dl = state->activeDownload.get();
-                if (!dl.has_value()) break;
-                state->activeDownload = DownloadJob{
+                if (cancelled->load()) return;
+                postToMainThread([s, cancelled, job = DownloadJob{
                     .modelId = repoId,
                     .variant = quant,
                     .progress = i / 100.0f,
                     .speedBytesPerSec = 2.1e9f,
                     .totalBytes = size,
                     .downloadedBytes = static_cast<uint64_t>(size * i / 100.0)
-                };
+                }]() {
+                    if (!cancelled->load()) s->activeDownload = std::optional<DownloadJob>(job);
+                });
                 std::this_thread::sleep_for(std::chrono::milliseconds(50));
             }
 
-            auto models = static_cast<std::vector<ModelInfo>>(state->installedModels);
-            std::string name = repoId;
-            auto slash = name.find('/');
-            if (slash != std::string::npos) name = name.substr(slash + 1);
-            models.push_back(ModelInfo{
-                .id = repoId,
-                .name = name,
-                .quantization = quant,
-                .type = "text",
-                .sizeBytes = size,
-                .isLoaded = false
+            postToMainThread([s, cancelled, repoId, quant, size]() {
+                if (cancelled->load()) return;
+                auto models = static_cast<std::vector<ModelInfo>>(s->installedModels);
+                std::string name = repoId;
+                auto slash = name.find('/');
+                if (slash != std::string::npos) name = name.substr(slash + 1);
+                models.push_back(ModelInfo{
+                    .id = repoId,
+                    .name = name,
+                    .quantization = quant,
+                    .type = "text",
+                    .sizeBytes = size,
+                    .isLoaded = false
+                });
+                s->installedModels = std::move(models);
+                s->activeDownload = std::optional<DownloadJob>(std::nullopt);
             });
-            state->installedModels = std::move(models);
-            state->activeDownload = std::optional<DownloadJob>(std::nullopt);
         }).detach();
     }
 };
@@ -297,6 +308,7 @@ struct HubView {
                                 .padding = EdgeInsets(4, 8, 4, 8),
                                 .cornerRadius = 4.0f,
                                 .onClick = [this]() {
+                                    if (state->downloadCancelled) state->downloadCancelled->store(true);
                                     state->activeDownload = std::optional<DownloadJob>(std::nullopt);
                                 }
                             }
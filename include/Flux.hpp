@@ -12,6 +12,7 @@
 #include <Flux/Core/Utilities.hpp>
 #include <Flux/Core/ControlMetrics.hpp>
 #include <Flux/Core/Application.hpp>
+#include <Flux/Core/MainThreadQueue.hpp>
 #include <Flux/Core/Window.hpp>
 
 #include <Flux/Platform/PlatformWindow.hpp>
@@ -30,6 +31,7 @@
 #include <Flux/Views/Grid.hpp>
 #include <Flux/Views/HStack.hpp>
 #include <Flux/Views/Image.hpp>
+#include <Flux/Views/LazyList.hpp>
 #include <Flux/Views/ProgressBar.hpp>
 #include <Flux/Views/RadioButton.hpp>
 #include <Flux/Views/ScrollArea.hpp>
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Flux/Core/Theme.hpp>
+#include <Flux/Core/FrameScheduler.hpp>
 #include <Flux/Core/WindowEventObserver.hpp>
 #include <Flux/Core/ResourceManager.hpp>
 #include <atomic>
@@ -40,6 +41,9 @@ public:
 
     void requestRedraw();
 
+    /// Paces rendering; see FrameScheduler (60 fps by default).
+    FrameScheduler& frameScheduler() { return frameScheduler_; }
+
     bool isTestMode() const { return testMode_; }
     int testPort() const { return testPort_; }
     const std::string& testSocketPath() const { return testSocketPath_; }
@@ -55,6 +59,7 @@ private:
     void waitForEventsImpl(int timeoutMs);
 
     std::atomic<bool> needsRedraw_{false};
+    FrameScheduler frameScheduler_;
     std::atomic<uint64_t> bodyGeneration_{0};
     bool running_{true};
     std::vector<std::unique_ptr<Window>> windows_;
@@ -8,7 +8,21 @@
 namespace flux {
 
 class View;
+class ViewInterface;
 struct LayoutNode;
+class Element;
+
+// A view's subscription to the shared properties it reads while building its
+// body, laying out, measuring or rendering. Each ViewAdapter owns one; shared
+// property state keeps weak references to its readers. A change bumps
+// changeCount (stale cached body and measurements) and marks the bound
+// element dirty.
+struct PropertyObserver {
+    Element* element = nullptr;
+    uint64_t changeCount = 0;
+
+    void propertyChanged();
+};
 
 class Element {
 public:
@@ -22,13 +36,15 @@ public:
 
     bool isMounted = false;
     bool bodyDirty = true;
+    // Set on this element and every ancestor by markDirty(); cleared when the
+    // element is reconciled against a freshly laid out node.
     bool layoutDirty = true;
 
     Rect cachedBounds = {0, 0, 0, 0};
     Rect lastConstraints = {0, 0, 0, 0};
 
     // Monotonic version bumped when this element's render output changes.
-    // Used by CommandCompiler to skip recompilation of unchanged elements.
+    // Used by the Renderer to replay the recorded commands of unchanged subtrees.
     uint64_t renderVersion_ = 0;
     // Max of renderVersion_ across this element and all descendants.
     uint64_t subtreeRenderVersion_ = 0;
@@ -37,8 +53,15 @@ public:
         return !layoutDirty && cachedBounds.width > 0;
     }
 
+    // Invalidates this element's body and the layout of its ancestors, and
+    // schedules a redraw without bumping the global body generation: elements
+    // outside the dirty path keep their cached bodies and retained layout.
     void markDirty();
 
+    // Invalidates only what this element last rendered: it and its ancestors are
+    // rendered afresh next frame instead of replayed. Body and layout stay cached.
+    void markRenderDirty();
+
     Element();
     ~Element();
 
@@ -47,18 +70,97 @@ public:
     Element(Element&&) noexcept;
     Element& operator=(Element&&) noexcept;
 
-    static std::unique_ptr<Element> buildTree(const LayoutNode& node, size_t index = 0);
+    // The element tree keeps pointers into the LayoutNode tree it was built from
+    // or reconciled against, so that clean subtrees can be handed back to the next
+    // layout pass instead of being laid out again (see takeRetainedLayout).
+    static std::unique_ptr<Element> buildTree(LayoutNode& node, size_t index = 0);
 
-    void reconcile(const LayoutNode& newNode);
+    void reconcile(LayoutNode& newNode);
 
     Element* findByFocusKey(const std::string& key);
 
     void bumpRenderVersion();
 
+    // Retained layout
+    //
+    // Returns the node produced for `element` by the previous layout pass when it
+    // can be reused as-is: the element and its subtree are clean, the body
+    // generation has not changed, `bounds` equals lastConstraints and the node
+    // still belongs to `view`. The caller moves the subtree out of the old tree;
+    // reconcile() then re-attaches it without walking its descendants.
+    static LayoutNode* takeRetainedLayout(Element* element, const ViewInterface* view, const Rect& bounds);
+
+    // Brackets a fresh ViewAdapter::layout call for `element` (which may be null
+    // for views that are not mounted yet). Only direct descendants of the
+    // innermost open scope may hand out retained nodes.
+    class LayoutScope {
+    public:
+        explicit LayoutScope(Element* element);
+        ~LayoutScope();
+
+        LayoutScope(const LayoutScope&) = delete;
+        LayoutScope& operator=(const LayoutScope&) = delete;
+
+    private:
+        bool blocking_ = false;
+    };
+
+    // State a view builds up over successive layouts (e.g. measured row heights),
+    // kept on its element under `tag`. Call from layout(). Null unless the view
+    // being laid out is mounted.
+    static std::shared_ptr<void>* layoutState(const void* tag);
+    // For a view that is not mounted yet: the state kept under `tag` by the
+    // element with the same non-empty `key` below the nearest mounted ancestor
+    // being laid out, which reconcile() will hand the view's element. Unkeyed
+    // views get nothing and carry their state over in transferState().
+    static std::shared_ptr<void> keyedLayoutState(const void* tag, const std::string& key);
+
+    // Shared properties read while a scope is open register `observer` as a
+    // reader (see PropertyObserver).
+    class PropertyReadScope {
+    public:
+        explicit PropertyReadScope(const std::shared_ptr<PropertyObserver>& observer);
+        ~PropertyReadScope();
+
+        PropertyReadScope(const PropertyReadScope&) = delete;
+        PropertyReadScope& operator=(const PropertyReadScope&) = delete;
+
+    private:
+        const std::shared_ptr<PropertyObserver>* previous_;
+    };
+
+    // Brackets an event handler of the view mounted at `target`. An inline
+    // property written by the handler that lives inside the component of
+    // `target` or one of its ancestors dirties only that element; any other
+    // inline write falls back to a full body regeneration.
+    class EventScope {
+    public:
+        explicit EventScope(Element* target);
+        ~EventScope();
+
+        EventScope(const EventScope&) = delete;
+        EventScope& operator=(const EventScope&) = delete;
+
+    private:
+        Element* previous_;
+    };
+
 private:
     static uint64_t sNextRenderVersion_;
 
-    void reconcileChildren(const std::vector<LayoutNode>& newChildren);
+    enum class RetainState : uint8_t { None, Reused, Relaid };
+
+    LayoutNode* layoutNode_ = nullptr;
+    uint64_t layoutGeneration_ = 0;
+    RetainState retainState_ = RetainState::None;
+
+    const void* layoutStateTag_ = nullptr;
+    std::shared_ptr<void> layoutState_;
+    // Keyed descendants holding layout state, collected once per layout scope.
+    std::vector<Element*> layoutStateHolders_;
+    bool layoutStateScanned_ = false;
+
+    void reconcileChildren(std::vector<LayoutNode>& newChildren);
     void mountSubtree();
     void unmountSubtree();
 };
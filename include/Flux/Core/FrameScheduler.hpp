@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+
+namespace flux {
+
+/**
+ * Decides when `Application::exec` renders.
+ *
+ * Redraw requests only mark a frame pending; frames render at most once per frame interval,
+ * so any number of requests between two frames cost one render. The interval is the target
+ * frame rate's period, rounded up to whole display refreshes when the platform reports its
+ * refresh rate, and counted from the end of the last frame: with vsync-paced presentation
+ * that is just after a refresh, so frames stay on the refresh grid. A request after an idle
+ * stretch renders at once. With nothing pending and no timed frame, the loop sleeps until
+ * an event arrives.
+ */
+class FrameScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Frames per second to render at most; 0 renders as soon as a frame is requested.
+    void setTargetFrameRate(double fps) { targetFps_ = fps > 0 ? fps : 0; }
+    double targetFrameRate() const { return targetFps_; }
+
+    /// Refresh rate of the display the windows are on, in Hz; 0 when unknown.
+    void setRefreshRate(double hz) { refreshHz_ = hz > 0 ? hz : 0; }
+    double refreshRate() const { return refreshHz_; }
+
+    Clock::duration frameInterval() const;
+
+    /// Renders a frame at `when` even if no redraw is requested (e.g. a cursor blink).
+    /// The earliest of several timed frames wins.
+    void requestFrameAt(Clock::time_point when);
+
+    /// Time from `now` until the next frame should render: zero when one is due, nullopt
+    /// when nothing is pending or scheduled.
+    std::optional<Clock::duration> timeUntilFrame(bool redrawPending, Clock::time_point now) const;
+    bool frameDue(bool redrawPending, Clock::time_point now) const {
+        auto wait = timeUntilFrame(redrawPending, now);
+        return wait && *wait == Clock::duration::zero();
+    }
+
+    /// Call after rendering, with the time rendering finished.
+    void frameRendered(Clock::time_point now);
+    std::optional<Clock::time_point> lastFrameTime() const { return lastFrame_; }
+
+private:
+    double targetFps_ = 60;
+    double refreshHz_ = 0;
+    std::optional<Clock::time_point> lastFrame_;
+    std::optional<Clock::time_point> timedFrame_;
+};
+
+} // namespace flux
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+
+namespace flux {
+
+/**
+ * Lock-free multi-producer queue of work for the main thread.
+ *
+ * Any thread may `post`; `Application::exec` drains the queue once at the start of each frame.
+ * Producers push onto an intrusive stack with a CAS; the consumer takes the whole stack with one
+ * exchange and runs it in posting order. Tasks posted under the same non-null key coalesce:
+ * only the last one posted before a drain runs, so a burst of writes to one property costs one
+ * assignment. A drain runs inside one PropertyBatch, so everything it applies shares a single
+ * invalidation. The first post after a drain wakes the event loop; later posts in the same
+ * burst do not.
+ */
+class MainThreadQueue {
+public:
+    using WakeHandler = void (*)();
+
+    MainThreadQueue() = default;
+    ~MainThreadQueue();
+
+    MainThreadQueue(const MainThreadQueue&) = delete;
+    MainThreadQueue& operator=(const MainThreadQueue&) = delete;
+
+    static MainThreadQueue& instance();
+
+    /// Called (from the posting thread) when the queue goes from drained to non-empty.
+    void setWakeHandler(WakeHandler handler) { wake_.store(handler, std::memory_order_release); }
+
+    void post(std::function<void()> task) { post(nullptr, std::move(task)); }
+    void post(const void* key, std::function<void()> task);
+
+    struct DrainStats {
+        size_t executed = 0;
+        size_t coalesced = 0;
+    };
+
+    /// Runs everything posted so far. Main thread only; tasks posted while draining run in the
+    /// next drain.
+    DrainStats drain();
+
+    bool empty() const { return head_.load(std::memory_order_acquire) == nullptr; }
+
+private:
+    struct Node {
+        Node* next = nullptr;
+        const void* key = nullptr;
+        std::function<void()> task;
+    };
+
+    std::atomic<Node*> head_{nullptr};
+    std::atomic<bool> wakePending_{false};
+    std::atomic<WakeHandler> wake_{nullptr};
+};
+
+/// Runs `task` on the main thread at the start of the next frame. Safe from any thread.
+void postToMainThread(std::function<void()> task);
+
+} // namespace flux
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <Flux/Core/Log.hpp>
+#include <cassert>
 #include <functional>
 #include <variant>
 #include <memory>
@@ -7,16 +9,52 @@
 #include <concepts>
 #include <atomic>
 #include <string>
+#include <vector>
+#include <utility>
 #include <format>
 
 namespace flux {
 
 class Element;
+struct PropertyObserver;
 void requestApplicationRedraw();
+void requestRedrawOnly();
 void suppressRedrawRequests();
 void resumeRedrawRequests();
+// Redraw requests issued on any thread so far, not counting suppressed ones.
+uint64_t redrawRequestCount();
 uint64_t currentBodyGeneration();
 
+// Change propagation (Element.cpp). Shared writes dirty the owner and every
+// mounted reader; inline writes from an event handler dirty the element whose
+// component holds the property. Anything unattributed regenerates all bodies.
+void trackSharedPropertyRead(std::vector<std::weak_ptr<PropertyObserver>>& readers);
+void notifySharedPropertyChange(Element* owner, std::vector<std::weak_ptr<PropertyObserver>>& readers);
+void notifyInlinePropertyChange(const void* property);
+
+// Defers the change notifications of property writes made on this thread until
+// the outermost open batch closes. The batch then dirties each touched element
+// once and requests a single redraw (regenerating all bodies only if some write
+// reached no mounted element). Frames must not run while a batch is open.
+class PropertyBatch {
+public:
+    PropertyBatch();
+    ~PropertyBatch();
+
+    PropertyBatch(const PropertyBatch&) = delete;
+    PropertyBatch& operator=(const PropertyBatch&) = delete;
+};
+
+template<typename F>
+decltype(auto) batch(F&& fn) {
+    PropertyBatch scope;
+    return std::forward<F>(fn)();
+}
+
+// Cross-thread writes (MainThreadQueue.cpp). Queues `write` for the start of the
+// next frame; a later write under the same key replaces a pending one.
+void postPropertyWrite(const void* key, std::function<void()> write);
+
 // Property<T> — a flexible wrapper with three storage modes:
 //
 //   Inline (default)  — stores T directly, zero heap allocation, no mutex.
@@ -24,17 +62,22 @@ uint64_t currentBodyGeneration();
 //                        Copies are independent (value semantics).
 //
 //   Shared (opt-in)   — heap-allocated via shared_ptr, supports binding (copies
-//                        share storage) and owner-targeted dirty notification.
+//                        share storage) and targeted dirty notification of the
+//                        owner and of the views that read it.
 //                        Create with Property<T>::shared(value).
 //
 //   Computed (lambda)  — evaluates a std::function<T()> on every read.
 //
+// Reads and assignments are main-thread only. Other threads use post(), which
+// queues the write for the start of the next frame and coalesces bursts.
+//
 template<typename T>
 class Property {
 private:
     struct SharedState {
         T value;
         Element* owner = nullptr;
+        std::vector<std::weak_ptr<PropertyObserver>> readers;
 
         SharedState(T initial) : value(std::move(initial)) {}
 
@@ -114,10 +157,10 @@ public:
                 if (std::get<T>(storage_) == newValue) return *this;
             }
             std::get<T>(storage_) = newValue;
-            requestApplicationRedraw();
+            notifyInlinePropertyChange(this);
         } else {
             storage_ = newValue;
-            requestApplicationRedraw();
+            notifyInlinePropertyChange(this);
         }
         return *this;
     }
@@ -135,10 +178,10 @@ public:
                 if (std::get<T>(storage_) == newValue) return *this;
             }
             std::get<T>(storage_) = std::move(newValue);
-            requestApplicationRedraw();
+            notifyInlinePropertyChange(this);
         } else {
             storage_ = std::move(newValue);
-            requestApplicationRedraw();
+            notifyInlinePropertyChange(this);
         }
         return *this;
     }
@@ -169,7 +212,7 @@ public:
             ss->notifyChange();
         } else if (std::holds_alternative<T>(storage_)) {
             ++std::get<T>(storage_);
-            requestApplicationRedraw();
+            notifyInlinePropertyChange(this);
         }
         return *this;
     }
@@ -184,7 +227,7 @@ public:
             return old;
         } else if (std::holds_alternative<T>(storage_)) {
             T old = std::get<T>(storage_)++;
-            requestApplicationRedraw();
+            notifyInlinePropertyChange(this);
             return old;
         }
         return T{};
@@ -199,7 +242,7 @@ public:
             ss->notifyChange();
         } else if (std::holds_alternative<T>(storage_)) {
             --std::get<T>(storage_);
-            requestApplicationRedraw();
+            notifyInlinePropertyChange(this);
         }
         return *this;
     }
@@ -214,7 +257,7 @@ public:
             return old;
         } else if (std::holds_alternative<T>(storage_)) {
             T old = std::get<T>(storage_)--;
-            requestApplicationRedraw();
+            notifyInlinePropertyChange(this);
             return old;
         }
         return T{};
@@ -229,7 +272,7 @@ public:
             ss->notifyChange();
         } else if (std::holds_alternative<T>(storage_)) {
             std::get<T>(storage_) += val;
-            requestApplicationRedraw();
+            notifyInlinePropertyChange(this);
         }
         return *this;
     }
@@ -243,7 +286,7 @@ public:
             ss->notifyChange();
         } else if (std::holds_alternative<T>(storage_)) {
             std::get<T>(storage_) -= val;
-            requestApplicationRedraw();
+            notifyInlinePropertyChange(this);
         }
         return *this;
     }
@@ -290,12 +333,32 @@ public:
     requires requires(const U& u, const U& v) { u / v; }
     T operator/(const T& other) const { return get() / other; }
 
+    // Thread-safe write: applied on the main thread at the start of the next
+    // frame. Writes posted to the same property before then coalesce into the
+    // last one. Shared properties only: the write keeps their storage alive
+    // until it lands, while an inline property lives in a component that may
+    // be copied or destroyed first.
+    void post(T value) {
+        auto* ss = std::get_if<std::shared_ptr<SharedState>>(&storage_);
+        if (!ss) {
+            FLUX_LOG_ERROR("Property::post() needs a shared property; the write is dropped");
+            assert(false && "Property::post() needs a shared property");
+            return;
+        }
+        postPropertyWrite(ss->get(), [state = *ss, v = std::move(value)]() mutable {
+            Property bound;
+            bound.storage_ = std::move(state);
+            bound = std::move(v);
+        });
+    }
+
     // Read — fast path for inline (no mutex, no visit overhead)
     T get() const {
         if (auto* val = std::get_if<T>(&storage_)) {
             return *val;
         }
         if (auto* ss = std::get_if<std::shared_ptr<SharedState>>(&storage_)) {
+            trackSharedPropertyRead((*ss)->readers);
             return (*ss)->value;
         }
         return std::get<std::function<T()>>(storage_)();
@@ -329,6 +392,7 @@ private:
     struct SharedState {
         std::vector<T> value;
         Element* owner = nullptr;
+        std::vector<std::weak_ptr<PropertyObserver>> readers;
 
         SharedState(std::vector<T> initial) : value(std::move(initial)) {}
 
@@ -389,7 +453,7 @@ public:
             ss->notifyChange();
         } else {
             storage_ = value;
-            requestApplicationRedraw();
+            notifyInlinePropertyChange(this);
         }
         return *this;
     }
@@ -404,7 +468,7 @@ public:
             ss->notifyChange();
         } else {
             storage_ = std::move(value);
-            requestApplicationRedraw();
+            notifyInlinePropertyChange(this);
         }
         return *this;
     }
@@ -416,7 +480,7 @@ public:
             ss->notifyChange();
         } else {
             storage_ = std::vector<T>(init);
-            requestApplicationRedraw();
+            notifyInlinePropertyChange(this);
         }
         return *this;
     }
@@ -428,11 +492,31 @@ public:
         return *this;
     }
 
+    // Thread-safe write: applied on the main thread at the start of the next
+    // frame. Writes posted to the same property before then coalesce into the
+    // last one. Shared properties only: the write keeps their storage alive
+    // until it lands, while an inline property lives in a component that may
+    // be copied or destroyed first.
+    void post(std::vector<T> value) {
+        auto* ss = std::get_if<std::shared_ptr<SharedState>>(&storage_);
+        if (!ss) {
+            FLUX_LOG_ERROR("Property::post() needs a shared property; the write is dropped");
+            assert(false && "Property::post() needs a shared property");
+            return;
+        }
+        postPropertyWrite(ss->get(), [state = *ss, v = std::move(value)]() mutable {
+            Property bound;
+            bound.storage_ = std::move(state);
+            bound = std::move(v);
+        });
+    }
+
     std::vector<T> get() const {
         if (auto* val = std::get_if<std::vector<T>>(&storage_)) {
             return *val;
         }
         if (auto* ss = std::get_if<std::shared_ptr<SharedState>>(&storage_)) {
+            trackSharedPropertyRead((*ss)->readers);
             return (*ss)->value;
         }
         return std::get<std::function<std::vector<T>()>>(storage_)();
@@ -465,20 +549,12 @@ namespace flux {
 
 template<typename T>
 void Property<T>::SharedState::notifyChange() {
-    if (owner) {
-        owner->markDirty();
-    } else {
-        requestApplicationRedraw();
-    }
+    notifySharedPropertyChange(owner, readers);
 }
 
 template<typename T>
 void Property<std::vector<T>>::SharedState::notifyChange() {
-    if (owner) {
-        owner->markDirty();
-    } else {
-        requestApplicationRedraw();
-    }
+    notifySharedPropertyChange(owner, readers);
 }
 
 } // namespace flux
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace flux {
+
+/**
+ * Fixed set of worker threads for fork-join work.
+ *
+ * `parallelFor` hands indices out to the workers and the calling thread alike and returns once
+ * every index has run. Each call passes the slot of the thread running it, so callers can keep
+ * per-thread scratch state without locking. One `parallelFor` at a time.
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t threadCount() const { return threads_.size(); }
+    /// Slots passed to tasks: one per worker plus one for the calling thread.
+    size_t slotCount() const { return threads_.size() + 1; }
+
+    using Task = std::function<void(size_t index, size_t slot)>;
+    /// Runs `task(index, slot)` for every index in [0, count). The caller runs in slot
+    /// threadCount().
+    void parallelFor(size_t count, const Task& task);
+
+private:
+    void workerLoop(size_t slot);
+    void runIndices(size_t slot);
+
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    const Task* task_ = nullptr;
+    size_t count_ = 0;
+    std::atomic<size_t> next_{0};
+    size_t busy_ = 0;
+    uint64_t generation_ = 0;
+    bool stopping_ = false;
+};
+
+} // namespace flux
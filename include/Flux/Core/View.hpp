@@ -4,6 +4,7 @@
 
 #include <Flux/Core/ViewInterface.hpp>
 #include <Flux/Core/ViewTraits.hpp>
+#include <Flux/Core/Element.hpp>
 
 #include <memory>
 #include <optional>
@@ -166,6 +167,18 @@ public:
         if (component_) component_->setPropertyOwner(owner);
     }
 
+    void bindElement(Element* element) {
+        if (component_) component_->bindElement(element);
+    }
+
+    void unbindElement(Element* element) {
+        if (component_) component_->unbindElement(element);
+    }
+
+    Element* boundElement() const {
+        return component_ ? component_->boundElement() : nullptr;
+    }
+
     std::optional<CursorType> getCursor() const {
         return component_ ? component_->getCursor() : std::nullopt;
     }
@@ -225,6 +238,14 @@ struct LayoutNode {
 };
 
 inline LayoutNode View::layout(RenderContext& ctx, const Rect& bounds) const {
+    // Clean subtree with unchanged bounds: hand back last frame's node instead of
+    // running layout (and, in reconcile, instead of walking its descendants).
+    Element* element = component_->boundElement();
+    if (LayoutNode* retained = Element::takeRetainedLayout(element, component_.get(), bounds)) {
+        return std::move(*retained);
+    }
+
+    Element::LayoutScope scope(element);
     LayoutNode node = component_->layout(ctx, bounds);
     // Preserve ViewAdapter identity: the default layout creates a fresh
     // View(component) copy each frame, losing mutable state (e.g. caret
@@ -3,6 +3,8 @@
 #include <Flux/Core/ViewInterface.hpp>
 #include <Flux/Core/ViewTraits.hpp>
 #include <Flux/Core/ViewHelpers.hpp>
+#include <Flux/Core/Element.hpp>
+#include <array>
 #include <memory>
 #include <typeinfo>
 #include <cstdio>
@@ -15,8 +17,33 @@ private:
     mutable T component;
     mutable std::unique_ptr<View> cachedBody_;
     mutable uint64_t cachedBodyGen_ = 0;
+    mutable uint64_t cachedBodyChanges_ = 0;
+    mutable std::shared_ptr<PropertyObserver> observer_;
+    Element* element_ = nullptr;
+    bool elementShared_ = false;
+
+    // Measurement memo: preferredSize() and the last few heightForWidth() widths,
+    // valid for one body generation until a property this view (or a descendant)
+    // reads changes. Nested stacks measure their descendants at every level; this
+    // keeps each view to one measurement per distinct width.
+    struct MeasureCache {
+        static constexpr size_t kWidthSlots = 4;
+        uint64_t generation = 0;
+        uint64_t changes = 0;
+        bool valid = false;
+        std::optional<Size> preferred;
+        std::array<std::pair<float, float>, kWidthSlots> heights{};
+        size_t heightCount = 0;
+        size_t nextSlot = 0;
+    };
+    mutable MeasureCache measureCache_;
 
     const View& getCachedBody() const;
+    const std::shared_ptr<PropertyObserver>& observer() const;
+    uint64_t observedChanges() const { return observer_ ? observer_->changeCount : 0; }
+    MeasureCache* currentMeasureCache() const;
+    Size computePreferredSize(TextMeasurement& textMeasurer) const;
+    float computeHeightForWidth(float width, TextMeasurement& textMeasurer) const;
 
 public:
     ViewAdapter(const T& comp) : component(comp) {
@@ -69,6 +96,31 @@ public:
     std::string getKey() const override;
 
     void setPropertyOwner(Element* owner) override;
+
+    void bindElement(Element* element) override {
+        if (element_ && element_ != element) elementShared_ = true;
+        element_ = element;
+        if (observer_) observer_->element = boundElement();
+    }
+    void unbindElement(Element* element) override {
+        if (element_ == element) element_ = nullptr;
+        if (observer_) observer_->element = boundElement();
+    }
+    Element* boundElement() const override {
+        return elementShared_ ? nullptr : element_;
+    }
+
+    void invalidateBody() override {
+        if (observer_) ++observer_->changeCount;
+    }
+    void invalidateMeasurements() override {
+        measureCache_.valid = false;
+    }
+    bool containsAddress(const void* address) const override {
+        auto* p = static_cast<const unsigned char*>(address);
+        auto* begin = reinterpret_cast<const unsigned char*>(&component);
+        return p >= begin && p < begin + sizeof(T);
+    }
     
     std::optional<CursorType> getCursor() const override;
 
@@ -89,6 +141,7 @@ public:
 
 template<ViewComponent T>
 inline LayoutNode ViewAdapter<T>::layout(RenderContext& ctx, const Rect& bounds) const {
+    Element::PropertyReadScope readScope(observer());
     if constexpr (has_layout<T>::value) {
         return component.layout(ctx, bounds);
     } else {
@@ -132,13 +185,26 @@ inline LayoutNode ViewAdapter<T>::layout(RenderContext& ctx, const Rect& bounds)
     }
 }
 
+template<ViewComponent T>
+inline const std::shared_ptr<PropertyObserver>& ViewAdapter<T>::observer() const {
+    if (!observer_) {
+        observer_ = std::make_shared<PropertyObserver>();
+        observer_->element = boundElement();
+    }
+    return observer_;
+}
+
 template<ViewComponent T>
 inline const View& ViewAdapter<T>::getCachedBody() const {
     if constexpr (has_body<T>::value) {
+        // Rebuilt when all bodies are regenerated, or when a property this body
+        // read (or one owned by the mounted element) changed.
         uint64_t gen = currentBodyGeneration();
-        if (!cachedBody_ || cachedBodyGen_ != gen) {
+        if (!cachedBody_ || cachedBodyGen_ != gen || cachedBodyChanges_ != observedChanges()) {
+            Element::PropertyReadScope readScope(observer());
             cachedBody_ = std::make_unique<View>(component.body());
             cachedBodyGen_ = gen;
+            cachedBodyChanges_ = observedChanges();
         }
     } else if (!cachedBody_) {
         cachedBody_ = std::make_unique<View>();
@@ -153,6 +219,7 @@ inline View ViewAdapter<T>::body() const {
 
 template<ViewComponent T>
 inline void ViewAdapter<T>::render(RenderContext& ctx, const Rect& bounds) const {
+    Element::PropertyReadScope readScope(observer());
     if constexpr (has_render<T>::value) {
         component.render(ctx, bounds);
     }
@@ -166,8 +233,54 @@ inline void ViewAdapter<T>::render(RenderContext& ctx, const Rect& bounds) const
     }
 }
 
+template<ViewComponent T>
+inline typename ViewAdapter<T>::MeasureCache* ViewAdapter<T>::currentMeasureCache() const {
+    uint64_t gen = currentBodyGeneration();
+    uint64_t changes = observedChanges();
+    if (!measureCache_.valid || measureCache_.generation != gen || measureCache_.changes != changes) {
+        measureCache_ = MeasureCache{};
+        measureCache_.generation = gen;
+        measureCache_.changes = changes;
+        measureCache_.valid = true;
+    }
+    return &measureCache_;
+}
+
 template<ViewComponent T>
 inline Size ViewAdapter<T>::preferredSize(TextMeasurement& textMeasurer) const {
+    MeasureCache* cache = currentMeasureCache();
+    if (cache && cache->preferred) {
+        return *cache->preferred;
+    }
+    Size size = computePreferredSize(textMeasurer);
+    if (cache) {
+        cache->preferred = size;
+    }
+    return size;
+}
+
+template<ViewComponent T>
+inline float ViewAdapter<T>::heightForWidth(float width, TextMeasurement& textMeasurer) const {
+    MeasureCache* cache = currentMeasureCache();
+    if (cache) {
+        for (size_t i = 0; i < cache->heightCount; ++i) {
+            if (cache->heights[i].first == width) {
+                return cache->heights[i].second;
+            }
+        }
+    }
+    float height = computeHeightForWidth(width, textMeasurer);
+    if (cache) {
+        cache->heights[cache->nextSlot] = {width, height};
+        cache->nextSlot = (cache->nextSlot + 1) % MeasureCache::kWidthSlots;
+        cache->heightCount = std::min(cache->heightCount + 1, MeasureCache::kWidthSlots);
+    }
+    return height;
+}
+
+template<ViewComponent T>
+inline Size ViewAdapter<T>::computePreferredSize(TextMeasurement& textMeasurer) const {
+    Element::PropertyReadScope readScope(observer());
     if constexpr (has_preferredSize<T>::value) {
         return component.preferredSize(textMeasurer);
     } else if constexpr (has_body<T>::value) {
@@ -184,7 +297,8 @@ inline Size ViewAdapter<T>::preferredSize(TextMeasurement& textMeasurer) const {
 }
 
 template<ViewComponent T>
-inline float ViewAdapter<T>::heightForWidth(float width, TextMeasurement& textMeasurer) const {
+inline float ViewAdapter<T>::computeHeightForWidth(float width, TextMeasurement& textMeasurer) const {
+    Element::PropertyReadScope readScope(observer());
     if constexpr (has_heightForWidth<T>::value) {
         return component.heightForWidth(width, textMeasurer);
     } else if constexpr (has_body<T>::value) {
@@ -271,6 +385,7 @@ inline std::vector<View> ViewAdapter<T>::getChildren() const {
 
 template<ViewComponent T>
 inline bool ViewAdapter<T>::handleMouseDown(float x, float y, int button) {
+    Element::EventScope eventScope(boundElement());
     bool handled = false;
     if constexpr (has_onMouseDown<T>::value) {
         if (component.onMouseDown) { component.onMouseDown(x, y, button); handled = true; }
@@ -283,6 +398,7 @@ inline bool ViewAdapter<T>::handleMouseDown(float x, float y, int button) {
 
 template<ViewComponent T>
 inline bool ViewAdapter<T>::handleMouseUp(float x, float y, int button) {
+    Element::EventScope eventScope(boundElement());
     bool handled = false;
     if constexpr (has_onMouseUp<T>::value) {
         if (component.onMouseUp) { component.onMouseUp(x, y, button); handled = true; }
@@ -295,6 +411,7 @@ inline bool ViewAdapter<T>::handleMouseUp(float x, float y, int button) {
 
 template<ViewComponent T>
 inline bool ViewAdapter<T>::handleMouseMove(float x, float y) {
+    Element::EventScope eventScope(boundElement());
     if constexpr (has_onMouseMove<T>::value) {
         if (component.onMouseMove) { component.onMouseMove(x, y); return true; }
     }
@@ -303,6 +420,7 @@ inline bool ViewAdapter<T>::handleMouseMove(float x, float y) {
 
 template<ViewComponent T>
 inline void ViewAdapter<T>::handleMouseEnter() {
+    Element::EventScope eventScope(boundElement());
     if constexpr (has_onMouseEnter<T>::value) {
         if (component.onMouseEnter) component.onMouseEnter();
     }
@@ -310,6 +428,7 @@ inline void ViewAdapter<T>::handleMouseEnter() {
 
 template<ViewComponent T>
 inline void ViewAdapter<T>::handleMouseLeave() {
+    Element::EventScope eventScope(boundElement());
     if constexpr (has_onMouseLeave<T>::value) {
         if (component.onMouseLeave) component.onMouseLeave();
     }
@@ -317,6 +436,7 @@ inline void ViewAdapter<T>::handleMouseLeave() {
 
 template<ViewComponent T>
 inline bool ViewAdapter<T>::handleMouseScroll(float x, float y, float deltaX, float deltaY) {
+    Element::EventScope eventScope(boundElement());
     if constexpr (has_onScroll<T>::value) {
         if (component.onScroll) { component.onScroll(x, y, deltaX, deltaY); return true; }
     }
@@ -339,6 +459,7 @@ inline bool ViewAdapter<T>::isInteractive() const {
 
 template<ViewComponent T>
 inline bool ViewAdapter<T>::capturePointerEvent(PointerEvent& event) {
+    Element::EventScope eventScope(boundElement());
     if constexpr (has_capturePointerEvent<T>::value) {
         return component.capturePointerEvent(event);
     }
@@ -352,6 +473,7 @@ inline std::optional<CursorType> ViewAdapter<T>::getCursor() const {
 
 template<ViewComponent T>
 inline bool ViewAdapter<T>::handleKeyDown(const KeyEvent& event) {
+    Element::EventScope eventScope(boundElement());
     if constexpr (has_handleKeyDown<T>::value) {
         bool handled = component.handleKeyDown(event);
         if (handled) return true;
@@ -364,6 +486,7 @@ inline bool ViewAdapter<T>::handleKeyDown(const KeyEvent& event) {
 
 template<ViewComponent T>
 inline bool ViewAdapter<T>::handleKeyUp(const KeyEvent& event) {
+    Element::EventScope eventScope(boundElement());
     if constexpr (has_handleKeyUp<T>::value) {
         bool handled = component.handleKeyUp(event);
         if (handled) return true;
@@ -376,6 +499,7 @@ inline bool ViewAdapter<T>::handleKeyUp(const KeyEvent& event) {
 
 template<ViewComponent T>
 inline bool ViewAdapter<T>::handleTextInput(const TextInputEvent& event) {
+    Element::EventScope eventScope(boundElement());
     if constexpr (has_handleTextInput<T>::value) {
         bool handled = component.handleTextInput(event);
         if (handled) return true;
@@ -428,6 +552,7 @@ inline void ViewAdapter<T>::setPropertyOwner(Element* owner) {
 
 template<ViewComponent T>
 inline void ViewAdapter<T>::notifyFocusGained() {
+    Element::EventScope eventScope(boundElement());
     if constexpr (has_onFocus<T>::value) {
         if (component.onFocus) component.onFocus();
     }
@@ -435,6 +560,7 @@ inline void ViewAdapter<T>::notifyFocusGained() {
 
 template<ViewComponent T>
 inline void ViewAdapter<T>::notifyFocusLost() {
+    Element::EventScope eventScope(boundElement());
     if constexpr (has_onBlur<T>::value) {
         if (component.onBlur) component.onBlur();
     }
@@ -479,6 +605,7 @@ inline std::string ViewAdapter<T>::getSelectedText() const {
 
 template<ViewComponent T>
 inline std::string ViewAdapter<T>::cutSelectedText() {
+    Element::EventScope eventScope(boundElement());
     if constexpr (has_selection_state<T>::value) {
         if (component.selStart != component.selEnd) {
             std::string val = component.value;
@@ -123,6 +123,19 @@ public:
     // Property ownership
     virtual void setPropertyOwner(Element* owner) { (void)owner; }
 
+    // Retained layout: the mounted Element presenting this view. Returns null
+    // once the view has been mounted by more than one Element.
+    virtual void bindElement(Element* element) { (void)element; }
+    virtual void unbindElement(Element* element) { (void)element; }
+    virtual Element* boundElement() const { return nullptr; }
+
+    // Targeted invalidation (Element::markDirty): drop the cached body / the
+    // memoized measurements. containsAddress tells whether an inline property
+    // written by an event handler is a member of this view's component.
+    virtual void invalidateBody() {}
+    virtual void invalidateMeasurements() {}
+    virtual bool containsAddress(const void* address) const { (void)address; return false; }
+
     // Cursor
     virtual std::optional<CursorType> getCursor() const = 0;
 
@@ -28,6 +28,15 @@ struct WindowConfig {
     std::string title = "Flux Application";
     bool fullscreen = false;
     bool resizable = true;
+    /// Record frames on the UI thread and compile, upload and submit them on a render
+    /// thread, so input handling does not wait for GPU submission or vsync.
+    bool pipelinedRendering = false;
+    /// Worker threads that compile cache-missing subtrees of a frame's draw commands ahead of
+    /// the thread compiling the frame; 0 compiles serially.
+    size_t compileThreads = 0;
+    /// Font size in pixels from which text is drawn from distance fields that scale to any
+    /// size, instead of a bitmap per size; 0 draws every size from bitmaps.
+    uint16_t sdfTextThreshold = 0;
 };
 
 /**
@@ -6,6 +6,10 @@
 #include <vector>
 #include <cstdint>
 
+namespace flux {
+class ThreadPool;
+}
+
 namespace flux::gpu {
 
 class Texture;
@@ -21,6 +25,11 @@ public:
     virtual ~Buffer() = default;
     virtual void write(const void* data, size_t size, size_t offset = 0) = 0;
     virtual size_t size() const = 0;
+    /// CPU pointer to the buffer's storage when it stays mapped for the buffer's lifetime;
+    /// nullptr when data has to go through write().
+    virtual void* mappedData() { return nullptr; }
+    /// Makes CPU writes through mappedData() in [offset, offset + size) visible to the GPU.
+    virtual void flushMapped(size_t offset, size_t size) { (void)offset; (void)size; }
 };
 
 class Texture {
@@ -72,6 +81,12 @@ public:
     virtual void endRenderPass() = 0;
     virtual void endFrame() = 0;
 
+    /// How many frames ago the back buffer acquired by the last beginFrame() was presented.
+    /// 0 means its contents are undefined, so a frame rendered with LoadAction::Load must
+    /// still redraw every pixel. Swapchain images and layer drawables are not guaranteed to
+    /// keep their pixels, so only devices that own their framebuffer report an age.
+    virtual uint32_t bufferAge() const { return 0; }
+
     virtual void resize(uint32_t width, uint32_t height) = 0;
     virtual PixelFormat swapchainFormat() const = 0;
 
@@ -81,6 +96,10 @@ public:
         return false;
     }
 
+    /// CPU worker threads the device already runs, if any. Whoever drives the device may run
+    /// its own fork-join work on them between device calls rather than start another pool.
+    virtual std::shared_ptr<ThreadPool> workerPool() const { return nullptr; }
+
     /// When false (default), Metal may skip per-frame drawable readback and use a cheaper
     /// framebuffer path. Enable for UI test screenshots (`Window::enableTestMode`).
     virtual void setReadbackEnabled(bool enabled) { (void)enabled; }
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <Flux/GPU/Device.hpp>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace flux::gpu {
+
+/// A range handed out by FrameRing: bind `buffer` at `offset`, write through `data`.
+struct RingSlice {
+    Buffer* buffer = nullptr;
+    size_t offset = 0;
+    void* data = nullptr;
+
+    explicit operator bool() const { return buffer != nullptr; }
+};
+
+/** Linear allocator for transient per-frame vertex and instance data.
+ *  Each frame in flight owns large vertex buffers that stay mapped for their lifetime
+ *  (Buffer::mappedData()); allocate() bumps an offset and returns a pointer to write
+ *  into, so uploads are plain memcpys with no map/unmap and no per-frame reallocation.
+ *  A frame that outgrows its buffer spills into another one; the next time that frame
+ *  slot comes around the two are replaced by a single buffer large enough for both.
+ *  Call beginFrame() after Device::beginFrame() and flush() before Device::endFrame(). */
+class FrameRing {
+public:
+    static constexpr size_t kDefaultChunkSize = 1u << 20;
+
+    explicit FrameRing(Device* device, size_t chunkSize = kDefaultChunkSize);
+
+    void beginFrame();
+    RingSlice allocate(size_t size, size_t alignment = 16);
+
+    template<typename T>
+    RingSlice upload(const std::vector<T>& items) {
+        if (items.empty()) return {};
+        RingSlice s = allocate(items.size() * sizeof(T));
+        if (s) std::memcpy(s.data, items.data(), items.size() * sizeof(T));
+        return s;
+    }
+
+    /// Makes this frame's writes visible to the GPU.
+    void flush();
+
+    /// Bytes handed out since beginFrame().
+    size_t bytesAllocated() const { return allocated_; }
+
+private:
+    struct Chunk {
+        std::unique_ptr<Buffer> buffer;
+        uint8_t* mapped = nullptr;
+        std::vector<uint8_t> shadow; // staging when the buffer cannot stay mapped
+        size_t size = 0;
+        size_t used = 0;
+    };
+    struct Slot {
+        std::vector<Chunk> chunks;
+        size_t current = 0;
+    };
+
+    Chunk makeChunk(size_t size);
+
+    Device* device_;
+    size_t chunkSize_;
+    Slot slots_[Device::kMaxFramesInFlight];
+    Slot* slot_ = &slots_[0];
+    size_t allocated_ = 0;
+};
+
+} // namespace flux::gpu
@@ -9,7 +9,7 @@
 
 namespace flux::gpu {
 
-enum class Backend { Metal, Vulkan };
+enum class Backend { Metal, Vulkan, Software };
 
 enum class PixelFormat {
     RGBA8,
@@ -82,7 +82,21 @@ struct ShaderSource {
     std::string_view msl;
 };
 
+/// Built-in program a pipeline implements. GPU backends compile the shader sources and ignore
+/// this; the software backend has no shader compiler and rasterizes the named program natively.
+enum class ShaderProgram {
+    Custom,
+    SDFRect,
+    SDFCircle,
+    SDFLine,
+    Glyph,
+    GlyphSDF,
+    Path,
+    Image
+};
+
 struct RenderPipelineDesc {
+    ShaderProgram program = ShaderProgram::Custom;
     ShaderSource vertexShader;
     ShaderSource fragmentShader;
     std::string vertexFunction = "vertexMain";
@@ -5,18 +5,30 @@
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
 namespace flux {
 
+/// How an atlas page places rectangles.
+enum class AtlasPacking : uint8_t {
+    /// Left to right along rows as tall as their tallest rectangle; fastest, but rectangles
+    /// shorter than their row waste the space above them.
+    Shelf,
+    /// Bottom-left on the page's skyline (the top edge of what is placed so far), so short
+    /// rectangles fill in beside tall ones; fits far more when heights vary.
+    Skyline,
+};
+
 struct AtlasDesc {
     uint32_t pageWidth = 1024;
     uint32_t pageHeight = 1024;
     uint32_t maxPages = 8;
     gpu::PixelFormat format = gpu::PixelFormat::R8;
+    AtlasPacking packing = AtlasPacking::Shelf;
 };
 
-/// Shelf-packed GPU texture atlas with optional CPU staging (batched uploads via dirty rects).
+/// Paged GPU texture atlas with optional CPU staging (batched uploads via dirty rects).
 class Atlas {
 public:
     Atlas(gpu::Device* device, const AtlasDesc& desc);
@@ -24,6 +36,7 @@ public:
     [[nodiscard]] uint32_t pageWidth() const { return pageWidth_; }
     [[nodiscard]] uint32_t pageHeight() const { return pageHeight_; }
     [[nodiscard]] gpu::PixelFormat format() const { return format_; }
+    [[nodiscard]] AtlasPacking packing() const { return packing_; }
     [[nodiscard]] uint32_t rowStrideBytes() const { return rowStrideBytes_; }
 
     [[nodiscard]] uint8_t pageCount() const { return static_cast<uint8_t>(pages_.size()); }
@@ -42,9 +55,14 @@ public:
         float v1 = 0;
     };
 
-    /// Reserve a w×h rectangle on the current shelf; may add pages up to maxPages.
+    /// Reserve a w×h rectangle on the page being filled; moves on to a released page or adds
+    /// pages up to maxPages. The staging pixels of the rectangle and its padding are zeroed.
     [[nodiscard]] std::optional<AllocResult> allocate(uint32_t w, uint32_t h, uint32_t pad = 1);
 
+    /// Forgets every allocation on a page; allocation reuses it once the page being filled is
+    /// full. The texture keeps its pixels until new allocations overwrite them.
+    void releasePage(uint8_t pageIndex);
+
     /// Pointer to the first byte of a row in the CPU staging buffer (tightly packed, rowStrideBytes() pitch).
     [[nodiscard]] uint8_t* rowData(uint8_t pageIndex, uint32_t row);
 
@@ -58,12 +76,22 @@ public:
     [[nodiscard]] uint64_t lastGpuUploadBytes() const { return lastGpuUploadBytes_; }
 
 private:
+    /// A run of the skyline: the placed area ends at height y over [x, x + width).
+    struct SkylineSpan {
+        uint32_t x = 0;
+        uint32_t y = 0;
+        uint32_t width = 0;
+    };
+
     struct Page {
         std::vector<uint8_t> data;
         std::unique_ptr<gpu::Texture> texture;
+        // Shelf
         uint32_t cursorX = 0;
         uint32_t cursorY = 0;
         uint32_t rowHeight = 0;
+        // Skyline, left to right
+        std::vector<SkylineSpan> skyline;
         bool dirty = false;
         bool dirtyRectValid = false;
         uint32_t dirtyX0 = 0;
@@ -77,13 +105,22 @@ private:
     uint32_t pageHeight_;
     uint32_t maxPages_;
     gpu::PixelFormat format_;
+    AtlasPacking packing_;
     uint32_t bpp_;
     uint32_t rowStrideBytes_;
 
     std::vector<Page> pages_;
+    uint8_t fillPage_ = 0;
+    std::vector<uint8_t> releasedPages_;
     uint64_t lastGpuUploadBytes_ = 0;
 
     uint8_t addPage();
+    void resetPacking(Page& page) const;
+    /// Reserves a w×h area on the page and returns its top-left corner, or nullopt when the
+    /// page has no room for it.
+    using Position = std::pair<uint32_t, uint32_t>;
+    [[nodiscard]] std::optional<Position> placeOnShelf(Page& page, uint32_t w, uint32_t h) const;
+    [[nodiscard]] std::optional<Position> placeOnSkyline(Page& page, uint32_t w, uint32_t h) const;
 };
 
 } // namespace flux
@@ -8,12 +8,15 @@
 #include <cstdint>
 #include <array>
 #include <list>
+#include <memory>
 #include <optional>
 #include <unordered_map>
 #include <vector>
 
 namespace flux {
 
+class ThreadPool;
+
 struct SDFQuadInstance {
     float rect[4];         // x, y, width, height (min corner + size; axis-aligned in local SDF space)
     float corners[4];      // topLeft, topRight, bottomRight, bottomLeft radius (line: cos/sin in xy)
@@ -62,6 +65,7 @@ struct DrawOp {
     uint32_t offset = 0;  // index into the type's buffer (for Image: index into imageDraws)
     uint32_t count = 0;
     uint8_t pageIndex = 0; // atlas page for Glyph ops
+    Rect bounds{};         // screen-space extent of the op's primitives (before scissor)
 };
 
 struct DrawGroup {
@@ -85,20 +89,52 @@ struct CompiledBatches {
     gpu::ClearColor clearColor;
     float viewportWidth = 0;
     float viewportHeight = 0;
+    // Screen-space rects whose pixels may differ from the previous compile's output.
+    // fullDamage is set when the whole viewport has to be redrawn (first compile,
+    // resize, new clear color, glyph atlas pages reclaimed).
+    std::vector<Rect> damage;
+    bool fullDamage = true;
 };
 
 /** Walks a recorded command buffer and produces batched GPU instance data (SDF quads, glyphs, tessellated paths).
  *  Supports incremental compilation: per-element compiled output is cached and reused when
- *  an element's subtreeRenderVersion and compiler entry state are unchanged from the previous frame. */
+ *  an element's BeginElement version (the Renderer's recording id, carried over when it replays
+ *  a retained slice) and compiler entry state are unchanged from the previous frame.
+ *  Each compile also reports the screen regions whose output changed (CompiledBatches::damage). */
 class CommandCompiler {
 public:
+    CommandCompiler();
+    ~CommandCompiler();
+
     void setGlyphAtlas(GlyphAtlas* atlas) { atlas_ = atlas; }
     void compile(const RenderCommandBuffer& buffer, float vpWidth, float vpHeight,
                  float dpiScaleX, float dpiScaleY, CompiledBatches& out);
 
-    struct CacheStats { size_t hits = 0, misses = 0; };
+    /// Compiles with `threads` worker threads besides the calling one; 0 (the default)
+    /// compiles serially. Subtrees the cache cannot serve are split off at element
+    /// boundaries, compiled ahead on the workers and spliced in stream order, so the output
+    /// is identical to a serial compile.
+    void setWorkerThreads(size_t threads);
+    /// Compiles on an existing pool, such as the one a device already runs; null compiles
+    /// serially. Nothing else may run on the pool while compile() does.
+    void setWorkerPool(std::shared_ptr<ThreadPool> pool);
+    const std::shared_ptr<ThreadPool>& workerPool() const { return pool_; }
+
+    /// `jobs` counts the runs of subtrees handed to workers in the last compile; `fallbacks`
+    /// those compiled serially after all (a glyph missing from the atlas, unbalanced state).
+    struct ParallelStats { size_t jobs = 0, fallbacks = 0; };
+    ParallelStats lastParallelStats() const { return parallelStats_; }
+
+    /// `translated` counts the hits spliced at a new position (e.g. scrolled content);
+    /// `storedInstances` the instances copied into cache entries by elements that missed.
+    struct CacheStats { size_t hits = 0, misses = 0, translated = 0, storedInstances = 0; };
     CacheStats lastCacheStats() const { return cacheStats_; }
 
+    /// Draw calls (DrawOps) in the last compile before and after draws were reordered into
+    /// pipeline batches and adjacent ops merged.
+    struct DrawCallStats { size_t beforeMerge = 0, afterMerge = 0; };
+    DrawCallStats lastDrawCallStats() const { return drawCallStats_; }
+
 private:
     /// Key for tessellation cache (solid fill/stroke, no dash; quantized transform).
     struct PathTessCacheKey {
@@ -135,14 +171,26 @@ private:
         StrokeStyle stroke;
         TextStyle textStyle;
         ScissorState scissor;
+        int32_t clipNode = -1; // innermost entry of clipNodes_, -1 = no clip
+        bool operator==(const State&) const = default;
     };
 
+    // Every ClipPath of the compile, as a tree: a group's scissor is the intersection of
+    // the clips on the path from its node to the root. Lets a cached subtree tell its own
+    // clips apart from the ones it was compiled inside.
+    struct ClipNode {
+        ScissorState rect;
+        int32_t parent;
+    };
+    std::vector<ClipNode> clipNodes_;
+
     // ---- Per-element compile cache ----
 
-    // Fingerprint of compiler state at an element's entry point.
-    // If this differs between frames (e.g. parent moved), the cache is invalid.
+    // Fingerprint of compiler state at an element's entry point, without the translation.
+    // If this differs between frames (e.g. parent scaled), the cache is invalid; a parent
+    // that only moved is handled by translating the cached output.
     struct StateFingerprint {
-        int32_t m00, m01, m02, m10, m11, m12;
+        int32_t m00, m01, m10, m11;
         int32_t qOpacity;
         ScissorState scissor;
         bool operator==(const StateFingerprint&) const = default;
@@ -152,34 +200,163 @@ private:
     struct CachedElementData {
         uint64_t subtreeVersion = 0;
         StateFingerprint fingerprint{};
-        uint64_t lastAccessFrame = 0;
-        // Cached compiled instances produced by this element (incl. descendants)
+        float originX = 0, originY = 0; // translation at entry when the output was compiled
+        mutable uint64_t lastAccessFrame = 0;
+        // Compiled instances this element drew itself, in screen space for the entry
+        // translation above; descendants' output lives in their own entries.
         std::vector<SDFQuadInstance> rects;
         std::vector<SDFQuadInstance> circles;
         std::vector<SDFQuadInstance> lines;
         std::vector<GlyphInstance> glyphs;
         std::vector<PathVertex> pathVerts;
-        // DrawOps with offsets relative to this element's start
+        std::vector<ImageDrawCmd> imageDraws;
+        // DrawOps with offsets relative to the start of their piece's instances
         std::vector<DrawOp> drawOps;
-        bool hasScissorBreaks = false;
+
+        // The element's output in draw order: runs of its own instances, each within one
+        // draw group, interleaved with its children's entries.
+        struct Piece {
+            // A child's output, placed at (offsetX, offsetY) from this entry's origin
+            std::shared_ptr<const CachedElementData> child;
+            float offsetX = 0, offsetY = 0;
+            // Otherwise a run of own output ending at these indices. A run that starts a
+            // group keeps the group's scissor as compiled, and in `clip` the part of it
+            // set by this element's ClipPaths, which moves with the element while the
+            // entry scissor stays put.
+            bool startsGroup = false;
+            ScissorState scissor;
+            ScissorState clip;
+            uint32_t rectEnd = 0, circleEnd = 0, lineEnd = 0, glyphEnd = 0, pathEnd = 0;
+            uint32_t imageEnd = 0, opEnd = 0;
+        };
+        std::vector<Piece> pieces;
+        // False when a clip inside the subtree did not start a group; its effect at
+        // another position is unknown, so the entry only matches at its own origin.
+        bool translatable = true;
     };
 
-    std::unordered_map<uintptr_t, CachedElementData> elementCache_;
+    // Entries are shared with the parents' entries that reference them, so replacing or
+    // evicting one leaves the parents' recorded output intact.
+    std::unordered_map<uintptr_t, std::shared_ptr<CachedElementData>> elementCache_;
     uint64_t compileFrame_ = 0;
+    // Atlas generation the cached glyph instances were laid out in; the first compile after
+    // the atlas reclaims pages starts from an empty cache and redraws in full.
+    uint64_t atlasGeneration_ = 0;
+    bool atlasReset_ = false;
     CacheStats cacheStats_{};
+    DrawCallStats drawCallStats_{};
 
+    /// Moves each draw earlier, past draws whose bounds it does not overlap, to join the
+    /// latest op with the same pipeline; painter's order is kept wherever draws overlap.
+    void reorderDrawOps(CompiledBatches& out);
+    /// Collapses consecutive ops of a group that draw adjacent instances with the same
+    /// pipeline (and atlas page or image) into one instanced draw.
+    void mergeDrawOps(CompiledBatches& out);
+
+    // An element being compiled. Its own output is collected run by run into `entry`;
+    // a run ends where a child begins or the element starts a new draw group.
     struct ElementTrack {
         uintptr_t elementId;
-        uint64_t subtreeVersion;
-        StateFingerprint fingerprint;
-        size_t rectStart, circleStart, lineStart, glyphStart, pathStart;
-        size_t drawOpStart;
-        ScissorState entryScissor;
-        bool hadScissorBreak;
+        int32_t clipNode;
+        bool translatable = true;
+        bool cacheable = true;
+        std::shared_ptr<CachedElementData> entry{};
+        // Start of the current run (image and op indices are group-local)
+        size_t rectStart = 0, circleStart = 0, lineStart = 0, glyphStart = 0, pathStart = 0;
+        size_t imageStart = 0, drawOpStart = 0;
+        bool runStartsGroup = false;
+        ScissorState runScissor{}, runClip{};
     };
     std::vector<ElementTrack> elementTrackStack_;
 
-    void spliceCacheEntry(const CachedElementData& entry, CompiledBatches& out);
+    std::shared_ptr<CachedElementData> findCacheHit(uintptr_t elementId, uint64_t subtreeVersion) const;
+    void beginRun(ElementTrack& t, const CompiledBatches& out);
+    void endRun(ElementTrack& t, CompiledBatches& out);
+    void addChildPiece(std::shared_ptr<const CachedElementData> child, float x, float y,
+                       CompiledBatches& out);
+    void replayCacheEntry(const CachedElementData& entry, CompiledBatches& out,
+                          float x, float y, const ScissorState& entryScissor);
+
+    // ---- Damage tracking ----
+
+    // Hash and screen extent of what an element drew itself (children excluded) at the
+    // last compile it was not spliced from the cache. A changed hash damages the old and
+    // new extents; an element that is no longer drawn damages its old extent. The output
+    // drawn outside any element is tracked under id 0.
+    struct DamageRecord {
+        uint64_t hash = 0;
+        Rect extent;
+        Rect drawn; // extent before scissoring, to re-clip the element when it moves
+        float originX = 0, originY = 0; // translation `drawn` was recorded or last moved at
+        uint64_t lastFrame = 0;
+        std::vector<uintptr_t> children;
+    };
+    struct DamageTrack {
+        uintptr_t elementId = 0;
+        uint64_t hash = 0;
+        Rect extent;
+        Rect drawn;
+        float originX = 0, originY = 0;
+        std::vector<uintptr_t> children;
+    };
+    std::unordered_map<uintptr_t, DamageRecord> damageRecords_;
+    std::vector<DamageTrack> damageStack_;
+    gpu::ClearColor lastClearColor_{};
+    float lastViewportWidth_ = 0;
+    float lastViewportHeight_ = 0;
+
+    void beginDamageTrack(uintptr_t elementId);
+    void endDamageTrack(CompiledBatches& out);
+    void touchDamageRecords(uintptr_t elementId);
+    void placeDamageRecords(uintptr_t elementId, float x, float y, const ScissorState& scissor,
+                            CompiledBatches& out);
+    void commitDamageTrack(DamageTrack t, CompiledBatches& out);
+    void moveDamageRecords(uintptr_t elementId, float dx, float dy, const ScissorState& scissor,
+                           CompiledBatches& out);
+    void noteDrawOps(CompiledBatches& out, size_t firstOp);
+    void finishDamage(CompiledBatches& out);
+
+    // ---- Parallel compile ----
+
+    // A run of consecutive sibling subtrees that miss the cache, compiled ahead by a worker
+    // into cache entries. The serial pass splices the entries where the run begins and
+    // replays the damage bookkeeping the worker deferred, in the order it happened.
+    struct DamageEvent {
+        DamageTrack track;   // a compiled element's track, to commit
+        bool place = false;  // or a cache hit: place track.elementId's records
+        float x = 0, y = 0;
+        ScissorState scissor{};
+    };
+    struct CompileJob {
+        uint32_t begin = 0, end = 0; // words: first BeginElement to past the last EndElement
+        State entry;
+        bool valid = false;
+        std::vector<std::pair<uintptr_t, std::shared_ptr<CachedElementData>>> roots;
+        std::vector<std::pair<uintptr_t, std::shared_ptr<CachedElementData>>> entries;
+        std::vector<DamageEvent> damage;
+        CacheStats stats;
+    };
+    std::vector<CompileJob> jobs_;
+    size_t nextJob_ = 0;
+    ParallelStats parallelStats_{};
+    std::shared_ptr<ThreadPool> pool_;
+    std::vector<std::unique_ptr<CommandCompiler>> workers_; // one per pool slot
+
+    // Set on a worker while it runs a job
+    CompileJob* job_ = nullptr;
+    const CommandCompiler* cacheSource_ = nullptr; // the compiler whose cache the job reads
+    bool jobFailed_ = false;
+    CompiledBatches jobOut_;
+
+    void resetState(float dpiScaleX, float dpiScaleY);
+    void planJobs(const RenderCommandBuffer& buffer, float vpWidth, float vpHeight);
+    void runJob(const CommandCompiler& owner, const RenderCommandBuffer& buffer, CompileJob& job,
+                float vpWidth, float vpHeight);
+    bool spliceJob(CompileJob& job, RenderCommandBuffer::Reader& r, CompiledBatches& out);
+    void compileRange(const RenderCommandBuffer& buffer, RenderCommandBuffer::Reader& r,
+                      uint32_t end, CompiledBatches& out);
+    bool applyStateOp(CmdOp op, RenderCommandBuffer::Reader& r, const RenderCommandBuffer& buffer,
+                      CompiledBatches& out);
 
     // ---- Core state ----
 
@@ -202,6 +379,9 @@ private:
     /// True if linear part is axis-aligned (scale + translation only, no rotation/shear).
     bool isAxisAligned() const;
     void startNewGroup(CompiledBatches& out);
+    void openGroup(CompiledBatches& out, const ScissorState& scissor);
+    bool subtreeClip(int32_t node, int32_t entryNode, ScissorState& clip) const;
+    void storeCacheEntry(ElementTrack& t);
     void pushRect(CompiledBatches& out, const Rect& bounds, const CornerRadius& cr);
     void pushCircle(CompiledBatches& out, const Point& center, float radius);
     void pushLine(CompiledBatches& out, const Point& from, const Point& to);
@@ -50,6 +50,9 @@ public:
     /// `baseFontPath` for style matching. Returns the resolved font file path.
     static std::optional<std::string> findFontPathForCodepoint(
         uint32_t codepoint, const std::string& baseFontPath = "");
+
+    /// True while codepoint lookups may miss fonts they will find later.
+    static bool codepointLookupPending();
 };
 
 } // namespace flux
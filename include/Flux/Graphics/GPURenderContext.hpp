@@ -20,8 +20,10 @@ public:
                      int width, int height,
                      float dpiScaleX = 1.0f, float dpiScaleY = 1.0f);
 
-    void setCommandBuffer(RenderCommandBuffer* buf) { cmdBuf_ = buf; }
-    RenderCommandBuffer* commandBuffer() const { return cmdBuf_; }
+    // Commands are recorded into recordingBuffer() (the context's own buffer unless
+    // the caller installs one after beginFrame) and executed by present().
+    void setCommandBuffer(RenderCommandBuffer* buf) { recordingBuffer_ = buf; }
+    RenderCommandBuffer* commandBuffer() const { return recordingBuffer_; }
 
     void beginFrame() override;
     void clear(const Color& color) override;
@@ -113,7 +115,6 @@ private:
     FontProvider* fontProvider_;
     ImageCache* imageCache_;
     GPURendererBackend* gpuBackend_;
-    RenderCommandBuffer* cmdBuf_ = nullptr;
     RenderCommandBuffer ownedBuffer_;
     int width_, height_;
     float dpiScaleX_, dpiScaleY_;
@@ -5,7 +5,12 @@
 #include <Flux/Graphics/GlyphAtlas.hpp>
 #include <Flux/Graphics/ImageCache.hpp>
 #include <Flux/GPU/Device.hpp>
+#include <Flux/GPU/FrameRing.hpp>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
 #include <vector>
 
 namespace flux {
@@ -13,21 +18,67 @@ namespace flux {
 class GPURendererBackend : public RenderBackend {
 public:
     explicit GPURendererBackend(gpu::Device* device);
+    ~GPURendererBackend() override;
     void execute(const RenderCommandBuffer& buffer) override;
 
+    /// Pipelined mode: execute() copies the buffer into a queue and returns, and a render
+    /// thread compiles, uploads and submits it, so the caller can record the next frame
+    /// while this one (and any vsync wait) completes. At most kMaxFramesInFlight frames are
+    /// queued; execute() blocks while the queue is full.
+    ///
+    /// Only the render thread touches the device while frames are queued. Callers drain
+    /// the queue with finishFrames() before anything else that does (resizing, readback,
+    /// image loads) and before reading compile statistics. setViewportSize and setDPIScale
+    /// drain it themselves. Text measurement may run concurrently; the glyph atlas locks.
+    void setPipelined(bool enabled);
+    bool pipelined() const { return renderThread_.joinable(); }
+    /// Returns once every queued frame has been submitted.
+    void finishFrames();
+
     void setViewportSize(float width, float height);
     void setDPIScale(float scaleX, float scaleY);
     GlyphAtlas* glyphAtlas() { return glyphAtlas_.get(); }
+    const CommandCompiler& compiler() const { return compiler_; }
+    /// Worker threads the command compiler may use besides the thread compiling the frame;
+    /// 0 compiles serially. On a device with CPU workers of its own (the software device)
+    /// the compiler uses those instead. Drains queued frames first.
+    void setCompileThreads(size_t threads);
+    /// Frames redrawn from the previous compile because their commands were unchanged.
+    size_t skippedCompiles() const { return skippedCompiles_; }
+    /// Instance stream bytes the last frame copied to the GPU.
+    size_t streamBytesCopied() const { return streamBytesCopied_; }
     ImageCache* imageCache() { return imageCache_.get(); }
 
 private:
+    void executeFrame(const RenderCommandBuffer& buffer);
+    void renderThreadLoop();
     void ensurePipelines();
     void ensureQuadVertexBuffer();
-    void uploadAndDraw(const CompiledBatches& batches);
+    void uploadAndDraw(const CompiledBatches& batches, bool unchanged);
+    std::span<const uint8_t> streamBytes(uint32_t index, int stream) const;
+    void identifyStreams(uint32_t previous);
+    void bindStreams();
+    struct StreamSlot;
+    void layoutStreamSlot(StreamSlot& slot);
+    bool planPartialRedraw(const CompiledBatches& batches, bool unchanged);
+    void drawGroups(gpu::RenderPassEncoder* enc, const CompiledBatches& batches, const Rect* clip);
 
     gpu::Device* device_;
     CommandCompiler compiler_;
 
+    // Pipelined mode: a ring of recorded frames. The caller fills the slot after the last
+    // queued one without the lock (the render thread never reads it), then publishes it
+    // by bumping queuedCount_; the render thread releases the head slot only after its
+    // frame has been submitted.
+    RenderCommandBuffer queuedFrames_[gpu::Device::kMaxFramesInFlight];
+    uint32_t queueHead_ = 0;
+    uint32_t queuedCount_ = 0;
+    bool stopRenderThread_ = false;
+    std::mutex queueMutex_;
+    std::condition_variable frameQueued_;
+    std::condition_variable frameDone_;
+    std::thread renderThread_;
+
     float viewportWidth_ = 0;
     float viewportHeight_ = 0;
     float dpiScaleX_ = 1.0f;
@@ -37,6 +88,7 @@ private:
     std::unique_ptr<gpu::RenderPipeline> circlePipeline_;
     std::unique_ptr<gpu::RenderPipeline> linePipeline_;
     std::unique_ptr<gpu::RenderPipeline> glyphPipeline_;
+    std::unique_ptr<gpu::RenderPipeline> glyphSdfPipeline_;
     std::unique_ptr<gpu::RenderPipeline> pathPipeline_;
     std::unique_ptr<gpu::RenderPipeline> imagePipeline_;
 
@@ -44,26 +96,61 @@ private:
 
     static constexpr uint32_t kFrames = gpu::Device::kMaxFramesInFlight;
 
-    struct FrameBuffers {
-        std::unique_ptr<gpu::Buffer> rect;
-        std::unique_ptr<gpu::Buffer> circle;
-        std::unique_ptr<gpu::Buffer> line;
-        std::unique_ptr<gpu::Buffer> glyph;
-        std::unique_ptr<gpu::Buffer> path;
-        std::unique_ptr<gpu::Buffer> image;
-        size_t rectCap = 0, circleCap = 0, lineCap = 0;
-        size_t glyphCap = 0, pathCap = 0, imageCap = 0;
+    /// Transient per-frame data (damage-clear quads) lives in the frame ring.
+    gpu::FrameRing frameRing_;
+    gpu::RingSlice damageClearSlice_;
+
+    // Instance streams persist in one mapped buffer per frame in flight; only changed blocks are copied.
+    enum Stream { kRectStream, kCircleStream, kLineStream, kGlyphStream, kPathStream,
+                  kImageStream, kStreamCount };
+    static constexpr size_t kStreamDiffBlock = 256;
+    static constexpr size_t kMinStreamRegion = 4096;
+    struct StreamSlot {
+        std::unique_ptr<gpu::Buffer> buffer;
+        uint8_t* mapped = nullptr;
+        std::vector<uint8_t> held;  // what the buffer holds; staged through write() when unmapped
+        size_t regionOffset[kStreamCount] = {};
+        size_t regionSize[kStreamCount] = {};
+        uint64_t content[kStreamCount] = {};  // id of the content each region holds, 0 = none
+    };
+    StreamSlot streamSlots_[kFrames];
+    gpu::Buffer* streamBuffer_ = nullptr;  // slot buffer bound this frame
+    size_t streamOffsets_[kStreamCount] = {};
+    bool streamBound_[kStreamCount] = {};
+    uint64_t streamContent_[kStreamCount] = {};
+    size_t streamBytesCopied_ = 0;
+    uint64_t nextContentId_ = 1;
+
+    // Image draws flattened into one instance stream; imageBase[g] is group g's first.
+    struct ImageStream {
+        std::vector<ImageInstance> instances;
+        std::vector<uint32_t> groupBase;
     };
-    FrameBuffers frameBuffers_[kFrames];
 
-    CompiledBatches compiledBatches_;
+    // The last two compiles, and the commands the current one came from (reused when unchanged).
+    CompiledBatches compiledBatches_[2];
+    ImageStream imageStreams_[2];
+    uint32_t compiledIndex_ = 0;
+    bool hasCompiled_ = false;
+    RenderCommandBuffer compiledBuffer_;
+    float compiledViewport_[2] = {};
+    float compiledDpiScale_[2] = {};
+    uint64_t compiledAtlasGeneration_ = 0;
+    size_t skippedCompiles_ = 0;
+
+    // Partial redraw: the compiler's damage for the last kDamageHistory presented frames
+    // (most recent at damageHistoryHead_), so a back buffer that is several frames old
+    // can be brought up to date. redrawRects_ is this frame's merged, pixel-aligned region.
+    static constexpr uint32_t kDamageHistory = 4;
+    std::vector<Rect> damageHistory_[kDamageHistory];
+    uint32_t damageHistoryHead_ = 0;
+    uint32_t damageHistoryCount_ = 0;
+    std::vector<Rect> redrawRects_;
+    std::vector<SDFQuadInstance> damageClearQuads_;
 
     std::unique_ptr<GlyphAtlas> glyphAtlas_;
     std::unique_ptr<ImageCache> imageCache_;
 
-    /// Reused to batch consecutive image draws that share a texture.
-    std::vector<ImageInstance> imageBatchScratch_;
-
     bool pipelinesReady_ = false;
 };
 
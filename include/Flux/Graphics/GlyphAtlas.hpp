@@ -5,6 +5,7 @@
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #include <list>
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -22,19 +23,29 @@ struct GlyphInfo {
     float bearingX, bearingY;
     float advance;
     uint8_t pageIndex = 0;
+    uint64_t lastUseFrame = 0; ///< last GlyphAtlas::beginFrame frame that laid the glyph out
+};
+
+/// Layout metrics of a glyph, loaded without rendering its bitmap.
+struct GlyphMetrics {
+    float advance;
+    float height; ///< rows of the bitmap rasterizing it would produce
 };
 
 struct GlyphKey {
     uint32_t codepoint;
     uint16_t fontSize;
     uint16_t fontIndex;
+    bool sdf = false; ///< distance field at GlyphAtlas::kSdfReferenceSize, not a coverage bitmap
 
     bool operator==(const GlyphKey& other) const = default;
 };
 
 struct GlyphKeyHash {
     size_t operator()(const GlyphKey& k) const {
+        // Codepoints fit in 21 bits, leaving the top bit for the SDF flag.
         return std::hash<uint64_t>{}(
+            (static_cast<uint64_t>(k.sdf) << 63) |
             (static_cast<uint64_t>(k.codepoint) << 32) |
             (static_cast<uint64_t>(k.fontSize) << 16) |
             k.fontIndex);
@@ -59,10 +70,33 @@ class GlyphAtlas final : public FontProvider {
 public:
     static constexpr uint32_t kDefaultPageSize = 1024;
     static constexpr uint32_t kDefaultMaxPages = 8;
+    /// Distance-field glyphs are rasterized once at this pixel size and scaled to any other.
+    static constexpr uint16_t kSdfReferenceSize = 64;
+    /// Distance in reference-size pixels from the outline to where the field saturates.
+    static constexpr int kSdfSpread = 8;
+    static constexpr uint32_t kSdfMaxPages = 2;
 
     GlyphAtlas(gpu::Device* device, uint32_t atlasSize = kDefaultPageSize);
     ~GlyphAtlas() override;
 
+    /// While alive, text calls made on this thread only read what the atlas already holds:
+    /// a glyph or font that would have to be rasterized or loaded counts as missing and sets
+    /// missed(). Worker threads lay out text under it, so what gets added to the atlas, and
+    /// where, never depends on how they were scheduled.
+    class LookupOnlyScope {
+    public:
+        LookupOnlyScope();
+        ~LookupOnlyScope();
+        LookupOnlyScope(const LookupOnlyScope&) = delete;
+        LookupOnlyScope& operator=(const LookupOnlyScope&) = delete;
+        bool missed() const { return missed_; }
+
+    private:
+        friend class GlyphAtlas;
+        LookupOnlyScope* previous_;
+        bool missed_ = false;
+    };
+
     // -- FontProvider interface ------------------------------------------------
 
     bool loadFont(const std::string& path, uint16_t fontIndex = 0) override;
@@ -70,7 +104,10 @@ public:
                         uint16_t fontIndex = 0) override;
     [[nodiscard]] std::optional<uint16_t> ensureFontLoaded(const std::string& name,
                                                             FontWeight weight) override;
-    bool hasFont(uint16_t fontIndex = 0) const override { return faces_.count(fontIndex) > 0; }
+    bool hasFont(uint16_t fontIndex = 0) const override {
+        std::lock_guard lock(mutex_);
+        return faces_.count(fontIndex) > 0;
+    }
     Size measureText(const std::string& text, float fontSize,
                      uint16_t fontIndex = 0) override;
     Size measureTextBox(const std::string& text, float fontSize, float maxWidth,
@@ -79,6 +116,9 @@ public:
     // -- GPU-specific API (glyph rasterization + atlas) ------------------------
 
     const GlyphInfo* getGlyph(uint32_t codepoint, uint16_t fontSize, uint16_t fontIndex = 0);
+    /// The distance-field rendition of a glyph, at kSdfReferenceSize; nullptr when the glyph
+    /// has no outline or the distance field could not be rendered.
+    const GlyphInfo* getSdfGlyph(uint32_t codepoint, uint16_t fontIndex = 0);
 
     std::vector<GlyphInstance> layoutText(const std::string& text, float x, float y,
                                            float fontSize, const Color& color,
@@ -93,35 +133,100 @@ public:
                                               uint16_t fontIndex = 0);
 
     gpu::Texture* texture(uint8_t page = 0) const;
+    /// Pages of coverage bitmaps; distance-field pages follow at kDefaultMaxPages.
     uint8_t pageCount() const { return atlas_.pageCount(); }
     bool dirty() const;
     void uploadIfDirty();
 
-    uint64_t lastGpuUploadBytes() const { return atlas_.lastGpuUploadBytes(); }
+    uint64_t lastGpuUploadBytes() const {
+        return atlas_.lastGpuUploadBytes() + sdfAtlas_.lastGpuUploadBytes();
+    }
+
+    // -- Distance-field glyphs --------------------------------------------------
+
+    /// Text at `fontSize` or larger is drawn from signed distance fields rasterized once at
+    /// kSdfReferenceSize, so zooming or animating a size reuses one glyph set instead of
+    /// packing a new one per pixel size. 0 (the default) always rasterizes bitmaps. Glyphs
+    /// without an outline (bitmap and color fonts) stay bitmaps at any size.
+    void setSdfThreshold(uint16_t fontSize);
+    uint16_t sdfThreshold() const {
+        std::lock_guard lock(mutex_);
+        return sdfThreshold_;
+    }
+    /// Distance-field pages are drawn with the GlyphSDF program instead of Glyph.
+    static bool isSdfPage(uint8_t page) { return page >= kDefaultMaxPages; }
+
+    // -- Eviction ---------------------------------------------------------------
+
+    /// Starts a frame; glyphs laid out and pages drawn from are stamped with it. Bumps the
+    /// generation once fallback fonts that were still being resolved can be found.
+    void beginFrame();
+    /// Records that the current frame samples `page`, whether or not it laid out its glyphs.
+    void markPageUsed(uint8_t page);
+
+    /// Once a glyph has failed to fit, releases every page no frame still in flight has
+    /// drawn from, along with its glyphs, and returns true. Call only between compiles:
+    /// glyph instances compiled before it may point into the released pages, so compiled
+    /// output is stale from then on (see generation()).
+    bool reclaimColdPages();
+    /// Bumped by every reclaim, and when fallback fonts become available or the glyph mode
+    /// changes; compiled glyph instances from an older generation are stale.
+    uint64_t generation() const {
+        std::lock_guard lock(mutex_);
+        return generation_;
+    }
 
 private:
+    // Guards the faces, glyph cache and layout caches; public calls nest (layoutTextBox
+    // measures and lays out lines), hence recursive.
+    mutable std::recursive_mutex mutex_;
     Atlas atlas_;
+    /// A separate atlas so each page holds one kind of texel and a draw of one page needs
+    /// one pipeline; its page indices are offset by kDefaultMaxPages.
+    Atlas sdfAtlas_;
+    uint16_t sdfThreshold_ = 0;
+    /// Glyphs with no outline to take a distance field of; laid out from bitmaps instead.
+    std::unordered_set<GlyphKey, GlyphKeyHash> sdfUnsupported_;
     FT_Library ftLib_ = nullptr;
     std::unordered_map<uint16_t, FT_Face> faces_;
     /// Paths passed to FT_New_Face must outlive the face; FreeType may keep the pathname pointer.
     std::unordered_map<uint16_t, std::string> facePaths_;
     std::unordered_map<GlyphKey, GlyphInfo, GlyphKeyHash> cache_;
+    /// Measurement and wrapping read these, so text that is measured but never drawn does
+    /// not take atlas space; only layoutText rasterizes.
+    std::unordered_map<GlyphKey, GlyphMetrics, GlyphKeyHash> metricsCache_;
     std::unordered_map<std::string, uint16_t> fontKeyToIndex_;
     uint16_t nextFontIndex_{0};
 
+    uint64_t frame_ = 0;
+    uint64_t generation_ = 0;
+    std::vector<uint64_t> pageLastUse_;
+    bool allocationFailed_ = false;
+
     std::unordered_map<std::string, uint16_t> fallbackPathToIndex_;
     std::unordered_set<uint32_t> codepointMisses_;
+    // Fallback lookups that missed while the resolver was still pending (see
+    // FontProvider::codepointLookupPending): text measured meanwhile is not cached, and
+    // beginFrame bumps the generation once lookups are definite.
+    uint64_t pendingFallbackMisses_ = 0;
+    bool fallbackPending_ = false;
+
+    /// Under a LookupOnlyScope, notes that something had to be added and returns true.
+    static bool missInLookupOnlyScope();
 
     std::optional<uint16_t> loadFallbackForCodepoint(uint32_t codepoint, uint16_t baseFontIndex);
 
+    const GlyphInfo* findOrRasterize(const GlyphKey& key);
     bool rasterizeGlyph(const GlyphKey& key, GlyphInfo& out);
+    bool loadGlyphMetrics(const GlyphKey& key, GlyphMetrics& out);
+    const GlyphMetrics* getGlyphMetrics(uint32_t codepoint, uint16_t fontSize, uint16_t fontIndex);
     std::vector<std::string> wrapText(const std::string& text, float fontSize,
                                        float maxWidth, uint16_t fontIndex);
 
     void markFullAtlasDirty();
     void clearTextLayoutCaches();
 
-    /// When getGlyph returns null, use space advance if available, else a fraction of fontSize.
+    /// When a glyph is missing, use space advance if available, else a fraction of fontSize.
     float advanceWhenGlyphMissing(uint16_t fsz, uint16_t fontIndex, float fontSize);
 
     struct MeasureKey {
@@ -24,6 +24,23 @@ enum class CmdOp : uint32_t {
 
 class RenderCommandBuffer {
 public:
+    /// Words following each opcode in the stream.
+    static constexpr uint32_t operandWords(CmdOp op) {
+        switch (op) {
+            case CmdOp::Save: case CmdOp::Restore: case CmdOp::EndElement: return 0;
+            case CmdOp::Rotate: case CmdOp::SetOpacity: case CmdOp::SetFillStyle:
+            case CmdOp::SetStrokeStyle: case CmdOp::SetTextStyle:
+            case CmdOp::DrawPath: case CmdOp::ClipPath: return 1;
+            case CmdOp::Translate: case CmdOp::Scale: return 2;
+            case CmdOp::DrawCircle: return 3;
+            case CmdOp::DrawLine: case CmdOp::Clear: return 4;
+            case CmdOp::DrawText: case CmdOp::DrawTextBox: case CmdOp::BeginElement: return 5;
+            case CmdOp::DrawRect: return 8;
+            case CmdOp::DrawImage: case CmdOp::DrawImagePath: return 11;
+        }
+        return 0;
+    }
+
     // =========================================================================
     // Sequential reader for consumers (CommandCompiler, etc.)
     // =========================================================================
@@ -51,6 +68,9 @@ public:
 
         void seekTo(uint32_t absoluteWordOffset) { pos_ = begin_ + absoluteWordOffset; }
 
+        /// Steps over the operands of `op`, just read with nextOp().
+        void skipOperands(CmdOp op) { pos_ += operandWords(op); }
+
     private:
         const uint32_t* begin_;
         const uint32_t* pos_;
@@ -173,6 +193,72 @@ public:
         writeOp(CmdOp::EndElement);
     }
 
+    // =========================================================================
+    // Retained slices (Renderer): re-append commands recorded in an earlier
+    // frame's buffer. Pool ids are re-interned into this buffer and element
+    // end offsets are rebased, so the copy reads exactly like a fresh recording.
+    // Returns the word offset at which the copy starts.
+    // =========================================================================
+
+    uint32_t appendRange(const RenderCommandBuffer& src, uint32_t begin, uint32_t end) {
+        const uint32_t start = static_cast<uint32_t>(stream_.size());
+        const int64_t delta = static_cast<int64_t>(start) - static_cast<int64_t>(begin);
+        stream_.reserve(stream_.size() + (end - begin));
+
+        Reader r(src.stream_.data(), src.stream_.data() + end);
+        r.seekTo(begin);
+        auto copyWords = [&](int n) { for (int i = 0; i < n; ++i) writeU(r.readUint32()); };
+        while (r.hasNext()) {
+            CmdOp op = r.nextOp();
+            writeOp(op);
+            switch (op) {
+                case CmdOp::Save: case CmdOp::Restore: case CmdOp::EndElement:
+                    break;
+                case CmdOp::Rotate: case CmdOp::SetOpacity:
+                    copyWords(1); break;
+                case CmdOp::Translate: case CmdOp::Scale:
+                    copyWords(2); break;
+                case CmdOp::DrawCircle:
+                    copyWords(3); break;
+                case CmdOp::DrawLine: case CmdOp::Clear:
+                    copyWords(4); break;
+                case CmdOp::DrawRect:
+                    copyWords(8); break;
+                case CmdOp::DrawImage:
+                    copyWords(11); break;
+                case CmdOp::SetFillStyle:
+                    writeU(static_cast<uint32_t>(fillPool_.size()));
+                    fillPool_.push_back(src.fillPool_[r.readUint32()]);
+                    break;
+                case CmdOp::SetStrokeStyle:
+                    writeU(static_cast<uint32_t>(strokePool_.size()));
+                    strokePool_.push_back(src.strokePool_[r.readUint32()]);
+                    break;
+                case CmdOp::SetTextStyle:
+                    writeU(static_cast<uint32_t>(textStylePool_.size()));
+                    textStylePool_.push_back(src.textStylePool_[r.readUint32()]);
+                    break;
+                case CmdOp::DrawPath: case CmdOp::ClipPath:
+                    writeU(static_cast<uint32_t>(pathPool_.size()));
+                    pathPool_.push_back(src.pathPool_[r.readUint32()]);
+                    break;
+                case CmdOp::DrawText: case CmdOp::DrawTextBox:
+                    writeU(internString(src.stringPool_[r.readUint32()]));
+                    copyWords(4);
+                    break;
+                case CmdOp::DrawImagePath:
+                    writeU(internString(src.stringPool_[r.readUint32()]));
+                    copyWords(10);
+                    break;
+                case CmdOp::BeginElement:
+                    copyWords(4);
+                    writeU(static_cast<uint32_t>(static_cast<int64_t>(r.readUint32()) + delta));
+                    break;
+            }
+        }
+        return start;
+    }
+
     // =========================================================================
     // String pool (deduplicated within the frame)
     // =========================================================================
@@ -223,6 +309,20 @@ public:
 
     void reserve(size_t nWords) { stream_.reserve(nWords); }
 
+    /// True when both buffers hold the same commands referring to equal pool entries,
+    /// i.e. they render identically.
+    bool contentEquals(const RenderCommandBuffer& other) const {
+        if (stream_ != other.stream_ || fillPool_ != other.fillPool_ ||
+            strokePool_ != other.strokePool_ || textStylePool_ != other.textStylePool_ ||
+            stringPool_ != other.stringPool_ || pathPool_.size() != other.pathPool_.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < pathPool_.size(); ++i) {
+            if (pathPool_[i].contentHash() != other.pathPool_[i].contentHash()) return false;
+        }
+        return true;
+    }
+
 private:
     std::vector<uint32_t> stream_;
 
@@ -44,6 +44,8 @@ enum class ImageFit {
 };
 struct SolidFill {
     Color color = Colors::black;
+
+    bool operator==(const SolidFill&) const = default;
 };
 
 struct LinearGradientFill {
@@ -51,6 +53,8 @@ struct LinearGradientFill {
     Point endPoint = {100, 0};
     Color startColor = Colors::black;
     Color endColor = Colors::white;
+
+    bool operator==(const LinearGradientFill&) const = default;
 };
 
 struct RadialGradientFill {
@@ -59,6 +63,8 @@ struct RadialGradientFill {
     float outerRadius = 100.0f;
     Color startColor = Colors::black;
     Color endColor = Colors::white;
+
+    bool operator==(const RadialGradientFill&) const = default;
 };
 
 struct BoxGradientFill {
@@ -67,6 +73,8 @@ struct BoxGradientFill {
     float feather = 0.0f;
     Color innerColor = Colors::black;
     Color outerColor = Colors::white;
+
+    bool operator==(const BoxGradientFill&) const = default;
 };
 
 struct ImagePatternFill {
@@ -75,6 +83,8 @@ struct ImagePatternFill {
     Size size = {100, 100};
     float angle = 0.0f;
     float alpha = 1.0f;
+
+    bool operator==(const ImagePatternFill&) const = default;
 };
 
 struct FillStyle {
@@ -92,6 +102,8 @@ struct FillStyle {
 
     FillStyle() = default;
 
+    bool operator==(const FillStyle&) const = default;
+
     Type type() const { return static_cast<Type>(data.index()); }
 
     bool isNone()            const { return std::holds_alternative<std::monostate>(data); }
@@ -164,6 +176,8 @@ struct StrokeStyle {
     std::vector<float> dashPattern;  // Empty = solid line
     float dashOffset = 0.0f;
 
+    bool operator==(const StrokeStyle&) const = default;
+
     // ============================================================================
     // FACTORY METHODS
     // ============================================================================
@@ -222,6 +236,8 @@ struct TextStyle {
     float letterSpacing = 0.0f;
     float lineHeight = 1.0f;
 
+    bool operator==(const TextStyle&) const = default;
+
     // ============================================================================
     // FACTORY METHODS
     // ============================================================================
@@ -495,6 +511,26 @@ public:
 
     void setGlobalFocusedKey(const std::string& key) { globalFocusedKey_ = key; }
 
+    /**
+     * Running count of focus / hover / pressed queries made while rendering, and of
+     * those that found the current view focused, hovered or pressed. The Renderer
+     * diffs these around a subtree to decide whether its recorded commands can be
+     * replayed in a later frame.
+     */
+    struct InteractionReads {
+        uint64_t total = 0;
+        uint64_t active = 0;
+    };
+    InteractionReads interactionReads() const { return interactionReads_; }
+
+    /**
+     * Asks for the view being rendered to be drawn again next frame, for animations driven
+     * by the clock. The Renderer marks just that view's element dirty and redraws without
+     * regenerating any bodies.
+     */
+    void requestAnimationFrame() { ++animationFrameRequests_; }
+    uint64_t animationFrameRequests() const { return animationFrameRequests_; }
+
     // ============================================================================
     // COMMAND BUFFER RECORDING
     // ============================================================================
@@ -537,6 +573,14 @@ protected:
 
     class RenderCommandBuffer* recordingBuffer_ = nullptr;
 
+    mutable InteractionReads interactionReads_;
+    uint64_t animationFrameRequests_ = 0;
+    bool noteInteractionRead(bool active) const {
+        ++interactionReads_.total;
+        if (active) ++interactionReads_.active;
+        return active;
+    }
+
     std::vector<Environment> environmentStack_;
 };
 
@@ -10,6 +10,7 @@
 #include <Flux/Graphics/RenderContext.hpp>
 #include <Flux/Graphics/RenderCommandBuffer.hpp>
 #include <Flux/Core/OverlayManager.hpp>
+#include <unordered_map>
 
 namespace flux {
 
@@ -30,8 +31,43 @@ private:
     // Persistent element tree for identity and lifecycle
     std::unique_ptr<Element> rootElement_;
 
-    // Render command buffer (populated each frame alongside immediate draws)
+    // Render command buffer recorded this frame, and last frame's, from which the
+    // commands of unchanged element subtrees are copied instead of re-rendered.
     RenderCommandBuffer commandBuffer_;
+    RenderCommandBuffer previousBuffer_;
+
+    // An element subtree's commands (BeginElement through EndElement) in
+    // previousBuffer_, and the state they were recorded against.
+    struct RetainedSlice {
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        uint64_t subtreeVersion = 0;
+        Point offset;                   // element origin relative to its parent's
+        bool readsInteraction = false;  // render() queried focus/hover/pressed state
+        uint64_t interactionEpoch = 0;
+    };
+    std::unordered_map<const Element*, RetainedSlice> retainedSlices_;
+    std::unordered_map<const Element*, RetainedSlice> nextRetainedSlices_;
+    uint64_t nextRecordingId_ = 1;
+
+    // Focus/hover/pressed state visible to render(); interactionEpoch_ advances
+    // whenever it differs from the previous frame's.
+    struct InteractionSnapshot {
+        std::string focusedKey;
+        size_t focusableCount = 0;
+        bool hasHovered = false;
+        Rect hovered;
+        bool hasPressed = false;
+        Rect pressed;
+        bool operator==(const InteractionSnapshot&) const = default;
+    };
+    InteractionSnapshot interaction_;
+    uint64_t interactionEpoch_ = 0;
+
+    // Elements whose render() asked for another frame (RenderContext::requestAnimationFrame);
+    // marked dirty once the frame is recorded.
+    std::vector<Element*> animatedElements_;
+    bool unmountedAnimation_ = false;
 
     // Hover tracking: list of views currently under the pointer (root to deepest)
     std::vector<View> hoveredViews_;
@@ -86,10 +122,18 @@ public:
     bool isCursorBlinkActive() const { return cursorBlinkActive_; }
     const RenderCommandBuffer& lastCommandBuffer() const { return commandBuffer_; }
 
+    /// Element subtrees rendered fresh vs. copied from the previous frame in the last frame.
+    struct RetainedStats { size_t recorded = 0, replayed = 0; };
+    RetainedStats lastRetainedStats() const { return retainedStats_; }
+
     OverlayManager& overlayManager() { return overlayManager_; }
 
 private:
     void renderTree(LayoutNode& node, Element* element, Point parentOrigin = {0, 0});
+    bool replayRetainedSlice(const LayoutNode& node, Element* element, Point offset);
+    void carryRetainedSlices(const Element* element, int64_t delta);
+    void registerFocusables(const LayoutNode& node, Element* element);
+    RetainedStats retainedStats_;
 
     // Unified event pipeline: hit test → capture → target → bubble
     bool dispatchPointerEvent(LayoutNode& root, PointerEvent& event);
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace flux {
+
+/**
+ * Which font file to fall back to for each codepoint, read from the Unicode charmaps of the
+ * fonts under a set of directories.
+ *
+ * Coverage is kept as sorted, disjoint codepoint ranges, each naming the font that wins it,
+ * so a lookup is a binary search. Where several fonts cover a codepoint, regular sans-serif
+ * faces win over other regular faces, which win over bold and italic ones; ties go to the
+ * lexically first path. Only scalable faces are indexed, and only the first face of a
+ * collection, since that is the face a loaded font file gets.
+ *
+ * Scanning opens every font file, so the index is meant to be saved and reloaded. A saved
+ * index records the modification time of every directory it scanned: adding, removing or
+ * replacing a font file changes its directory's time, and any change makes load() refuse it.
+ */
+class FontCoverageIndex {
+public:
+    /// Scans `directories` recursively. Returns early with what it has once `cancel` is set.
+    static FontCoverageIndex build(const std::vector<std::string>& directories,
+                                   const std::atomic<bool>* cancel = nullptr);
+
+    /// An index save() wrote for the same `directories`; nullopt when the file is missing or
+    /// unreadable, or when any scanned directory has changed since.
+    static std::optional<FontCoverageIndex> load(const std::string& cachePath,
+                                                 const std::vector<std::string>& directories);
+    /// Writes the index to a temporary file beside `cachePath` and renames it into place,
+    /// creating the parent directory as needed.
+    bool save(const std::string& cachePath) const;
+
+    /// Path of the font file covering `codepoint`.
+    std::optional<std::string> find(uint32_t codepoint) const;
+
+    size_t fontCount() const { return fonts_.size(); }
+    size_t rangeCount() const { return ranges_.size(); }
+
+private:
+    struct Range {
+        uint32_t first;
+        uint32_t last; ///< inclusive
+        uint32_t font; ///< index into fonts_
+    };
+    struct DirectoryStamp {
+        std::string path;
+        int64_t mtime; ///< nanoseconds since the epoch; -1 when the directory does not exist
+    };
+
+    static int64_t directoryStamp(const std::string& path);
+
+    std::vector<std::string> fonts_;
+    std::vector<Range> ranges_;
+    uint32_t rootCount_ = 0;
+    std::vector<DirectoryStamp> directories_; ///< the roots, then every directory below them
+};
+
+} // namespace flux
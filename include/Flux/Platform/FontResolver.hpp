@@ -14,6 +14,10 @@ public:
                                                      FontWeight weight) = 0;
     virtual std::optional<std::string> findFontPathForCodepoint(
         uint32_t codepoint, const std::string& baseFontPath = "") = 0;
+    /// True while findFontPathForCodepoint cannot answer definitely yet (e.g. its font index
+    /// is still loading), so a nullopt it returns is not a miss to remember. The resolver
+    /// requests a redraw once its answers are definite.
+    virtual bool codepointLookupPending() { return false; }
 };
 
 } // namespace flux
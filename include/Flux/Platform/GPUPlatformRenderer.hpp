@@ -26,6 +26,9 @@ public:
     void updateDPIScale(float dpiScaleX, float dpiScaleY);
 
     void swapBuffers() override;
+    void setPipelined(bool enabled) override;
+    void setCompileThreads(size_t threads) override;
+    void setSdfTextThreshold(uint16_t fontSize) override;
 
     bool readPixels(int x, int y, int w, int h, std::vector<uint8_t>& out) override;
 
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <Flux/Platform/PlatformWindow.hpp>
+#include <Flux/Platform/PlatformRenderer.hpp>
+#include <string>
+#include <memory>
+
+namespace flux {
+
+class Window;
+
+/// Off-screen window rendered by the software GPU backend. Needs no display server or GPU, so
+/// `--test-mode` and `ScreenCapture` work on CI agents; frames are read back via `readPixels`.
+class HeadlessWindow : public PlatformWindow {
+public:
+    HeadlessWindow(const std::string& title, const Size& size, float dpiScale = 1.0f);
+    ~HeadlessWindow() override;
+
+    void resize(const Size& newSize) override;
+    void setFullscreen(bool fullscreen) override;
+    void setTitle(const std::string& title) override;
+    unsigned int windowID() const override;
+
+    RenderContext* renderContext() override;
+    PlatformRenderer* platformRenderer() override;
+    void swapBuffers() override;
+
+    float dpiScaleX() const override;
+    float dpiScaleY() const override;
+
+    Size currentSize() const override;
+    bool isFullscreen() const override;
+
+    void processEvents() override;
+    void waitForEvents(int timeoutMs = -1) override;
+    bool shouldClose() const override;
+
+    void setCursor(CursorType cursor) override;
+    CursorType currentCursor() const override;
+
+    void setFluxWindow(Window* window) override;
+
+    /// Wakes any headless window blocked in `waitForEvents` (called by `wakePlatformEventLoop`).
+    static void wakeEventLoop();
+
+private:
+    std::unique_ptr<PlatformRenderer> renderer_;
+    Window* fluxWindow_ = nullptr;
+    std::string title_;
+    Size size_;
+    float dpiScale_ = 1.0f;
+    bool fullscreen_ = false;
+    CursorType currentCursor_ = CursorType::Default;
+    unsigned int id_ = 0;
+};
+
+} // namespace flux
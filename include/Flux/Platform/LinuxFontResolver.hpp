@@ -1,14 +1,37 @@
 #pragma once
 
 #include <Flux/Platform/FontResolver.hpp>
+#include <Flux/Platform/FontCoverageIndex.hpp>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 namespace flux {
 
+/**
+ * Codepoint fallback comes from a FontCoverageIndex of the XDG font directories. The first
+ * codepoint the loaded faces cannot serve starts loading it, or scanning the directories
+ * when the copy saved under the user's cache directory is missing or stale, on a background
+ * thread. Until it is ready fallback lookups find nothing and report themselves pending, and
+ * a redraw is requested once it is; from then on each is a binary search.
+ */
 class LinuxFontResolver : public FontResolver {
 public:
+    ~LinuxFontResolver() override;
+
     std::optional<std::string> findFontPath(const std::string& familyName, FontWeight weight) override;
     std::optional<std::string> findFontPathForCodepoint(uint32_t codepoint,
                                                        const std::string& baseFontPath) override;
+    bool codepointLookupPending() override;
+
+private:
+    void startCoverageIndex();
+
+    std::mutex indexMutex_;
+    std::thread indexThread_;
+    std::atomic<bool> cancelIndex_{false};
+    bool indexStarted_ = false;
+    std::optional<FontCoverageIndex> index_;
 };
 
 } // namespace flux
@@ -10,12 +10,15 @@ enum class NativeGraphicsSurfaceKind : uint8_t {
     SdlWindow,
     /// macOS: `NSView*` hosting `CAMetalLayer` (plain pointer; cast in `.mm`).
     AppleNsView,
+    /// No presentation target: the software backend renders into CPU memory only (`ptr` unused).
+    Headless,
 };
 
 /**
  * Opaque GPU swapchain / layer host for `createDevice`.
  * - macOS + Metal: `kind == AppleNsView`, `ptr` is NSView*.
  * - Linux/Windows + Vulkan: `kind == SdlWindow`, `ptr` is SDL_Window*.
+ * - Software (headless): `kind == Headless`, `ptr` is null.
  */
 struct NativeGraphicsSurface {
     NativeGraphicsSurfaceKind kind = NativeGraphicsSurfaceKind::None;
@@ -28,6 +31,10 @@ struct NativeGraphicsSurface {
     static NativeGraphicsSurface fromAppleView(void* nsView) {
         return {NativeGraphicsSurfaceKind::AppleNsView, nsView};
     }
+
+    static NativeGraphicsSurface headless() {
+        return {NativeGraphicsSurfaceKind::Headless, nullptr};
+    }
 };
 
 } // namespace flux::gpu
@@ -25,6 +25,16 @@ public:
 
     virtual void swapBuffers() = 0;
 
+    /// Compile and submit frames on a render thread while the caller records the next
+    /// one. Renderers without one keep rendering synchronously.
+    virtual void setPipelined(bool enabled) { (void)enabled; }
+
+    /// Worker threads that may compile parts of a frame in parallel; 0 compiles serially.
+    virtual void setCompileThreads(size_t threads) { (void)threads; }
+
+    /// Font size in pixels from which text is drawn from distance fields; 0 disables them.
+    virtual void setSdfTextThreshold(uint16_t fontSize) { (void)fontSize; }
+
     /// Read back the current framebuffer as RGBA8 pixels (top-left origin).
     /// Returns false if readback is unsupported or fails.
     virtual bool readPixels(int x, int y, int w, int h, std::vector<uint8_t>& out) = 0;
@@ -26,6 +26,8 @@ public:
 
     virtual float dpiScaleX() const = 0;
     virtual float dpiScaleY() const = 0;
+    /// Refresh rate of the window's display in Hz, or 0 when the platform does not report it.
+    virtual double refreshRate() const { return 0; }
 
     virtual Size currentSize() const = 0;
     virtual bool isFullscreen() const = 0;
@@ -5,7 +5,9 @@ namespace flux {
 enum class RenderBackendType {
     GPU_Metal,
     GPU_Vulkan,
-    GPU_Auto
+    GPU_Auto,
+    /// CPU rasterizer with a headless window: no display or GPU required.
+    Software
 };
 
 /// Default GPU/render backend for this build — use `PlatformRegistry::instance().defaultRenderBackend()`.
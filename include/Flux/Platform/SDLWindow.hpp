@@ -30,6 +30,7 @@ public:
 
     float dpiScaleX() const override;
     float dpiScaleY() const override;
+    double refreshRate() const override;
 
     Size currentSize() const override;
     bool isFullscreen() const override;
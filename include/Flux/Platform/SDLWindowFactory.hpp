@@ -22,6 +22,9 @@ public:
     RenderBackendType renderBackend() const override { return backend_; }
 
 private:
+    /// SDL video is initialized on the first on-screen window so headless runs need no display.
+    void ensureSdlInitialized();
+
     bool sdlInitialized_ = false;
     RenderBackendType backend_ = RenderBackendType::GPU_Auto;
 };
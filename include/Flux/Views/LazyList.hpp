@@ -0,0 +1,226 @@
+#pragma once
+
+#include <Flux/Core/View.hpp>
+#include <Flux/Core/ViewHelpers.hpp>
+#include <Flux/Core/Types.hpp>
+#include <Flux/Core/Property.hpp>
+#include <Flux/Views/ScrollArea.hpp>
+#include <Flux/Views/RowHeightIndex.hpp>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace flux {
+
+/// Half-open range of row indices to materialize: rows intersecting
+/// [scrollOffset - overscan, scrollOffset + viewportHeight + overscan) for uniform rows.
+struct LazyListRange {
+    size_t first = 0;
+    size_t last = 0;
+
+    size_t size() const { return last - first; }
+    bool operator==(const LazyListRange&) const = default;
+};
+
+inline LazyListRange lazyListVisibleRange(size_t itemCount, float rowHeight, float scrollOffset,
+                                          float viewportHeight, float overscan) {
+    if (itemCount == 0 || rowHeight <= 0.0f || viewportHeight <= 0.0f) return {};
+    float top = std::max(0.0f, scrollOffset - overscan);
+    float bottom = std::max(top, scrollOffset + viewportHeight + overscan);
+    size_t first = static_cast<size_t>(std::floor(top / rowHeight));
+    size_t last = static_cast<size_t>(std::ceil(bottom / rowHeight));
+    first = std::min(first, itemCount);
+    last = std::clamp(last, first, itemCount);
+    return {first, last};
+}
+
+/// Keyed wrapper giving each materialized row an identity tied to its item index, so row
+/// elements (and their state) follow the item rather than the slot while scrolling.
+struct LazyListRow {
+    FLUX_VIEW_PROPERTIES;
+
+    View content;
+
+    LayoutNode layout(RenderContext& ctx, const Rect& bounds) {
+        std::vector<LayoutNode> children;
+        children.push_back(content.layout(ctx, bounds));
+        return LayoutNode(View(*this), bounds, std::move(children));
+    }
+
+    Size preferredSize(TextMeasurement& textMeasurer) const {
+        return content.preferredSize(textMeasurer);
+    }
+
+    float heightForWidth(float width, TextMeasurement& textMeasurer) const {
+        return content.heightForWidth(width, textMeasurer);
+    }
+};
+
+/**
+ * Virtualized vertical list. Only rows intersecting the viewport (plus `overscan` pixels above
+ * and below) are built, measured, laid out and reconciled, so a frame costs the same for 50 rows
+ * or 50k. With `rowHeight` set every row has that height; when 0, rows are measured at the
+ * current width as they come into view and recorded in a `RowHeightIndex`, with rows not yet
+ * seen counted at `estimatedRowHeight` (or, when 0, the mean measured height). Scrolling behaves
+ * like `ScrollArea`; bind `scrollY` to `Property<float>::shared` to keep the offset when the
+ * enclosing body is rebuilt.
+ */
+struct LazyList {
+    FLUX_VIEW_PROPERTIES;
+    FLUX_INTERACTIVE_PROPERTIES;
+
+    Property<size_t> itemCount = 0;
+    std::function<View(size_t)> rowBuilder = nullptr;
+
+    Property<float> rowHeight = 0.0f;
+    Property<float> estimatedRowHeight = 0.0f;
+    Property<float> overscan = 100.0f;
+    Property<float> scrollY = 0.0f;
+
+    // Measured heights at `width`. Kept on the list's element, so a keyed list in a
+    // regenerated body starts from the heights its predecessor measured.
+    struct RowHeights {
+        RowHeightIndex index;
+        float width = -1.0f;
+    };
+
+    mutable Size cachedContentSize;
+    mutable Rect cachedViewportRect;
+    mutable std::shared_ptr<RowHeights> rowHeights;
+    mutable LazyListRange measuredRows;
+
+    // An unkeyed list in a regenerated body has only measured the rows it just laid out.
+    // Fold those into the previous list's heights and keep those.
+    void transferState(const LazyList& old) {
+        if (!old.rowHeights || old.rowHeights == rowHeights) return;
+        if (!rowHeights || old.rowHeights->width != rowHeights->width) return;
+        RowHeightIndex& index = old.rowHeights->index;
+        const RowHeightIndex& fresh = rowHeights->index;
+        if (index.size() != fresh.size()) index.resize(fresh.size());
+        for (size_t i = measuredRows.first; i < measuredRows.last; ++i) {
+            if (fresh.isMeasured(i)) index.setHeight(i, fresh.height(i));
+        }
+        index.setEstimatedHeight(fresh.estimatedHeight());
+        rowHeights = old.rowHeights;
+        EdgeInsets paddingVal = padding;
+        cachedContentSize.height = static_cast<float>(index.totalHeight()) + paddingVal.vertical();
+    }
+
+    void init() {
+        onScroll = [this](float x, float y, float deltaX, float deltaY) {
+            (void)x; (void)y; (void)deltaX;
+            handleScroll(deltaY);
+        };
+    }
+
+    LayoutNode layout(RenderContext& ctx, const Rect& bounds) {
+        EdgeInsets paddingVal = padding;
+        cachedViewportRect = bounds;
+
+        const size_t count = rowBuilder ? static_cast<size_t>(itemCount) : 0;
+        const float contentWidth = std::max(0.0f, bounds.width - paddingVal.horizontal());
+        const float viewportHeight = std::max(0.0f, bounds.height - paddingVal.vertical());
+        const float originX = bounds.x + paddingVal.left;
+
+        std::vector<LayoutNode> rowLayouts;
+        auto layoutRow = [&](size_t i, View content, float y, float h) {
+            View row = LazyListRow{ .key = std::to_string(i), .content = std::move(content) };
+            rowLayouts.push_back(row.layout(ctx, Rect(originX, y, contentWidth, h)));
+        };
+
+        const float fixed = rowHeight;
+        if (fixed > 0.0f) {
+            cachedContentSize = Size(bounds.width, fixed * static_cast<float>(count) + paddingVal.vertical());
+            const float offset = std::clamp(static_cast<float>(scrollY), 0.0f, maxScrollOffset());
+            const LazyListRange range = lazyListVisibleRange(count, fixed, offset, viewportHeight, overscan);
+            rowLayouts.reserve(range.size());
+            const float originY = bounds.y + paddingVal.top - offset;
+            for (size_t i = range.first; i < range.last; ++i) {
+                layoutRow(i, rowBuilder(i), originY + fixed * static_cast<float>(i), fixed);
+            }
+        } else {
+            TextMeasurement& tm = static_cast<TextMeasurement&>(ctx);
+            RowHeightIndex& index = syncRowHeights(count, contentWidth, tm);
+            cachedContentSize = Size(bounds.width, static_cast<float>(index.totalHeight()) + paddingVal.vertical());
+            const float offset = std::clamp(static_cast<float>(scrollY), 0.0f, maxScrollOffset());
+            const float over = overscan;
+            const double top = std::max(0.0f, offset - over);
+            const double bottom = static_cast<double>(offset) + viewportHeight + over;
+
+            // Measured top-down, so each row's offset already includes this pass's corrections
+            // to the rows above it.
+            const size_t first = index.rowAt(top);
+            size_t i = first;
+            double y = index.offsetOf(first);
+            const float originY = bounds.y + paddingVal.top - offset;
+            for (; i < count && y < bottom && viewportHeight > 0.0f; ++i) {
+                View content = rowBuilder(i);
+                float h = content.heightForWidth(contentWidth, tm);
+                index.setHeight(i, h);
+                layoutRow(i, std::move(content), originY + static_cast<float>(y), h);
+                y += h;
+            }
+            measuredRows = {std::min(measuredRows.first, first), std::max(measuredRows.last, i)};
+            if (static_cast<float>(estimatedRowHeight) <= 0.0f) {
+                index.setEstimatedHeight(index.averageMeasuredHeight());
+            }
+            cachedContentSize.height = static_cast<float>(index.totalHeight()) + paddingVal.vertical();
+        }
+
+        std::vector<LayoutNode> childLayouts;
+        childLayouts.push_back(scrollClipNode(bounds, borderWidth, std::move(rowLayouts)));
+
+        return LayoutNode(View(*this), bounds, std::move(childLayouts));
+    }
+
+    Size preferredSize(TextMeasurement& /*textMeasurer*/) const {
+        EdgeInsets paddingVal = padding;
+        return Size(paddingVal.horizontal(), paddingVal.vertical());
+    }
+
+private:
+    RowHeightIndex& syncRowHeights(size_t count, float width, TextMeasurement& tm) const {
+        static const char stateTag = 0;
+        std::shared_ptr<void>* slot = Element::layoutState(&stateTag);
+        if (!rowHeights && !slot) {
+            rowHeights = std::static_pointer_cast<RowHeights>(Element::keyedLayoutState(&stateTag, key));
+        }
+        if (!rowHeights) rowHeights = std::make_shared<RowHeights>();
+        if (slot) *slot = rowHeights;
+
+        RowHeightIndex& index = rowHeights->index;
+        if (rowHeights->width != width) {
+            index.clearMeasurements();
+            rowHeights->width = width;
+        }
+        if (index.size() != count) index.resize(count);
+        measuredRows = {count, 0};
+
+        float estimate = estimatedRowHeight;
+        if (estimate <= 0.0f && count > 0 && index.measuredCount() == 0) {
+            // Seed the estimate from row 0 so the first frame's content height is plausible.
+            index.setHeight(0, rowBuilder(0).heightForWidth(width, tm));
+            measuredRows = {0, 1};
+        }
+        index.setEstimatedHeight(estimate > 0.0f ? estimate : index.averageMeasuredHeight());
+        return index;
+    }
+
+    float maxScrollOffset() const {
+        EdgeInsets paddingVal = padding;
+        float viewportHeight = cachedViewportRect.height - paddingVal.vertical();
+        return std::max(0.0f, cachedContentSize.height - paddingVal.vertical() - viewportHeight);
+    }
+
+    void handleScroll(float deltaY) {
+        scrollY = std::clamp(static_cast<float>(scrollY) + deltaY, 0.0f, maxScrollOffset());
+
+        if (onChange) {
+            onChange();
+        }
+    }
+};
+
+} // namespace flux
@@ -92,7 +92,7 @@ struct ProgressBar {
             ctx.setFillStyle(FillStyle::solid(fillColor));
             ctx.drawRect(fillRect, CornerRadius(barHeight / 2));
 
-            requestApplicationRedraw();
+            ctx.requestAnimationFrame();
         }
     }
 
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace flux {
+
+/**
+ * Prefix-sum index over variable row heights for virtualized lists.
+ *
+ * Every row starts at `estimatedHeight()`; `setHeight` records a measured height. Fenwick trees
+ * hold only the measured rows (their count and height sum), so a row's offset is
+ * `unmeasuredBefore * estimate + measuredSumBefore` and changing the estimate is O(1). Offset →
+ * row, row → offset and height updates are O(log n); sums are kept in double so pixel offsets
+ * stay exact past a million rows.
+ */
+class RowHeightIndex {
+public:
+    explicit RowHeightIndex(size_t count = 0, float estimatedHeight = 0.0f)
+        : estimate_(estimatedHeight) {
+        resize(count);
+    }
+
+    size_t size() const { return heights_.size(); }
+
+    /// Grows or shrinks the index. Surviving rows keep their measurements. Growing costs
+    /// O(log n) per added row; shrinking is O(n).
+    void resize(size_t count) {
+        const size_t n = heights_.size();
+        if (count < n || count_.empty()) {
+            heights_.resize(count, kUnmeasured);
+            rebuild();
+            return;
+        }
+        // Added rows are unmeasured, so node i covering (j, i] holds what old rows j+1..n
+        // contribute: the measured totals less the prefix up to j.
+        count_.reserve(count + 1);
+        sum_.reserve(count + 1);
+        for (size_t i = n + 1; i <= count; ++i) {
+            const size_t j = i - (i & (~i + 1));
+            const bool spansOld = j < n;
+            count_.push_back(spansOld ? measuredCount_ - prefixMeasured(j) : 0);
+            sum_.push_back(spansOld ? measuredSum_ - prefixMeasuredSum(j) : 0.0);
+        }
+        heights_.resize(count, kUnmeasured);
+    }
+
+    /// Forgets all measurements (e.g. after the content width changed); O(n).
+    void clearMeasurements() {
+        std::fill(heights_.begin(), heights_.end(), kUnmeasured);
+        rebuild();
+    }
+
+    float estimatedHeight() const { return estimate_; }
+    void setEstimatedHeight(float height) { estimate_ = height; }
+
+    size_t measuredCount() const { return measuredCount_; }
+    /// Mean of the measured heights, or the current estimate when nothing is measured yet.
+    float averageMeasuredHeight() const {
+        return measuredCount_ ? static_cast<float>(measuredSum_ / static_cast<double>(measuredCount_))
+                              : estimate_;
+    }
+
+    bool isMeasured(size_t row) const { return heights_[row] != kUnmeasured; }
+
+    float height(size_t row) const {
+        return isMeasured(row) ? heights_[row] : estimate_;
+    }
+
+    /// Records the measured height of `row`; O(log n).
+    void setHeight(size_t row, float height) {
+        height = std::max(0.0f, height);
+        const float old = heights_[row];
+        if (old == height) return;
+        double delta = height;
+        uint32_t countDelta = 0;
+        if (old == kUnmeasured) {
+            countDelta = 1;
+            ++measuredCount_;
+        } else {
+            delta -= old;
+        }
+        heights_[row] = height;
+        measuredSum_ += delta;
+        for (size_t i = row + 1; i < count_.size(); i += i & (~i + 1)) {
+            count_[i] += countDelta;
+            sum_[i] += delta;
+        }
+    }
+
+    /// Sum of heights of rows [0, row).
+    double offsetOf(size_t row) const {
+        row = std::min(row, heights_.size());
+        return static_cast<double>(row - prefixMeasured(row)) * estimate_ + prefixMeasuredSum(row);
+    }
+
+    double totalHeight() const { return offsetOf(heights_.size()); }
+
+    /// Row whose [offsetOf(row), offsetOf(row + 1)) span contains `offset`, clamped to valid rows.
+    size_t rowAt(double offset) const {
+        const size_t n = heights_.size();
+        if (n == 0 || offset <= 0.0) return 0;
+        size_t pos = 0;
+        double remaining = offset;
+        for (size_t step = std::bit_floor(n); step > 0; step >>= 1) {
+            size_t next = pos + step;
+            if (next > n) continue;
+            double span = static_cast<double>(step - count_[next]) * estimate_ + sum_[next];
+            if (span <= remaining) {
+                pos = next;
+                remaining -= span;
+            }
+        }
+        return std::min(pos, n - 1);
+    }
+
+private:
+    static constexpr float kUnmeasured = -1.0f;
+
+    // Unmeasured rows contribute `estimate_` each, applied at query time.
+    void rebuild() {
+        const size_t n = heights_.size();
+        count_.assign(n + 1, 0);
+        sum_.assign(n + 1, 0.0);
+        measuredCount_ = 0;
+        measuredSum_ = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            if (heights_[i] == kUnmeasured) continue;
+            ++measuredCount_;
+            measuredSum_ += heights_[i];
+            count_[i + 1] += 1;
+            sum_[i + 1] += heights_[i];
+        }
+        for (size_t i = 1; i <= n; ++i) {
+            size_t parent = i + (i & (~i + 1));
+            if (parent <= n) {
+                count_[parent] += count_[i];
+                sum_[parent] += sum_[i];
+            }
+        }
+    }
+
+    size_t prefixMeasured(size_t row) const {
+        size_t total = 0;
+        for (size_t i = row; i > 0; i &= i - 1) total += count_[i];
+        return total;
+    }
+
+    double prefixMeasuredSum(size_t row) const {
+        double total = 0.0;
+        for (size_t i = row; i > 0; i &= i - 1) total += sum_[i];
+        return total;
+    }
+
+    std::vector<float> heights_;
+    std::vector<uint32_t> count_;
+    std::vector<double> sum_;
+    float estimate_ = 0.0f;
+    size_t measuredCount_ = 0;
+    double measuredSum_ = 0.0;
+};
+
+} // namespace flux
@@ -24,6 +24,21 @@ struct ClipContainer {
     }
 };
 
+/// Wraps scrolled content in a clipping node inset by half the border width, so content
+/// never paints over the container's stroke.
+inline LayoutNode scrollClipNode(const Rect& bounds, float borderW, std::vector<LayoutNode> content) {
+    Rect clipRect = {
+        bounds.x + borderW / 2,
+        bounds.y + borderW / 2,
+        bounds.width - borderW,
+        bounds.height - borderW
+    };
+
+    ClipContainer clipper;
+    clipper.clip = true;
+    return LayoutNode(View(clipper), clipRect, std::move(content));
+}
+
 struct ScrollArea {
     FLUX_VIEW_PROPERTIES;
     FLUX_INTERACTIVE_PROPERTIES;
@@ -58,30 +73,37 @@ struct ScrollArea {
 
         float contentWidth = bounds.width - paddingVal.horizontal();
 
+        // Measure each visible child once; the heights feed both content size and placement.
+        std::vector<float> childHeights;
+        childHeights.reserve(childrenVec.size());
+        float totalHeight = paddingVal.vertical();
+        for (const auto& child : childrenVec) {
+            if (!child->isVisible()) continue;
+            float childH = child.heightForWidth(contentWidth, static_cast<TextMeasurement&>(ctx));
+            childHeights.push_back(childH);
+            totalHeight += childH;
+        }
+
         Size contentSz;
         if (contentSize.get().has_value()) {
             contentSz = contentSize.get().value();
         } else {
-            float totalHeight = paddingVal.vertical();
-            for (const auto& child : childrenVec) {
-                if (!child->isVisible()) continue;
-                float childH = child.heightForWidth(contentWidth, static_cast<TextMeasurement&>(ctx));
-                totalHeight += childH;
-            }
             contentSz = Size(bounds.width, totalHeight);
         }
 
         cachedContentSize = contentSz;
 
         std::vector<LayoutNode> contentChildLayouts;
+        contentChildLayouts.reserve(childHeights.size());
 
         float currentY = bounds.y + paddingVal.top - static_cast<float>(scrollY);
         float currentX = bounds.x + paddingVal.left - static_cast<float>(scrollX);
 
+        size_t visibleIndex = 0;
         for (auto& child : childrenVec) {
             if (!child->isVisible()) continue;
 
-            float childH = child.heightForWidth(contentWidth, static_cast<TextMeasurement&>(ctx));
+            float childH = childHeights[visibleIndex++];
             Rect childBounds(currentX, currentY, contentWidth, childH);
 
             LayoutNode childLayout = child.layout(ctx, childBounds);
@@ -90,21 +112,8 @@ struct ScrollArea {
             currentY += childH;
         }
 
-        float borderW = borderWidth;
-        Rect clipRect = {
-            bounds.x + borderW / 2,
-            bounds.y + borderW / 2,
-            bounds.width - borderW,
-            bounds.height - borderW
-        };
-
-        ClipContainer clipper;
-        clipper.clip = true;
-        View clipperView(clipper);
-
         std::vector<LayoutNode> childLayouts;
-        LayoutNode contentWrapper(clipperView, clipRect, std::move(contentChildLayouts));
-        childLayouts.push_back(std::move(contentWrapper));
+        childLayouts.push_back(scrollClipNode(bounds, borderWidth, std::move(contentChildLayouts)));
 
         return LayoutNode(View(*this), bounds, std::move(childLayouts));
     }
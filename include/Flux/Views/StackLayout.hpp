@@ -117,25 +117,30 @@ float stackHeightForWidth(
         }
         return height;
     } else {
-        std::vector<const View*> visible;
+        struct VisibleChild {
+            const View* view;
+            LayoutConstraints lc;
+            float preferredWidth;
+        };
+        std::vector<VisibleChild> visible;
         float totalPrefW = 0, totalExp = 0;
         for (const auto& child : children) {
             auto lc = child.getLayoutConstraints();
             if (!lc.visible) continue;
-            visible.push_back(&child);
-            totalPrefW += child.preferredSize(textMeasurer).width;
+            float prefW = child.preferredSize(textMeasurer).width;
+            visible.push_back({&child, lc, prefW});
+            totalPrefW += prefW;
             totalExp += lc.expansionBias;
         }
         float totalSpacing = visible.size() > 1 ? spacing * (visible.size() - 1) : 0;
         float remaining = childWidth - totalSpacing - totalPrefW;
         float maxH = 0;
-        for (const auto* c : visible) {
-            auto lc = c->getLayoutConstraints();
-            float cw = c->preferredSize(textMeasurer).width;
+        for (const auto& c : visible) {
+            float cw = c.preferredWidth;
             if (remaining > 0 && totalExp > 0)
-                cw += remaining * lc.expansionBias / totalExp;
-            if (lc.maxWidth.has_value()) cw = std::min(cw, lc.maxWidth.value());
-            maxH = std::max(maxH, c->heightForWidth(cw, textMeasurer));
+                cw += remaining * c.lc.expansionBias / totalExp;
+            if (c.lc.maxWidth.has_value()) cw = std::min(cw, c.lc.maxWidth.value());
+            maxH = std::max(maxH, c.view->heightForWidth(cw, textMeasurer));
         }
         return maxH + padding.vertical();
     }
@@ -42,7 +42,7 @@ struct TypingIndicator {
             ctx.drawCircle({cx + i * (r * 2 + sp), cy + offset}, r);
         }
 
-        requestApplicationRedraw();
+        ctx.requestAnimationFrame();
     }
 
     Size preferredSize(TextMeasurement&) const {
@@ -0,0 +1,18 @@
+#version 450
+
+layout(location = 0) in vec2 fragUV;
+layout(location = 1) in vec4 fragColor;
+
+// Signed distance field: 0.5 on the outline, increasing inside the glyph.
+layout(binding = 0) uniform sampler2D uAtlas;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    float dist = texture(uAtlas, fragUV).r;
+    // Antialias over one screen pixel at whatever scale the field is drawn.
+    float halfPixel = max(0.5 * length(vec2(dFdx(dist), dFdy(dist))), 1e-4);
+    float alpha = smoothstep(0.5 - halfPixel, 0.5 + halfPixel, dist);
+    outColor = vec4(fragColor.rgb, fragColor.a * alpha);
+    if (outColor.a < 0.004) discard;
+}
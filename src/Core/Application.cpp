@@ -1,6 +1,7 @@
 #include <Flux/Core/Application.hpp>
 #include <Flux/Core/Window.hpp>
 #include <Flux/Core/OverlayManager.hpp>
+#include <Flux/Core/MainThreadQueue.hpp>
 #include <Flux/Platform/EventLoopWake.hpp>
 #if defined(__APPLE__)
 // Public libobjc entry points (used by Swift/clang); not always declared in <objc/runtime.h>.
@@ -15,6 +16,8 @@ void objc_autoreleasePoolPop(void* pool);
 #include <Flux/Platform/MemoryFootprint.hpp>
 #include <Flux/Core/Log.hpp>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <cstdlib>
 #include <cstring>
@@ -36,18 +39,34 @@ namespace flux {
 Application* Application::current_ = nullptr;
 
 static thread_local int suppressRedrawRequests_ = 0;
+static std::atomic<uint64_t> redrawRequests_{0};
 
 void suppressRedrawRequests() { ++suppressRedrawRequests_; }
 void resumeRedrawRequests()   { --suppressRedrawRequests_; }
 
 void requestApplicationRedraw() {
     if (suppressRedrawRequests_ > 0) return;
+    redrawRequests_.fetch_add(1, std::memory_order_relaxed);
     if (Application::current_) {
         Application::current_->bumpBodyGeneration();
         Application::current_->requestRedraw();
     }
 }
 
+// Redraw for a change already recorded on the affected elements (Element::markDirty);
+// cached bodies elsewhere stay valid.
+void requestRedrawOnly() {
+    if (suppressRedrawRequests_ > 0) return;
+    redrawRequests_.fetch_add(1, std::memory_order_relaxed);
+    if (Application::current_) {
+        Application::current_->requestRedraw();
+    }
+}
+
+uint64_t redrawRequestCount() {
+    return redrawRequests_.load(std::memory_order_relaxed);
+}
+
 uint64_t currentBodyGeneration() {
     if (!Application::hasInstance()) return 0;
     return Application::instance().bodyGeneration();
@@ -94,8 +113,10 @@ void hideAllOverlays() {
 }
 
 void Application::requestRedraw() {
-    needsRedraw_.store(true, std::memory_order_relaxed);
-    wakePlatformEventLoop();
+    // Only the first request of a frame wakes the loop; it renders them all at once.
+    if (!needsRedraw_.exchange(true, std::memory_order_relaxed)) {
+        wakePlatformEventLoop();
+    }
 }
 
 void Application::setTheme(const Theme& theme) {
@@ -109,6 +130,7 @@ Application::Application(int argc, char** argv) {
         throw std::runtime_error("Only one Application instance allowed");
     }
     current_ = this;
+    MainThreadQueue::instance().setWakeHandler(&wakePlatformEventLoop);
 
     for (int i = 1; i < argc; i++) {
         if (std::strcmp(argv[i], "--test-mode") == 0) {
@@ -145,6 +167,9 @@ Application::Application(int argc, char** argv) {
                 ok = true;
 #endif
 #endif
+            } else if (std::strcmp(b, "software") == 0) {
+                factory->setRenderBackend(RenderBackendType::Software);
+                ok = true;
             } else if (std::strcmp(b, "gpu") == 0) {
                 try {
                     factory->setRenderBackend(RenderBackendType::GPU_Auto);
@@ -170,6 +195,7 @@ Application::Application(int argc, char** argv) {
 }
 
 Application::~Application() {
+    MainThreadQueue::instance().setWakeHandler(nullptr);
     windows_.clear();
     current_ = nullptr;
 }
@@ -195,36 +221,52 @@ int Application::exec() {
     if (backendArgInvalid_) {
         return 1;
     }
+    using Clock = FrameScheduler::Clock;
+    constexpr auto kCursorBlinkInterval = std::chrono::milliseconds(500);
     bool memoryReportAfterFirstFrame = false;
     while (running_) {
 #if defined(__APPLE__)
         MacAutoreleasePoolFrame macAutoreleasePoolFrame;
 #endif
-        bool redrawPending = needsRedraw_.load(std::memory_order_relaxed);
+        const auto now = Clock::now();
+        if (!windows_.empty()) {
+            if (auto* platformWindow = static_cast<PlatformWindow*>(windows_.front()->platformWindow())) {
+                frameScheduler_.setRefreshRate(platformWindow->refreshRate());
+            }
+        }
+        for (auto& window : windows_) {
+            if (window->isCursorBlinkActive()) {
+                const auto last = frameScheduler_.lastFrameTime();
+                frameScheduler_.requestFrameAt((last ? *last : now) + kCursorBlinkInterval);
+                break;
+            }
+        }
 
-        if (redrawPending) {
+        // Sleep until an event, or until the next frame when one is pending.
+        const auto wait = frameScheduler_.timeUntilFrame(needsRedraw_.load(std::memory_order_relaxed), now);
+        if (!wait) {
+            waitForEvents();
+        } else if (*wait == Clock::duration::zero()) {
             processEvents();
         } else {
-            bool blinkActive = false;
-            for (auto& window : windows_) {
-                if (window->isCursorBlinkActive()) { blinkActive = true; break; }
-            }
-            if (blinkActive) {
-                waitForEventsTimeout(500);
-                needsRedraw_.store(true, std::memory_order_relaxed);
-            } else {
-                waitForEvents();
-            }
+            const auto ms = std::chrono::ceil<std::chrono::milliseconds>(*wait).count();
+            waitForEventsTimeout(static_cast<int>(ms));
         }
 
         for (auto& window : windows_) {
             window->processSyntheticEvents();
         }
 
-        if (needsRedraw_.exchange(false, std::memory_order_relaxed)) {
+        // Writes posted from other threads land here, once per frame; their
+        // change notifications decide whether this frame renders.
+        MainThreadQueue::instance().drain();
+
+        if (frameScheduler_.frameDue(needsRedraw_.load(std::memory_order_relaxed), Clock::now())) {
+            needsRedraw_.store(false, std::memory_order_relaxed);
             for (auto& window : windows_) {
                 window->render();
             }
+            frameScheduler_.frameRendered(Clock::now());
             if (!memoryReportAfterFirstFrame) {
                 memoryReportAfterFirstFrame = true;
                 const std::string tag =
@@ -3,11 +3,125 @@
 #include <Flux/Core/Log.hpp>
 #include <algorithm>
 #include <unordered_map>
+#include <utility>
 
 namespace flux {
 
 uint64_t Element::sNextRenderVersion_ = 1;
 
+namespace {
+
+// Open fresh-layout scopes for the current layout pass (innermost last), plus the
+// number of open scopes whose previous subtree was already handed out and may
+// no longer be alive.
+struct LayoutPassState {
+    std::vector<Element*> scopes;
+    int blockedDepth = 0;
+};
+
+thread_local LayoutPassState tLayoutPass;
+
+// Reader registered by shared property reads, and the element whose event
+// handler is running (for attributing inline property writes).
+thread_local const std::shared_ptr<PropertyObserver>* tReadObserver = nullptr;
+thread_local Element* tEventTarget = nullptr;
+
+// Notifications deferred by open PropertyBatch scopes on this thread.
+struct PropertyBatchState {
+    int depth = 0;
+    std::vector<Element*> elements;
+    std::vector<std::shared_ptr<PropertyObserver>> observers;
+    bool unattributed = false;
+};
+
+thread_local PropertyBatchState tBatch;
+
+template<typename T>
+void addUnique(std::vector<T>& items, const T& item) {
+    if (std::find(items.begin(), items.end(), item) == items.end()) items.push_back(item);
+}
+
+bool sameObserver(const std::weak_ptr<PropertyObserver>& a, const std::shared_ptr<PropertyObserver>& b) {
+    return !a.owner_before(b) && !b.owner_before(a);
+}
+
+} // namespace
+
+void PropertyObserver::propertyChanged() {
+    ++changeCount;
+    if (element) {
+        element->markDirty();
+    }
+}
+
+void trackSharedPropertyRead(std::vector<std::weak_ptr<PropertyObserver>>& readers) {
+    if (!tReadObserver) return;
+    const auto& observer = *tReadObserver;
+    for (auto it = readers.rbegin(); it != readers.rend(); ++it) {
+        if (sameObserver(*it, observer)) return;
+    }
+    std::erase_if(readers, [](const auto& r) { return r.expired(); });
+    readers.push_back(observer);
+}
+
+void notifySharedPropertyChange(Element* owner, std::vector<std::weak_ptr<PropertyObserver>>& readers) {
+    const bool deferred = tBatch.depth > 0;
+    bool reachedElement = false;
+    if (owner) {
+        if (deferred) addUnique(tBatch.elements, owner);
+        else owner->markDirty();
+        reachedElement = true;
+    }
+    for (auto it = readers.begin(); it != readers.end();) {
+        if (auto observer = it->lock()) {
+            reachedElement = reachedElement || observer->element;
+            if (deferred) addUnique(tBatch.observers, observer);
+            else observer->propertyChanged();
+            ++it;
+        } else {
+            it = readers.erase(it);
+        }
+    }
+    // Nobody mounted is known to read it (never read under a scope, or only by
+    // views that are not in the tree): regenerate everything, as before.
+    if (!reachedElement) {
+        if (deferred) tBatch.unattributed = true;
+        else requestApplicationRedraw();
+    }
+}
+
+void notifyInlinePropertyChange(const void* property) {
+    for (Element* e = tEventTarget; e; e = e->parent) {
+        if (e->description && e->description->isValid() &&
+            (*e->description)->containsAddress(property)) {
+            if (tBatch.depth > 0) addUnique(tBatch.elements, e);
+            else e->markDirty();
+            return;
+        }
+    }
+    if (tBatch.depth > 0) tBatch.unattributed = true;
+    else requestApplicationRedraw();
+}
+
+PropertyBatch::PropertyBatch() {
+    ++tBatch.depth;
+}
+
+PropertyBatch::~PropertyBatch() {
+    if (--tBatch.depth > 0) return;
+    PropertyBatchState pending = std::exchange(tBatch, {});
+    if (pending.elements.empty() && pending.observers.empty() && !pending.unattributed) return;
+
+    // markDirty requests a redraw per element; issue one for the whole batch instead.
+    suppressRedrawRequests();
+    for (Element* element : pending.elements) element->markDirty();
+    for (const auto& observer : pending.observers) observer->propertyChanged();
+    resumeRedrawRequests();
+
+    if (pending.unattributed) requestApplicationRedraw();
+    else requestRedrawOnly();
+}
+
 Element::Element() = default;
 
 Element::~Element() {
@@ -21,10 +135,116 @@ Element& Element::operator=(Element&&) noexcept = default;
 
 void Element::markDirty() {
     bodyDirty = true;
-    requestApplicationRedraw();
+    if (description && description->isValid()) {
+        (*description)->invalidateBody();
+    }
+    for (Element* e = this; e; e = e->parent) {
+        e->layoutDirty = true;
+        if (e->description && e->description->isValid()) {
+            (*e->description)->invalidateMeasurements();
+        }
+    }
+    requestRedrawOnly();
+}
+
+LayoutNode* Element::takeRetainedLayout(Element* element, const ViewInterface* view, const Rect& bounds) {
+    if (!element || !element->layoutNode_) return nullptr;
+    if (tLayoutPass.scopes.empty() || tLayoutPass.blockedDepth > 0) return nullptr;
+    if (element->retainState_ != RetainState::None) return nullptr;
+    if (element->layoutDirty || element->bodyDirty) return nullptr;
+    if (element->layoutGeneration_ != currentBodyGeneration()) return nullptr;
+    if (!(element->lastConstraints == bounds)) return nullptr;
+
+    // layoutNode_ lives inside the previous node of an ancestor. It is only known
+    // to be intact while that ancestor is being laid out fresh and nothing in
+    // between was handed out already.
+    Element* scope = tLayoutPass.scopes.back();
+    Element* p = element->parent;
+    while (p && p != scope) {
+        if (p->retainState_ != RetainState::None) return nullptr;
+        p = p->parent;
+    }
+    if (!p) return nullptr;
+
+    LayoutNode* node = element->layoutNode_;
+    if (node->view.operator->() != view) return nullptr;
+
+    element->retainState_ = RetainState::Reused;
+    return node;
+}
+
+Element::LayoutScope::LayoutScope(Element* element) {
+    if (element) {
+        // Laid out again after its previous node was handed out: descendants may
+        // point into a subtree that has since been destroyed.
+        if (element->retainState_ != RetainState::None) {
+            blocking_ = true;
+            ++tLayoutPass.blockedDepth;
+        }
+        element->retainState_ = RetainState::Relaid;
+        element->layoutStateHolders_.clear();
+        element->layoutStateScanned_ = false;
+    }
+    tLayoutPass.scopes.push_back(element);
+}
+
+Element::LayoutScope::~LayoutScope() {
+    tLayoutPass.scopes.pop_back();
+    if (blocking_) {
+        --tLayoutPass.blockedDepth;
+    }
 }
 
-std::unique_ptr<Element> Element::buildTree(const LayoutNode& node, size_t index) {
+std::shared_ptr<void>* Element::layoutState(const void* tag) {
+    if (tLayoutPass.scopes.empty()) return nullptr;
+    Element* self = tLayoutPass.scopes.back();
+    if (!self) return nullptr;
+    self->layoutStateTag_ = tag;
+    return &self->layoutState_;
+}
+
+std::shared_ptr<void> Element::keyedLayoutState(const void* tag, const std::string& key) {
+    auto& scopes = tLayoutPass.scopes;
+    if (key.empty() || scopes.empty() || scopes.back()) return nullptr;
+    auto owner = std::find_if(scopes.rbegin(), scopes.rend(), [](Element* e) { return e; });
+    if (owner == scopes.rend()) return nullptr;
+    Element& o = **owner;
+    if (!o.layoutStateScanned_) {
+        auto scan = [&](auto& self, Element& e) -> void {
+            for (auto& child : e.children) {
+                if (child->layoutState_ && !child->key.empty()) {
+                    o.layoutStateHolders_.push_back(child.get());
+                }
+                self(self, *child);
+            }
+        };
+        scan(scan, o);
+        o.layoutStateScanned_ = true;
+    }
+    for (Element* e : o.layoutStateHolders_) {
+        if (e->layoutStateTag_ == tag && e->key == key) return e->layoutState_;
+    }
+    return nullptr;
+}
+
+Element::PropertyReadScope::PropertyReadScope(const std::shared_ptr<PropertyObserver>& observer)
+    : previous_(tReadObserver) {
+    tReadObserver = &observer;
+}
+
+Element::PropertyReadScope::~PropertyReadScope() {
+    tReadObserver = previous_;
+}
+
+Element::EventScope::EventScope(Element* target) : previous_(tEventTarget) {
+    tEventTarget = target;
+}
+
+Element::EventScope::~EventScope() {
+    tEventTarget = previous_;
+}
+
+std::unique_ptr<Element> Element::buildTree(LayoutNode& node, size_t index) {
     auto element = std::make_unique<Element>();
     element->typeName = node.view.getTypeName();
     element->key = node.view.getKey();
@@ -32,10 +252,15 @@ std::unique_ptr<Element> Element::buildTree(const LayoutNode& node, size_t index
     element->description = std::make_unique<View>(node.view);
     element->cachedBounds = node.bounds;
     element->lastConstraints = node.bounds;
+    element->layoutNode_ = &node;
+    element->layoutGeneration_ = currentBodyGeneration();
+    element->bumpRenderVersion();
 
+    element->subtreeRenderVersion_ = element->renderVersion_;
     for (size_t i = 0; i < node.children.size(); ++i) {
         auto child = buildTree(node.children[i], i);
         child->parent = element.get();
+        element->subtreeRenderVersion_ = std::max(element->subtreeRenderVersion_, child->subtreeRenderVersion_);
         element->children.push_back(std::move(child));
     }
 
@@ -43,7 +268,17 @@ std::unique_ptr<Element> Element::buildTree(const LayoutNode& node, size_t index
     return element;
 }
 
-void Element::reconcile(const LayoutNode& newNode) {
+void Element::reconcile(LayoutNode& newNode) {
+    // Subtree handed back unchanged by takeRetainedLayout: the node moved, but its
+    // descendants (and their elements) did not.
+    if (retainState_ == RetainState::Reused &&
+        newNode.view.operator->() == (*description).operator->()) {
+        retainState_ = RetainState::None;
+        layoutNode_ = &newNode;
+        return;
+    }
+    retainState_ = RetainState::None;
+
     bool boundsChanged = (cachedBounds.x != newNode.bounds.x ||
                           cachedBounds.y != newNode.bounds.y ||
                           cachedBounds.width != newNode.bounds.width ||
@@ -53,17 +288,24 @@ void Element::reconcile(const LayoutNode& newNode) {
     *description = newNode.view;
     (**description).transferStateFrom(*oldView);
     description->setPropertyOwner(this);
+    description->bindElement(this);
     typeName = newNode.view.getTypeName();
     key = newNode.view.getKey();
 
-    if (bodyDirty || boundsChanged) {
+    // What render() draws may have changed if this element's body was rebuilt, if all
+    // bodies were regenerated, or if the parent re-rendered (its body produced this
+    // description afresh).
+    if (bodyDirty || boundsChanged || layoutGeneration_ != currentBodyGeneration() ||
+        (parent && parent->renderVersion_ > renderVersion_)) {
         bumpRenderVersion();
     }
 
     cachedBounds = newNode.bounds;
     lastConstraints = newNode.bounds;
+    layoutNode_ = &newNode;
+    layoutGeneration_ = currentBodyGeneration();
     bodyDirty = false;
-    layoutDirty = boundsChanged;
+    layoutDirty = false;
 
     reconcileChildren(newNode.children);
 
@@ -73,7 +315,7 @@ void Element::reconcile(const LayoutNode& newNode) {
     }
 }
 
-void Element::reconcileChildren(const std::vector<LayoutNode>& newChildren) {
+void Element::reconcileChildren(std::vector<LayoutNode>& newChildren) {
     std::unordered_map<std::string, size_t> keyIndex;
     std::unordered_map<uint64_t, size_t> structIndex;
 
@@ -92,7 +334,7 @@ void Element::reconcileChildren(const std::vector<LayoutNode>& newChildren) {
     result.reserve(newChildren.size());
 
     for (size_t i = 0; i < newChildren.size(); ++i) {
-        const auto& newChild = newChildren[i];
+        auto& newChild = newChildren[i];
         std::string newKey = newChild.view.getKey();
 
         size_t matchIdx = SIZE_MAX;
@@ -139,6 +381,13 @@ void Element::bumpRenderVersion() {
     renderVersion_ = sNextRenderVersion_++;
 }
 
+void Element::markRenderDirty() {
+    bumpRenderVersion();
+    for (Element* e = this; e; e = e->parent) {
+        e->subtreeRenderVersion_ = std::max(e->subtreeRenderVersion_, renderVersion_);
+    }
+}
+
 Element* Element::findByFocusKey(const std::string& key) {
     if (description && description->isValid() && description->getFocusKey() == key) {
         return this;
@@ -155,6 +404,7 @@ void Element::mountSubtree() {
         isMounted = true;
         if (description && description->isValid()) {
             description->setPropertyOwner(this);
+            description->bindElement(this);
             description->onMounted();
         }
         FLUX_LOG_TRACE("[ELEMENT] Mounted %s", typeName.c_str());
@@ -171,6 +421,7 @@ void Element::unmountSubtree() {
     if (isMounted) {
         isMounted = false;
         if (description && description->isValid()) {
+            description->unbindElement(this);
             description->onUnmounted();
         }
         FLUX_LOG_TRACE("[ELEMENT] Unmounted %s", typeName.c_str());
@@ -0,0 +1,38 @@
+#include <Flux/Core/FrameScheduler.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace flux {
+
+FrameScheduler::Clock::duration FrameScheduler::frameInterval() const {
+    using Seconds = std::chrono::duration<double>;
+    if (targetFps_ <= 0) return Clock::duration::zero();
+    const double period = 1.0 / targetFps_;
+    if (refreshHz_ <= 0) return std::chrono::duration_cast<Clock::duration>(Seconds(period));
+    // Whole refreshes; the tolerance keeps 60 fps on a 59.94 Hz display at one refresh.
+    const double refresh = 1.0 / refreshHz_;
+    const double refreshes = std::max(1.0, std::ceil(period / refresh - 0.01));
+    return std::chrono::duration_cast<Clock::duration>(Seconds(refreshes * refresh));
+}
+
+void FrameScheduler::requestFrameAt(Clock::time_point when) {
+    if (!timedFrame_ || when < *timedFrame_) timedFrame_ = when;
+}
+
+std::optional<FrameScheduler::Clock::duration> FrameScheduler::timeUntilFrame(
+    bool redrawPending, Clock::time_point now) const {
+    std::optional<Clock::time_point> due = timedFrame_;
+    if (redrawPending) {
+        const Clock::time_point next = lastFrame_ ? *lastFrame_ + frameInterval() : now;
+        if (!due || next < *due) due = next;
+    }
+    if (!due) return std::nullopt;
+    return std::max(*due - now, Clock::duration::zero());
+}
+
+void FrameScheduler::frameRendered(Clock::time_point now) {
+    lastFrame_ = now;
+    if (timedFrame_ && *timedFrame_ <= now) timedFrame_.reset();
+}
+
+} // namespace flux
@@ -0,0 +1,78 @@
+#include <Flux/Core/MainThreadQueue.hpp>
+#include <Flux/Core/Property.hpp>
+#include <unordered_set>
+#include <vector>
+
+namespace flux {
+
+MainThreadQueue::~MainThreadQueue() {
+    Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+    while (node) {
+        Node* next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+MainThreadQueue& MainThreadQueue::instance() {
+    static MainThreadQueue queue;
+    return queue;
+}
+
+void MainThreadQueue::post(const void* key, std::function<void()> task) {
+    Node* node = new Node{nullptr, key, std::move(task)};
+    Node* head = head_.load(std::memory_order_relaxed);
+    do {
+        node->next = head;
+    } while (!head_.compare_exchange_weak(head, node, std::memory_order_release,
+                                          std::memory_order_relaxed));
+
+    if (!wakePending_.exchange(true, std::memory_order_acq_rel)) {
+        if (WakeHandler wake = wake_.load(std::memory_order_acquire)) {
+            wake();
+        }
+    }
+}
+
+MainThreadQueue::DrainStats MainThreadQueue::drain() {
+    // Re-arm the wake before taking the stack: a post racing with this drain either lands in
+    // the stack taken below or wakes the loop for the next one.
+    wakePending_.store(false, std::memory_order_release);
+    Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+
+    DrainStats stats;
+    if (!node) return stats;
+
+    // The stack is newest-first: the first node seen for a key is the one to keep.
+    std::vector<Node*> ordered;
+    std::unordered_set<const void*> seenKeys;
+    for (; node; node = node->next) {
+        if (node->key && !seenKeys.insert(node->key).second) {
+            ++stats.coalesced;
+            node->task = nullptr;
+        }
+        ordered.push_back(node);
+    }
+
+    // Everything drained together invalidates together.
+    PropertyBatch batch;
+    for (auto it = ordered.rbegin(); it != ordered.rend(); ++it) {
+        Node* n = *it;
+        if (n->task) {
+            n->task();
+            ++stats.executed;
+        }
+        delete n;
+    }
+    return stats;
+}
+
+void postToMainThread(std::function<void()> task) {
+    MainThreadQueue::instance().post(std::move(task));
+}
+
+void postPropertyWrite(const void* key, std::function<void()> write) {
+    MainThreadQueue::instance().post(key, std::move(write));
+}
+
+} // namespace flux
@@ -0,0 +1,66 @@
+#include <Flux/Core/ThreadPool.hpp>
+
+namespace flux {
+
+ThreadPool::ThreadPool(size_t threads) {
+    threads_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& t : threads_) t.join();
+}
+
+void ThreadPool::parallelFor(size_t count, const Task& task) {
+    if (count == 0) return;
+    if (threads_.empty() || count == 1) {
+        for (size_t i = 0; i < count; ++i) task(i, threads_.size());
+        return;
+    }
+    {
+        std::lock_guard lock(mutex_);
+        task_ = &task;
+        count_ = count;
+        next_.store(0, std::memory_order_relaxed);
+        busy_ = threads_.size();
+        ++generation_;
+    }
+    wake_.notify_all();
+    runIndices(threads_.size());
+
+    std::unique_lock lock(mutex_);
+    done_.wait(lock, [this]() { return busy_ == 0; });
+    task_ = nullptr;
+}
+
+void ThreadPool::workerLoop(size_t slot) {
+    uint64_t seen = 0;
+    std::unique_lock lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [&]() { return stopping_ || generation_ != seen; });
+        if (stopping_) return;
+        seen = generation_;
+        lock.unlock();
+        runIndices(slot);
+        lock.lock();
+        if (--busy_ == 0) done_.notify_one();
+    }
+}
+
+void ThreadPool::runIndices(size_t slot) {
+    // task_ and count_ are published under the mutex before the wake-up and stay put until
+    // every worker has checked in, so reading them here needs no lock.
+    for (size_t i = next_.fetch_add(1, std::memory_order_relaxed); i < count_;
+         i = next_.fetch_add(1, std::memory_order_relaxed)) {
+        (*task_)(i, slot);
+    }
+}
+
+} // namespace flux
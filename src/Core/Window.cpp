@@ -12,6 +12,7 @@
 #include <Flux/Graphics/RenderContext.hpp>
 #include <Flux/Core/OverlayManager.hpp>
 #include <Flux/Platform/PlatformWindow.hpp>
+#include <Flux/Platform/PlatformRenderer.hpp>
 #include "../Testing/TestServer.hpp"
 #include "../Testing/ScreenCapture.hpp"
 
@@ -64,6 +65,11 @@ struct Window::WindowImpl {
         );
         
         FLUX_LOG_INFO("Using %s backend", factory->getPlatformName().c_str());
+        if (auto* platformRenderer = platformWindow->platformRenderer()) {
+            if (cfg.compileThreads > 0) platformRenderer->setCompileThreads(cfg.compileThreads);
+            if (cfg.sdfTextThreshold > 0) platformRenderer->setSdfTextThreshold(cfg.sdfTextThreshold);
+            if (cfg.pipelinedRendering) platformRenderer->setPipelined(true);
+        }
         
         // Create renderer
         renderer = std::make_unique<ImmediateModeRenderer>(platformWindow->renderContext());
@@ -11,7 +11,10 @@ std::unique_ptr<Device> createMetalDevice(void* nsView);
 std::unique_ptr<Device> createVulkanDevice(void* sdlWindow);
 #endif
 
-std::unique_ptr<Device> createDevice(Backend backend, NativeGraphicsSurface surface) {
+std::unique_ptr<Device> createSoftwareDevice();
+
+std::unique_ptr<Device> createDevice(Backend backend,
+                                     [[maybe_unused]] NativeGraphicsSurface surface) {
     switch (backend) {
 #ifdef __APPLE__
         case Backend::Metal:
@@ -27,6 +30,9 @@ std::unique_ptr<Device> createDevice(Backend backend, NativeGraphicsSurface surf
             }
             return createVulkanDevice(surface.ptr);
 #endif
+        case Backend::Software:
+            // Renders into CPU memory; any surface kind (including None) is accepted.
+            return createSoftwareDevice();
         default:
             throw std::runtime_error("Requested GPU backend not available on this platform");
     }
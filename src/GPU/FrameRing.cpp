@@ -0,0 +1,66 @@
+#include <Flux/GPU/FrameRing.hpp>
+#include <algorithm>
+
+namespace flux::gpu {
+
+FrameRing::FrameRing(Device* device, size_t chunkSize)
+    : device_(device), chunkSize_(chunkSize) {}
+
+FrameRing::Chunk FrameRing::makeChunk(size_t size) {
+    Chunk c;
+    BufferDesc desc;
+    desc.size = size;
+    desc.usage = BufferUsage::Vertex;
+    c.buffer = device_->createBuffer(desc);
+    c.mapped = static_cast<uint8_t*>(c.buffer->mappedData());
+    if (!c.mapped) c.shadow.resize(size);
+    c.size = size;
+    return c;
+}
+
+void FrameRing::beginFrame() {
+    // Device::beginFrame() has waited for the GPU to finish with this slot's buffers.
+    slot_ = &slots_[device_->currentFrameIndex() % Device::kMaxFramesInFlight];
+    if (slot_->chunks.size() > 1) {
+        size_t total = 0;
+        for (const Chunk& c : slot_->chunks) total += c.used;
+        slot_->chunks.clear();
+        slot_->chunks.push_back(makeChunk(std::max(chunkSize_, total + total / 2)));
+    }
+    for (Chunk& c : slot_->chunks) c.used = 0;
+    slot_->current = 0;
+    allocated_ = 0;
+}
+
+RingSlice FrameRing::allocate(size_t size, size_t alignment) {
+    if (size == 0) return {};
+    for (;;) {
+        if (slot_->current == slot_->chunks.size()) {
+            slot_->chunks.push_back(makeChunk(std::max(chunkSize_, size)));
+        }
+        Chunk& c = slot_->chunks[slot_->current];
+        const size_t offset = (c.used + alignment - 1) / alignment * alignment;
+        if (offset + size <= c.size) {
+            c.used = offset + size;
+            allocated_ += size;
+            uint8_t* base = c.mapped ? c.mapped : c.shadow.data();
+            return {c.buffer.get(), offset, base + offset};
+        }
+        ++slot_->current;
+    }
+}
+
+void FrameRing::flush() {
+    const size_t end = std::min(slot_->current + 1, slot_->chunks.size());
+    for (size_t i = 0; i < end; ++i) {
+        Chunk& c = slot_->chunks[i];
+        if (c.used == 0) continue;
+        if (c.mapped) {
+            c.buffer->flushMapped(0, c.used);
+        } else {
+            c.buffer->write(c.shadow.data(), c.used);
+        }
+    }
+}
+
+} // namespace flux::gpu
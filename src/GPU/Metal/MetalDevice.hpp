@@ -17,6 +17,7 @@ public:
     MetalBuffer(id<MTLDevice> device, const BufferDesc& desc);
     void write(const void* data, size_t size, size_t offset = 0) override;
     size_t size() const override;
+    void* mappedData() override { return [buffer_ contents]; }
     id<MTLBuffer> native() const { return buffer_; }
 
 private:
@@ -0,0 +1,718 @@
+#include "SoftwareDevice.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+namespace flux::gpu {
+
+// Instance / vertex layouts as declared by GPURendererBackend (byte offsets).
+namespace layout {
+// SDFQuadInstance
+constexpr size_t kSdfRect = 0;
+constexpr size_t kSdfCorners = 16;
+constexpr size_t kSdfFill = 32;
+constexpr size_t kSdfStroke = 48;
+constexpr size_t kSdfStrokeOpacity = 64;
+constexpr size_t kSdfRotation = 80;
+// GlyphInstance / ImageInstance
+constexpr size_t kQuadScreenRect = 0;
+constexpr size_t kQuadUV = 16;
+constexpr size_t kQuadColor = 32;
+constexpr size_t kQuadRotation = 56;
+// PathVertex
+constexpr size_t kPathPos = 0;
+constexpr size_t kPathColor = 8;
+} // namespace layout
+
+static constexpr int kLanes = 8;
+
+static void readFloats(const uint8_t* src, size_t offset, float* dst, size_t count) {
+    std::memcpy(dst, src + offset, count * sizeof(float));
+}
+
+static float smoothstep(float e0, float e1, float x) {
+    float t = std::clamp((x - e0) / (e1 - e0), 0.0f, 1.0f);
+    return t * t * (3.0f - 2.0f * t);
+}
+
+// =============================================================================
+// SoftwareBuffer
+// =============================================================================
+
+SoftwareBuffer::SoftwareBuffer(const BufferDesc& desc)
+    : data_(desc.size, 0) {}
+
+void SoftwareBuffer::write(const void* data, size_t size, size_t offset) {
+    if (offset >= data_.size()) return;
+    size = std::min(size, data_.size() - offset);
+    std::memcpy(data_.data() + offset, data, size);
+}
+
+size_t SoftwareBuffer::size() const { return data_.size(); }
+
+// =============================================================================
+// SoftwareTexture
+// =============================================================================
+
+SoftwareTexture::SoftwareTexture(const TextureDesc& desc)
+    : width_(desc.width), height_(desc.height), format_(desc.format)
+{
+    texels_.assign(static_cast<size_t>(width_) * height_ * bytesPerPixel(format_), 0);
+}
+
+void SoftwareTexture::write(const void* data, uint32_t x, uint32_t y, uint32_t w, uint32_t h,
+                            uint32_t srcBytesPerRow) {
+    if (!data || x >= width_ || y >= height_) return;
+    const uint32_t bpp = bytesPerPixel(format_);
+    const size_t srcPitch = srcBytesPerRow ? srcBytesPerRow : static_cast<size_t>(w) * bpp;
+    const uint32_t cw = std::min(w, width_ - x);
+    const uint32_t ch = std::min(h, height_ - y);
+    const auto* src = static_cast<const uint8_t*>(data);
+    for (uint32_t row = 0; row < ch; ++row) {
+        std::memcpy(texels_.data() + (static_cast<size_t>(y + row) * width_ + x) * bpp,
+                    src + row * srcPitch, static_cast<size_t>(cw) * bpp);
+    }
+}
+
+uint32_t SoftwareTexture::width() const { return width_; }
+uint32_t SoftwareTexture::height() const { return height_; }
+
+void SoftwareTexture::resize(uint32_t width, uint32_t height) {
+    width_ = width;
+    height_ = height;
+    texels_.assign(static_cast<size_t>(width_) * height_ * bytesPerPixel(format_), 0);
+}
+
+/// Bilinear, clamp-to-edge, normalized coordinates; returns straight RGBA in [0, 1].
+static void sampleBilinear(const SoftwareTexture& tex, float u, float v, float out[4]) {
+    const int w = static_cast<int>(tex.width());
+    const int h = static_cast<int>(tex.height());
+    if (w == 0 || h == 0) {
+        out[0] = out[1] = out[2] = out[3] = 0.0f;
+        return;
+    }
+    const float fx = u * static_cast<float>(w) - 0.5f;
+    const float fy = v * static_cast<float>(h) - 0.5f;
+    const float flx = std::floor(fx);
+    const float fly = std::floor(fy);
+    const float tx = fx - flx;
+    const float ty = fy - fly;
+    const int x0 = std::clamp(static_cast<int>(flx), 0, w - 1);
+    const int y0 = std::clamp(static_cast<int>(fly), 0, h - 1);
+    const int x1 = std::clamp(static_cast<int>(flx) + 1, 0, w - 1);
+    const int y1 = std::clamp(static_cast<int>(fly) + 1, 0, h - 1);
+    const float w00 = (1.0f - tx) * (1.0f - ty);
+    const float w10 = tx * (1.0f - ty);
+    const float w01 = (1.0f - tx) * ty;
+    const float w11 = tx * ty;
+    const uint8_t* t = tex.texels();
+
+    if (tex.format() == PixelFormat::R8) {
+        float r = (t[y0 * w + x0] * w00 + t[y0 * w + x1] * w10 +
+                   t[y1 * w + x0] * w01 + t[y1 * w + x1] * w11) * (1.0f / 255.0f);
+        out[0] = r;
+        out[1] = out[2] = 0.0f;
+        out[3] = 1.0f;
+        return;
+    }
+
+    const uint8_t* p00 = t + (static_cast<size_t>(y0) * w + x0) * 4;
+    const uint8_t* p10 = t + (static_cast<size_t>(y0) * w + x1) * 4;
+    const uint8_t* p01 = t + (static_cast<size_t>(y1) * w + x0) * 4;
+    const uint8_t* p11 = t + (static_cast<size_t>(y1) * w + x1) * 4;
+    for (int c = 0; c < 4; ++c) {
+        out[c] = (p00[c] * w00 + p10[c] * w10 + p01[c] * w01 + p11[c] * w11) * (1.0f / 255.0f);
+    }
+    if (tex.format() == PixelFormat::BGRA8) std::swap(out[0], out[2]);
+}
+
+// =============================================================================
+// SoftwareRenderPipeline
+// =============================================================================
+
+SoftwareRenderPipeline::SoftwareRenderPipeline(const RenderPipelineDesc& desc)
+    : program_(desc.program), blendEnabled_(desc.blendEnabled)
+{
+    if (!desc.vertexBuffers.empty()) stride_ = desc.vertexBuffers.back().stride;
+}
+
+// =============================================================================
+// SoftwareRenderPassEncoder
+// =============================================================================
+
+SoftwareRenderPassEncoder::SoftwareRenderPassEncoder(std::vector<SoftwarePrimitive>& out,
+                                                     uint32_t width, uint32_t height)
+    : out_(out), width_(width), height_(height)
+{
+    setScissorRect(0, 0, width, height);
+}
+
+void SoftwareRenderPassEncoder::setPipeline(RenderPipeline* pipeline) {
+    pipeline_ = static_cast<SoftwareRenderPipeline*>(pipeline);
+}
+
+void SoftwareRenderPassEncoder::setVertexBuffer(uint32_t slot, Buffer* buffer, size_t offset) {
+    if (slot >= kMaxVertexBuffers) return;
+    vertexBuffers_[slot] = static_cast<const SoftwareBuffer*>(buffer);
+    vertexOffsets_[slot] = offset;
+}
+
+void SoftwareRenderPassEncoder::setIndexBuffer(Buffer*) {
+    // Index buffers are unused by the built-in programs.
+}
+
+void SoftwareRenderPassEncoder::setFragmentTexture(uint32_t slot, Texture* texture) {
+    if (slot == 0) texture_ = static_cast<const SoftwareTexture*>(texture);
+}
+
+void SoftwareRenderPassEncoder::setScissorRect(uint32_t x, uint32_t y, uint32_t w, uint32_t h) {
+    scissor_[0] = static_cast<int32_t>(std::min(x, width_));
+    scissor_[1] = static_cast<int32_t>(std::min(y, height_));
+    scissor_[2] = static_cast<int32_t>(std::min<uint64_t>(uint64_t{x} + w, width_));
+    scissor_[3] = static_cast<int32_t>(std::min<uint64_t>(uint64_t{y} + h, height_));
+}
+
+bool SoftwareRenderPassEncoder::clip(SoftwarePrimitive& prim, float minX, float minY,
+                                     float maxX, float maxY) const {
+    if (!(minX <= maxX && minY <= maxY)) return false;  // also rejects NaN
+    auto lo = [](float v, int32_t bound) {
+        return std::max(bound, static_cast<int32_t>(std::max(std::floor(v), -1.0e9f)));
+    };
+    auto hi = [](float v, int32_t bound) {
+        return std::min(bound, static_cast<int32_t>(std::min(std::ceil(v), 1.0e9f)));
+    };
+    prim.x0 = lo(minX, scissor_[0]);
+    prim.y0 = lo(minY, scissor_[1]);
+    prim.x1 = hi(maxX, scissor_[2]);
+    prim.y1 = hi(maxY, scissor_[3]);
+    return prim.x0 < prim.x1 && prim.y0 < prim.y1;
+}
+
+void SoftwareRenderPassEncoder::emitQuad(SoftwarePrimitive& prim, float x, float y,
+                                         float w, float h, float rotation) {
+    prim.halfW = w * 0.5f;
+    prim.halfH = h * 0.5f;
+    prim.centerX = x + prim.halfW;
+    prim.centerY = y + prim.halfH;
+
+    const bool sdf = prim.program == ShaderProgram::SDFRect ||
+                     prim.program == ShaderProgram::SDFCircle ||
+                     prim.program == ShaderProgram::SDFLine;
+    const float pad = sdf ? std::max(prim.strokeWidth, 1.0f) : 0.0f;
+    prim.padHalfW = prim.halfW + pad;
+    prim.padHalfH = prim.halfH + pad;
+
+    // Lines are rotated by their direction first (sdf_line.vert.glsl), then by the instance rotation.
+    float cr = std::cos(rotation);
+    float sr = std::sin(rotation);
+    if (prim.program == ShaderProgram::SDFLine) {
+        const float lc = prim.corners[0];
+        const float ls = prim.corners[1];
+        const float c = cr * lc - sr * ls;
+        const float s = sr * lc + cr * ls;
+        cr = c;
+        sr = s;
+    }
+    prim.cosA = cr;
+    prim.sinA = sr;
+
+    const float ex = std::abs(cr) * prim.padHalfW + std::abs(sr) * prim.padHalfH;
+    const float ey = std::abs(sr) * prim.padHalfW + std::abs(cr) * prim.padHalfH;
+    if (clip(prim, prim.centerX - ex, prim.centerY - ey, prim.centerX + ex, prim.centerY + ey)) {
+        out_.push_back(prim);
+    }
+}
+
+void SoftwareRenderPassEncoder::draw(uint32_t vertexCount, uint32_t instanceCount,
+                                     uint32_t firstVertex, uint32_t firstInstance) {
+    if (!pipeline_) return;
+    const ShaderProgram program = pipeline_->program();
+    const size_t stride = pipeline_->stride();
+    if (program == ShaderProgram::Custom || stride == 0) return;
+
+    SoftwarePrimitive prim;
+    prim.program = program;
+    prim.blend = pipeline_->blendEnabled();
+
+    if (program == ShaderProgram::Path) {
+        const SoftwareBuffer* vb = vertexBuffers_[0];
+        if (!vb) return;
+        const size_t base = vertexOffsets_[0];
+        const uint32_t triangles = vertexCount / 3;
+        for (uint32_t t = 0; t < triangles; ++t) {
+            const size_t first = base + (static_cast<size_t>(firstVertex) + t * 3) * stride;
+            if (first + 3 * stride > vb->size()) break;
+            float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f;
+            for (int k = 0; k < 3; ++k) {
+                const uint8_t* v = vb->data() + first + k * stride;
+                float pos[2];
+                readFloats(v, layout::kPathPos, pos, 2);
+                readFloats(v, layout::kPathColor, prim.vcolor[k], 4);
+                prim.vx[k] = pos[0];
+                prim.vy[k] = pos[1];
+                minX = std::min(minX, pos[0]); maxX = std::max(maxX, pos[0]);
+                minY = std::min(minY, pos[1]); maxY = std::max(maxY, pos[1]);
+            }
+            if (clip(prim, minX, minY, maxX, maxY)) out_.push_back(prim);
+        }
+        return;
+    }
+
+    const SoftwareBuffer* ib = vertexBuffers_[1];
+    if (!ib) return;
+    const bool textured = program == ShaderProgram::Glyph || program == ShaderProgram::GlyphSDF ||
+                          program == ShaderProgram::Image;
+    if (textured && !texture_) return;
+    prim.texture = texture_;
+
+    for (uint32_t i = 0; i < instanceCount; ++i) {
+        const size_t at = vertexOffsets_[1] + (static_cast<size_t>(firstInstance) + i) * stride;
+        if (at + stride > ib->size()) break;
+        const uint8_t* inst = ib->data() + at;
+        float rect[4];
+        float rotation = 0.0f;
+        if (textured) {
+            readFloats(inst, layout::kQuadScreenRect, rect, 4);
+            readFloats(inst, layout::kQuadUV, prim.uv, 4);
+            readFloats(inst, layout::kQuadColor, prim.fill, 4);
+            readFloats(inst, layout::kQuadRotation, &rotation, 1);
+        } else {
+            float strokeOpacity[2];
+            readFloats(inst, layout::kSdfRect, rect, 4);
+            readFloats(inst, layout::kSdfCorners, prim.corners, 4);
+            readFloats(inst, layout::kSdfFill, prim.fill, 4);
+            readFloats(inst, layout::kSdfStroke, prim.stroke, 4);
+            readFloats(inst, layout::kSdfStrokeOpacity, strokeOpacity, 2);
+            readFloats(inst, layout::kSdfRotation, &rotation, 1);
+            prim.strokeWidth = strokeOpacity[0];
+            prim.opacity = strokeOpacity[1];
+        }
+        emitQuad(prim, rect[0], rect[1], rect[2], rect[3], rotation);
+    }
+}
+
+void SoftwareRenderPassEncoder::drawIndexed(uint32_t, uint32_t, uint32_t, uint32_t) {
+    // Not used by GPURendererBackend; the built-in programs draw non-indexed.
+}
+
+void SoftwareRenderPassEncoder::end() {}
+
+// =============================================================================
+// Tile shading
+// =============================================================================
+
+namespace {
+
+/// Planar float RGBA for one tile, padded by a lane group so span loops never need a tail.
+struct TileScratch {
+    static constexpr int kStride = 64;
+    static constexpr int kSize = kStride * kStride + kLanes;
+    float r[kSize], g[kSize], b[kSize], a[kSize];
+};
+
+struct LaneColor {
+    float r[kLanes], g[kLanes], b[kLanes], a[kLanes];
+    float mask[kLanes];
+};
+
+/// Stroke-over-fill composite shared by rect.frag.glsl and circle.frag.glsl.
+inline void compositeSdf(const SoftwarePrimitive& p, const float* d, LaneColor& out) {
+    for (int i = 0; i < kLanes; ++i) {
+        const float fillCov = 1.0f - smoothstep(-0.75f, 0.75f, d[i]);
+        const float strokeCov = p.strokeWidth > 0.0f
+            ? 1.0f - smoothstep(-0.75f, 0.75f, std::abs(d[i]) - p.strokeWidth * 0.5f)
+            : 0.0f;
+        const float fillA = p.fill[3] * fillCov;
+        const float strokeA = p.stroke[3] * strokeCov;
+        const float keep = 1.0f - strokeA;
+        const float ba = strokeA + fillA * keep;
+        const float inv = 1.0f / std::max(ba, 1e-6f);
+        out.r[i] = (p.stroke[0] * strokeA + p.fill[0] * fillA * keep) * inv;
+        out.g[i] = (p.stroke[1] * strokeA + p.fill[1] * fillA * keep) * inv;
+        out.b[i] = (p.stroke[2] * strokeA + p.fill[2] * fillA * keep) * inv;
+        out.a[i] = ba * p.opacity;
+        out.mask[i] = out.a[i] < 0.001f ? 0.0f : out.mask[i];
+    }
+}
+
+void shadeQuadLanes(const SoftwarePrimitive& p, const float* lx, const float* ly, LaneColor& out) {
+    switch (p.program) {
+        case ShaderProgram::SDFRect: {
+            float d[kLanes];
+            for (int i = 0; i < kLanes; ++i) {
+                const float r = lx[i] > 0.0f ? (ly[i] > 0.0f ? p.corners[2] : p.corners[1])
+                                             : (ly[i] > 0.0f ? p.corners[3] : p.corners[0]);
+                const float qx = std::abs(lx[i]) - p.halfW + r;
+                const float qy = std::abs(ly[i]) - p.halfH + r;
+                const float ox = std::max(qx, 0.0f);
+                const float oy = std::max(qy, 0.0f);
+                d[i] = std::min(std::max(qx, qy), 0.0f) + std::sqrt(ox * ox + oy * oy) - r;
+            }
+            compositeSdf(p, d, out);
+            break;
+        }
+        case ShaderProgram::SDFCircle: {
+            float d[kLanes];
+            for (int i = 0; i < kLanes; ++i) {
+                d[i] = std::sqrt(lx[i] * lx[i] + ly[i] * ly[i]) - p.halfW;
+            }
+            compositeSdf(p, d, out);
+            break;
+        }
+        case ShaderProgram::SDFLine: {
+            const float halfW = p.strokeWidth * 0.5f;
+            for (int i = 0; i < kLanes; ++i) {
+                const float cx = std::clamp(lx[i], -p.halfW, p.halfW);
+                const float dx = lx[i] - cx;
+                const float d = std::sqrt(dx * dx + ly[i] * ly[i]) - halfW;
+                out.r[i] = p.stroke[0];
+                out.g[i] = p.stroke[1];
+                out.b[i] = p.stroke[2];
+                out.a[i] = p.stroke[3] * (1.0f - smoothstep(-0.75f, 0.75f, d)) * p.opacity;
+                out.mask[i] = out.a[i] < 0.001f ? 0.0f : out.mask[i];
+            }
+            break;
+        }
+        case ShaderProgram::Glyph:
+        case ShaderProgram::Image: {
+            const float invW = p.halfW > 0.0f ? 0.5f / p.halfW : 0.0f;
+            const float invH = p.halfH > 0.0f ? 0.5f / p.halfH : 0.0f;
+            const bool glyph = p.program == ShaderProgram::Glyph;
+            for (int i = 0; i < kLanes; ++i) {
+                if (out.mask[i] == 0.0f) continue;
+                const float s = lx[i] * invW + 0.5f;
+                const float t = ly[i] * invH + 0.5f;
+                float texel[4];
+                sampleBilinear(*p.texture, p.uv[0] + (p.uv[2] - p.uv[0]) * s,
+                               p.uv[1] + (p.uv[3] - p.uv[1]) * t, texel);
+                if (glyph) {
+                    out.r[i] = p.fill[0];
+                    out.g[i] = p.fill[1];
+                    out.b[i] = p.fill[2];
+                    out.a[i] = p.fill[3] * texel[0];
+                    if (out.a[i] < 0.004f) out.mask[i] = 0.0f;
+                } else {
+                    out.r[i] = texel[0] * p.fill[0];
+                    out.g[i] = texel[1] * p.fill[1];
+                    out.b[i] = texel[2] * p.fill[2];
+                    out.a[i] = texel[3] * p.fill[3];
+                }
+            }
+            break;
+        }
+        case ShaderProgram::GlyphSDF: {
+            // glyph_sdf.frag.glsl; the distance one pixel right and down stands in for dFdx/dFdy.
+            const float invW = p.halfW > 0.0f ? 0.5f / p.halfW : 0.0f;
+            const float invH = p.halfH > 0.0f ? 0.5f / p.halfH : 0.0f;
+            auto distance = [&](float x, float y) {
+                float texel[4];
+                sampleBilinear(*p.texture, p.uv[0] + (p.uv[2] - p.uv[0]) * (x * invW + 0.5f),
+                               p.uv[1] + (p.uv[3] - p.uv[1]) * (y * invH + 0.5f), texel);
+                return texel[0];
+            };
+            for (int i = 0; i < kLanes; ++i) {
+                if (out.mask[i] == 0.0f) continue;
+                const float d = distance(lx[i], ly[i]);
+                const float dx = distance(lx[i] + p.cosA, ly[i] - p.sinA) - d;
+                const float dy = distance(lx[i] + p.sinA, ly[i] + p.cosA) - d;
+                const float halfPixel = std::max(0.5f * std::sqrt(dx * dx + dy * dy), 1e-4f);
+                out.r[i] = p.fill[0];
+                out.g[i] = p.fill[1];
+                out.b[i] = p.fill[2];
+                out.a[i] = p.fill[3] * smoothstep(0.5f - halfPixel, 0.5f + halfPixel, d);
+                if (out.a[i] < 0.004f) out.mask[i] = 0.0f;
+            }
+            break;
+        }
+        case ShaderProgram::Path:
+        case ShaderProgram::Custom:
+            break;
+    }
+}
+
+/// Fixed-function blend matching the GPU pipelines: src-alpha / one-minus-src-alpha for color,
+/// one / one-minus-src-alpha for alpha.
+inline void blendLanes(TileScratch& tile, int at, const LaneColor& c, bool blend) {
+    for (int i = 0; i < kLanes; ++i) {
+        const float m = c.mask[i];
+        const float f = blend ? c.a[i] * m : m;
+        const float keep = 1.0f - f;
+        tile.r[at + i] = c.r[i] * f + tile.r[at + i] * keep;
+        tile.g[at + i] = c.g[i] * f + tile.g[at + i] * keep;
+        tile.b[at + i] = c.b[i] * f + tile.b[at + i] * keep;
+        tile.a[at + i] = (blend ? f : c.a[i] * m) + tile.a[at + i] * keep;
+    }
+}
+
+void shadeQuad(TileScratch& tile, const SoftwarePrimitive& p,
+               int32_t ox, int32_t oy, int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+    LaneColor color{};
+    float lx[kLanes], ly[kLanes];
+    for (int32_t y = y0; y < y1; ++y) {
+        const float wy = static_cast<float>(y) + 0.5f - p.centerY;
+        for (int32_t x = x0; x < x1; x += kLanes) {
+            const int32_t n = std::min(kLanes, x1 - x);
+            for (int i = 0; i < kLanes; ++i) {
+                const float wx = static_cast<float>(x + i) + 0.5f - p.centerX;
+                lx[i] = wx * p.cosA + wy * p.sinA;
+                ly[i] = -wx * p.sinA + wy * p.cosA;
+                const bool inside = i < n && std::abs(lx[i]) <= p.padHalfW &&
+                                    std::abs(ly[i]) <= p.padHalfH;
+                color.mask[i] = inside ? 1.0f : 0.0f;
+            }
+            shadeQuadLanes(p, lx, ly, color);
+            blendLanes(tile, (y - oy) * TileScratch::kStride + (x - ox), color, p.blend);
+        }
+    }
+}
+
+inline float edge(float ax, float ay, float bx, float by, float px, float py) {
+    return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+}
+
+void shadeTriangle(TileScratch& tile, const SoftwarePrimitive& p,
+                   int32_t ox, int32_t oy, int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+    float vx[3] = {p.vx[0], p.vx[1], p.vx[2]};
+    float vy[3] = {p.vy[0], p.vy[1], p.vy[2]};
+    const float* col[3] = {p.vcolor[0], p.vcolor[1], p.vcolor[2]};
+    float area = edge(vx[0], vy[0], vx[1], vy[1], vx[2], vy[2]);
+    if (area == 0.0f || !std::isfinite(area)) return;
+    if (area < 0.0f) {
+        std::swap(vx[1], vx[2]);
+        std::swap(vy[1], vy[2]);
+        std::swap(col[1], col[2]);
+        area = -area;
+    }
+    const float invArea = 1.0f / area;
+
+    // Edge k is opposite vertex k. A shared edge is walked in opposite directions by its two
+    // triangles, so owning it by direction (top-left style) shades pixels on it exactly once.
+    bool owns[3];
+    for (int k = 0; k < 3; ++k) {
+        const int a = (k + 1) % 3;
+        const int b = (k + 2) % 3;
+        const float dx = vx[b] - vx[a];
+        const float dy = vy[b] - vy[a];
+        owns[k] = dy > 0.0f || (dy == 0.0f && dx < 0.0f);
+    }
+
+    LaneColor color{};
+    for (int32_t y = y0; y < y1; ++y) {
+        const float py = static_cast<float>(y) + 0.5f;
+        for (int32_t x = x0; x < x1; x += kLanes) {
+            const int32_t n = std::min(kLanes, x1 - x);
+            for (int i = 0; i < kLanes; ++i) {
+                const float px = static_cast<float>(x + i) + 0.5f;
+                const float e0 = edge(vx[1], vy[1], vx[2], vy[2], px, py);
+                const float e1 = edge(vx[2], vy[2], vx[0], vy[0], px, py);
+                const float e2 = edge(vx[0], vy[0], vx[1], vy[1], px, py);
+                const bool inside = i < n &&
+                    (e0 > 0.0f || (e0 == 0.0f && owns[0])) &&
+                    (e1 > 0.0f || (e1 == 0.0f && owns[1])) &&
+                    (e2 > 0.0f || (e2 == 0.0f && owns[2]));
+                const float w0 = e0 * invArea;
+                const float w1 = e1 * invArea;
+                const float w2 = 1.0f - w0 - w1;
+                color.r[i] = col[0][0] * w0 + col[1][0] * w1 + col[2][0] * w2;
+                color.g[i] = col[0][1] * w0 + col[1][1] * w1 + col[2][1] * w2;
+                color.b[i] = col[0][2] * w0 + col[1][2] * w1 + col[2][2] * w2;
+                color.a[i] = col[0][3] * w0 + col[1][3] * w1 + col[2][3] * w2;
+                color.mask[i] = inside ? 1.0f : 0.0f;
+            }
+            blendLanes(tile, (y - oy) * TileScratch::kStride + (x - ox), color, p.blend);
+        }
+    }
+}
+
+} // namespace
+
+// =============================================================================
+// SoftwareDevice
+// =============================================================================
+
+SoftwareDevice::SoftwareDevice()
+    : framebuffer_(TextureDesc{0, 0, PixelFormat::RGBA8, true})
+{
+    const unsigned hw = std::thread::hardware_concurrency();
+    const unsigned workers = hw > 1 ? std::min(hw, 8u) - 1 : 0;
+    pool_ = std::make_shared<ThreadPool>(workers);
+}
+
+SoftwareDevice::~SoftwareDevice() = default;
+
+std::unique_ptr<Buffer> SoftwareDevice::createBuffer(const BufferDesc& desc) {
+    return std::make_unique<SoftwareBuffer>(desc);
+}
+
+std::unique_ptr<Texture> SoftwareDevice::createTexture(const TextureDesc& desc) {
+    return std::make_unique<SoftwareTexture>(desc);
+}
+
+std::unique_ptr<RenderPipeline> SoftwareDevice::createRenderPipeline(const RenderPipelineDesc& desc) {
+    return std::make_unique<SoftwareRenderPipeline>(desc);
+}
+
+bool SoftwareDevice::beginFrame() {
+    return framebuffer_.width() > 0 && framebuffer_.height() > 0;
+}
+
+RenderPassEncoder* SoftwareDevice::beginRenderPass(const RenderPassDesc& desc) {
+    target_ = desc.colorTarget ? static_cast<SoftwareTexture*>(desc.colorTarget) : &framebuffer_;
+    if (target_->width() == 0 || target_->height() == 0 ||
+        bytesPerPixel(target_->format()) != 4 || target_->format() == PixelFormat::Depth32F) {
+        target_ = nullptr;
+        return nullptr;
+    }
+    pass_ = desc;
+    primitives_.clear();
+    currentEncoder_ = std::make_unique<SoftwareRenderPassEncoder>(
+        primitives_, target_->width(), target_->height());
+    return currentEncoder_.get();
+}
+
+void SoftwareDevice::endRenderPass() {
+    if (!target_) return;
+    tilesX_ = (target_->width() + kTileSize - 1) / kTileSize;
+    tilesY_ = (target_->height() + kTileSize - 1) / kTileSize;
+    binPrimitives();
+    runTiles(tilesX_ * tilesY_);
+    if (target_ == &framebuffer_) framebufferDrawn_ = true;
+    currentEncoder_.reset();
+    target_ = nullptr;
+}
+
+void SoftwareDevice::endFrame() {}
+
+void SoftwareDevice::resize(uint32_t width, uint32_t height) {
+    if (width == framebuffer_.width() && height == framebuffer_.height()) return;
+    framebuffer_.resize(width, height);
+    framebufferDrawn_ = false;
+}
+
+PixelFormat SoftwareDevice::swapchainFormat() const {
+    return PixelFormat::RGBA8;
+}
+
+bool SoftwareDevice::readPixels(int x, int y, int w, int h, std::vector<uint8_t>& out) {
+    const int tw = static_cast<int>(framebuffer_.width());
+    const int th = static_cast<int>(framebuffer_.height());
+    const int rx = std::max(x, 0);
+    const int ry = std::max(y, 0);
+    if (w <= 0 || h <= 0 || rx >= tw || ry >= th) return false;
+    const int rw = std::min(w, tw - rx);
+    const int rh = std::min(h, th - ry);
+
+    out.resize(static_cast<size_t>(rw) * rh * 4);
+    for (int row = 0; row < rh; ++row) {
+        std::memcpy(out.data() + static_cast<size_t>(row) * rw * 4,
+                    framebuffer_.texels() + (static_cast<size_t>(ry + row) * tw + rx) * 4,
+                    static_cast<size_t>(rw) * 4);
+    }
+    return true;
+}
+
+void SoftwareDevice::binPrimitives() {
+    const size_t tileCount = static_cast<size_t>(tilesX_) * tilesY_;
+    if (tileBins_.size() < tileCount) tileBins_.resize(tileCount);
+    for (size_t t = 0; t < tileCount; ++t) tileBins_[t].clear();
+
+    for (uint32_t i = 0; i < primitives_.size(); ++i) {
+        const auto& p = primitives_[i];
+        const int32_t tx0 = p.x0 / kTileSize;
+        const int32_t ty0 = p.y0 / kTileSize;
+        const int32_t tx1 = (p.x1 - 1) / kTileSize;
+        const int32_t ty1 = (p.y1 - 1) / kTileSize;
+        for (int32_t ty = ty0; ty <= ty1; ++ty) {
+            for (int32_t tx = tx0; tx <= tx1; ++tx) {
+                tileBins_[static_cast<size_t>(ty) * tilesX_ + tx].push_back(i);
+            }
+        }
+    }
+}
+
+void SoftwareDevice::rasterizeTile(uint32_t tileIndex) {
+    // A loaded tile nothing draws into keeps its pixels as they are.
+    if (pass_.loadAction == LoadAction::Load && tileBins_[tileIndex].empty()) return;
+
+    static_assert(TileScratch::kStride == kTileSize);
+    thread_local std::unique_ptr<TileScratch> scratch;
+    if (!scratch) scratch = std::make_unique<TileScratch>();
+    TileScratch& tile = *scratch;
+
+    const int32_t fbW = static_cast<int32_t>(target_->width());
+    const int32_t fbH = static_cast<int32_t>(target_->height());
+    const int32_t ox = static_cast<int32_t>(tileIndex % tilesX_) * kTileSize;
+    const int32_t oy = static_cast<int32_t>(tileIndex / tilesX_) * kTileSize;
+    const int32_t tw = std::min(kTileSize, fbW - ox);
+    const int32_t th = std::min(kTileSize, fbH - oy);
+    const bool bgra = target_->format() == PixelFormat::BGRA8;
+    const int ri = bgra ? 2 : 0;
+    const int bi = bgra ? 0 : 2;
+    uint8_t* pixels = target_->texels();
+
+    if (pass_.loadAction == LoadAction::Load) {
+        constexpr float k = 1.0f / 255.0f;
+        for (int32_t y = 0; y < th; ++y) {
+            const uint8_t* src = pixels + (static_cast<size_t>(oy + y) * fbW + ox) * 4;
+            float* r = tile.r + y * kTileSize;
+            float* g = tile.g + y * kTileSize;
+            float* b = tile.b + y * kTileSize;
+            float* a = tile.a + y * kTileSize;
+            for (int32_t x = 0; x < tw; ++x) {
+                r[x] = src[x * 4 + ri] * k;
+                g[x] = src[x * 4 + 1] * k;
+                b[x] = src[x * 4 + bi] * k;
+                a[x] = src[x * 4 + 3] * k;
+            }
+        }
+    } else {
+        std::fill(tile.r, tile.r + TileScratch::kSize, pass_.clearColor.r);
+        std::fill(tile.g, tile.g + TileScratch::kSize, pass_.clearColor.g);
+        std::fill(tile.b, tile.b + TileScratch::kSize, pass_.clearColor.b);
+        std::fill(tile.a, tile.a + TileScratch::kSize, pass_.clearColor.a);
+    }
+
+    for (uint32_t index : tileBins_[tileIndex]) {
+        const SoftwarePrimitive& p = primitives_[index];
+        const int32_t x0 = std::max(p.x0, ox);
+        const int32_t y0 = std::max(p.y0, oy);
+        const int32_t x1 = std::min(p.x1, ox + tw);
+        const int32_t y1 = std::min(p.y1, oy + th);
+        if (x0 >= x1 || y0 >= y1) continue;
+        if (p.program == ShaderProgram::Path) {
+            shadeTriangle(tile, p, ox, oy, x0, y0, x1, y1);
+        } else {
+            shadeQuad(tile, p, ox, oy, x0, y0, x1, y1);
+        }
+    }
+
+    auto toByte = [](float v) {
+        return static_cast<uint8_t>(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+    };
+    for (int32_t y = 0; y < th; ++y) {
+        uint8_t* dst = pixels + (static_cast<size_t>(oy + y) * fbW + ox) * 4;
+        const float* r = tile.r + y * kTileSize;
+        const float* g = tile.g + y * kTileSize;
+        const float* b = tile.b + y * kTileSize;
+        const float* a = tile.a + y * kTileSize;
+        for (int32_t x = 0; x < tw; ++x) {
+            dst[x * 4 + ri] = toByte(r[x]);
+            dst[x * 4 + 1] = toByte(g[x]);
+            dst[x * 4 + bi] = toByte(b[x]);
+            dst[x * 4 + 3] = toByte(a[x]);
+        }
+    }
+}
+
+void SoftwareDevice::runTiles(uint32_t tileCount) {
+    pool_->parallelFor(tileCount, [this](size_t tile, size_t) {
+        rasterizeTile(static_cast<uint32_t>(tile));
+    });
+}
+
+std::unique_ptr<Device> createSoftwareDevice() {
+    return std::make_unique<SoftwareDevice>();
+}
+
+} // namespace flux::gpu
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <Flux/GPU/Device.hpp>
+#include <Flux/Core/ThreadPool.hpp>
+#include <memory>
+#include <vector>
+
+namespace flux::gpu {
+
+class SoftwareBuffer : public Buffer {
+public:
+    explicit SoftwareBuffer(const BufferDesc& desc);
+    void write(const void* data, size_t size, size_t offset = 0) override;
+    size_t size() const override;
+    void* mappedData() override { return data_.data(); }
+    const uint8_t* data() const { return data_.data(); }
+
+private:
+    std::vector<uint8_t> data_;
+};
+
+class SoftwareTexture : public Texture {
+public:
+    explicit SoftwareTexture(const TextureDesc& desc);
+    void write(const void* data, uint32_t x, uint32_t y, uint32_t w, uint32_t h,
+               uint32_t srcBytesPerRow) override;
+    uint32_t width() const override;
+    uint32_t height() const override;
+    PixelFormat format() const { return format_; }
+
+    uint8_t* texels() { return texels_.data(); }
+    const uint8_t* texels() const { return texels_.data(); }
+    void resize(uint32_t width, uint32_t height);
+
+private:
+    std::vector<uint8_t> texels_;
+    uint32_t width_;
+    uint32_t height_;
+    PixelFormat format_;
+};
+
+class SoftwareRenderPipeline : public RenderPipeline {
+public:
+    explicit SoftwareRenderPipeline(const RenderPipelineDesc& desc);
+    ShaderProgram program() const { return program_; }
+    bool blendEnabled() const { return blendEnabled_; }
+    /// Stride of the last vertex buffer layout (instance data for quads, vertices for paths).
+    uint32_t stride() const { return stride_; }
+
+private:
+    ShaderProgram program_;
+    bool blendEnabled_;
+    uint32_t stride_ = 0;
+};
+
+/// One instance (or path triangle) decoded at `draw()` time. Instance data is copied out of the
+/// bound buffer immediately because the backend may rewrite a buffer between draws of one pass.
+struct SoftwarePrimitive {
+    ShaderProgram program = ShaderProgram::Custom;
+    bool blend = true;
+    int32_t x0 = 0, y0 = 0, x1 = 0, y1 = 0;  // clipped pixel bounds, half-open
+
+    // Quad programs: screen→local transform and extents (SDF half size is unpadded).
+    float centerX = 0, centerY = 0;
+    float cosA = 1, sinA = 0;
+    float halfW = 0, halfH = 0;
+    float padHalfW = 0, padHalfH = 0;
+    float corners[4] = {};
+    float fill[4] = {};
+    float stroke[4] = {};
+    float strokeWidth = 0, opacity = 1;
+    float uv[4] = {};
+    const SoftwareTexture* texture = nullptr;
+
+    // Path: one triangle, colors interpolated like the varying in path.frag.glsl.
+    float vx[3] = {}, vy[3] = {};
+    float vcolor[3][4] = {};
+};
+
+class SoftwareRenderPassEncoder : public RenderPassEncoder {
+public:
+    SoftwareRenderPassEncoder(std::vector<SoftwarePrimitive>& out, uint32_t width, uint32_t height);
+    void setPipeline(RenderPipeline* pipeline) override;
+    void setVertexBuffer(uint32_t slot, Buffer* buffer, size_t offset = 0) override;
+    void setIndexBuffer(Buffer* buffer) override;
+    void setFragmentTexture(uint32_t slot, Texture* texture) override;
+    void setScissorRect(uint32_t x, uint32_t y, uint32_t w, uint32_t h) override;
+    void draw(uint32_t vertexCount, uint32_t instanceCount = 1,
+              uint32_t firstVertex = 0, uint32_t firstInstance = 0) override;
+    void drawIndexed(uint32_t indexCount, uint32_t instanceCount = 1,
+                     uint32_t firstIndex = 0, uint32_t firstInstance = 0) override;
+    void end() override;
+
+private:
+    static constexpr uint32_t kMaxVertexBuffers = 2;
+
+    bool clip(SoftwarePrimitive& prim, float minX, float minY, float maxX, float maxY) const;
+    void emitQuad(SoftwarePrimitive& prim, float x, float y, float w, float h, float rotation);
+
+    std::vector<SoftwarePrimitive>& out_;
+    uint32_t width_, height_;
+    SoftwareRenderPipeline* pipeline_ = nullptr;
+    const SoftwareBuffer* vertexBuffers_[kMaxVertexBuffers] = {};
+    size_t vertexOffsets_[kMaxVertexBuffers] = {};
+    const SoftwareTexture* texture_ = nullptr;
+    int32_t scissor_[4] = {};
+};
+
+/**
+ * CPU rasterizer for machines without a GPU (build agents, render farms, headless UI tests).
+ * Draws are decoded into primitives during the pass and binned into 64×64 tiles at
+ * `endRenderPass`; tiles are shaded in parallel on a small worker pool, with fixed-width lane
+ * loops over planar float tile storage so the compiler can vectorize the SDF and blend math.
+ * Shading mirrors the GLSL in `shaders/` for the programs named by `ShaderProgram`.
+ */
+class SoftwareDevice : public Device {
+public:
+    SoftwareDevice();
+    ~SoftwareDevice() override;
+
+    std::unique_ptr<Buffer> createBuffer(const BufferDesc& desc) override;
+    std::unique_ptr<Texture> createTexture(const TextureDesc& desc) override;
+    std::unique_ptr<RenderPipeline> createRenderPipeline(const RenderPipelineDesc& desc) override;
+
+    bool beginFrame() override;
+    RenderPassEncoder* beginRenderPass(const RenderPassDesc& desc) override;
+    void endRenderPass() override;
+    void endFrame() override;
+
+    /// The framebuffer is never swapped: once drawn it holds the previous frame.
+    uint32_t bufferAge() const override { return framebufferDrawn_ ? 1 : 0; }
+
+    void resize(uint32_t width, uint32_t height) override;
+    PixelFormat swapchainFormat() const override;
+
+    bool readPixels(int x, int y, int w, int h, std::vector<uint8_t>& out) override;
+    std::shared_ptr<ThreadPool> workerPool() const override { return pool_; }
+
+private:
+    static constexpr int32_t kTileSize = 64;
+
+    void binPrimitives();
+    void rasterizeTile(uint32_t tileIndex);
+    void runTiles(uint32_t tileCount);
+
+    SoftwareTexture framebuffer_;
+    bool framebufferDrawn_ = false;
+    SoftwareTexture* target_ = nullptr;
+    RenderPassDesc pass_;
+    std::unique_ptr<SoftwareRenderPassEncoder> currentEncoder_;
+    std::vector<SoftwarePrimitive> primitives_;
+    std::vector<std::vector<uint32_t>> tileBins_;
+    uint32_t tilesX_ = 0;
+    uint32_t tilesY_ = 0;
+
+    std::shared_ptr<ThreadPool> pool_;
+};
+
+} // namespace flux::gpu
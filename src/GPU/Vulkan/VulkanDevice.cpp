@@ -34,8 +34,10 @@ VulkanBuffer::VulkanBuffer(VmaAllocator allocator, const BufferDesc& desc)
     ai.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
                VMA_ALLOCATION_CREATE_MAPPED_BIT;
 
-    vkCheck(vmaCreateBuffer(allocator_, &ci, &ai, &buffer_, &allocation_, nullptr),
+    VmaAllocationInfo info{};
+    vkCheck(vmaCreateBuffer(allocator_, &ci, &ai, &buffer_, &allocation_, &info),
             "Failed to create Vulkan buffer");
+    mapped_ = info.pMappedData;
 }
 
 VulkanBuffer::~VulkanBuffer() {
@@ -43,10 +45,20 @@ VulkanBuffer::~VulkanBuffer() {
 }
 
 void VulkanBuffer::write(const void* data, size_t size, size_t offset) {
-    void* mapped = nullptr;
-    vmaMapMemory(allocator_, allocation_, &mapped);
-    std::memcpy(static_cast<uint8_t*>(mapped) + offset, data, size);
-    vmaUnmapMemory(allocator_, allocation_);
+    if (!mapped_) {
+        void* mapped = nullptr;
+        vmaMapMemory(allocator_, allocation_, &mapped);
+        std::memcpy(static_cast<uint8_t*>(mapped) + offset, data, size);
+        vmaUnmapMemory(allocator_, allocation_);
+        return;
+    }
+    std::memcpy(static_cast<uint8_t*>(mapped_) + offset, data, size);
+    flushMapped(offset, size);
+}
+
+void VulkanBuffer::flushMapped(size_t offset, size_t size) {
+    // No-op on host-coherent memory.
+    vmaFlushAllocation(allocator_, allocation_, offset, size);
 }
 
 size_t VulkanBuffer::size() const { return size_; }
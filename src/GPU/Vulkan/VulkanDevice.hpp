@@ -17,12 +17,15 @@ public:
     ~VulkanBuffer() override;
     void write(const void* data, size_t size, size_t offset = 0) override;
     size_t size() const override;
+    void* mappedData() override { return mapped_; }
+    void flushMapped(size_t offset, size_t size) override;
     VkBuffer native() const { return buffer_; }
 
 private:
     VmaAllocator allocator_;
     VkBuffer buffer_ = VK_NULL_HANDLE;
     VmaAllocation allocation_ = VK_NULL_HANDLE;
+    void* mapped_ = nullptr; // persistently mapped (VMA_ALLOCATION_CREATE_MAPPED_BIT)
     size_t size_;
 };
 
@@ -98,6 +101,7 @@ public:
     void endRenderPass() override;
     void endFrame() override;
 
+    uint32_t currentFrameIndex() const override { return currentFrame_; }
     void resize(uint32_t width, uint32_t height) override;
     PixelFormat swapchainFormat() const override;
 
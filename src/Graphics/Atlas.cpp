@@ -1,5 +1,6 @@
 #include <Flux/Graphics/Atlas.hpp>
 #include <algorithm>
+#include <cstring>
 #include <stdexcept>
 
 namespace flux {
@@ -10,6 +11,7 @@ Atlas::Atlas(gpu::Device* device, const AtlasDesc& desc)
     , pageHeight_(desc.pageHeight)
     , maxPages_(desc.maxPages)
     , format_(desc.format)
+    , packing_(desc.packing)
     , bpp_(gpu::bytesPerPixel(desc.format))
 {
     if (desc.format == gpu::PixelFormat::Depth32F) {
@@ -30,6 +32,7 @@ uint8_t Atlas::addPage() {
     td.height = pageHeight_;
     td.format = format_;
     page.texture = device_->createTexture(td);
+    resetPacking(page);
     auto idx = static_cast<uint8_t>(pages_.size());
     pages_.push_back(std::move(page));
     return idx;
@@ -45,27 +48,113 @@ uint8_t* Atlas::rowData(uint8_t pageIndex, uint32_t row) {
     return pages_[pageIndex].data.data() + static_cast<size_t>(row) * rowStrideBytes_;
 }
 
-std::optional<Atlas::AllocResult> Atlas::allocate(uint32_t w, uint32_t h, uint32_t pad) {
-    if (w == 0 || h == 0) return std::nullopt;
+void Atlas::resetPacking(Page& page) const {
+    page.cursorX = 0;
+    page.cursorY = 0;
+    page.rowHeight = 0;
+    page.skyline.clear();
+    if (packing_ == AtlasPacking::Skyline) page.skyline.push_back({0, 0, pageWidth_});
+}
 
-    uint8_t pageIdx = static_cast<uint8_t>(pages_.size() - 1);
-    Page* page = &pages_[pageIdx];
+std::optional<Atlas::Position> Atlas::placeOnShelf(Page& page, uint32_t w, uint32_t h) const {
+    if (page.cursorX + w > pageWidth_) {
+        page.cursorX = 0;
+        page.cursorY += page.rowHeight;
+        page.rowHeight = 0;
+    }
+    if (page.cursorY + h > pageHeight_) return std::nullopt;
+    const Position pos{page.cursorX, page.cursorY};
+    page.cursorX += w;
+    page.rowHeight = std::max(page.rowHeight, h);
+    return pos;
+}
 
-    if (page->cursorX + w + pad > pageWidth_) {
-        page->cursorX = 0;
-        page->cursorY += page->rowHeight + pad;
-        page->rowHeight = 0;
+std::optional<Atlas::Position> Atlas::placeOnSkyline(Page& page, uint32_t w, uint32_t h) const {
+    auto& sky = page.skyline;
+    size_t best = sky.size();
+    uint32_t bestY = 0;
+    uint32_t bestTop = UINT32_MAX;
+    uint32_t bestWidth = UINT32_MAX;
+    for (size_t i = 0; i < sky.size(); ++i) {
+        if (sky[i].x + w > pageWidth_) break;
+        // Resting on the highest span it covers.
+        uint32_t y = 0;
+        for (size_t j = i, covered = 0; covered < w; ++j) {
+            y = std::max(y, sky[j].y);
+            covered += sky[j].width;
+        }
+        if (y + h > pageHeight_) continue;
+        // Lowest top edge first; on a tie the narrower span leaves less beside it.
+        if (y + h < bestTop || (y + h == bestTop && sky[i].width < bestWidth)) {
+            best = i;
+            bestY = y;
+            bestTop = y + h;
+            bestWidth = sky[i].width;
+        }
     }
-    if (page->cursorY + h + pad > pageHeight_) {
-        if (pages_.size() >= maxPages_) return std::nullopt;
-        pageIdx = addPage();
-        page = &pages_[pageIdx];
+    if (best == sky.size()) return std::nullopt;
+
+    // The new span replaces those it covers and trims the one it ends in.
+    const uint32_t x = sky[best].x;
+    const uint32_t end = x + w;
+    size_t last = best;
+    while (last < sky.size() && sky[last].x + sky[last].width <= end) ++last;
+    if (last < sky.size() && sky[last].x < end) {
+        sky[last].width -= end - sky[last].x;
+        sky[last].x = end;
     }
+    sky.erase(sky.begin() + static_cast<std::ptrdiff_t>(best),
+              sky.begin() + static_cast<std::ptrdiff_t>(last));
+    sky.insert(sky.begin() + static_cast<std::ptrdiff_t>(best), SkylineSpan{x, bestTop, w});
+    for (size_t i = best > 0 ? best - 1 : 0; i + 1 < sky.size() && i <= best + 1;) {
+        if (sky[i].y == sky[i + 1].y) {
+            sky[i].width += sky[i + 1].width;
+            sky.erase(sky.begin() + static_cast<std::ptrdiff_t>(i) + 1);
+        } else {
+            ++i;
+        }
+    }
+    return Position{x, bestY};
+}
 
-    const uint32_t ox = page->cursorX;
-    const uint32_t oy = page->cursorY;
+std::optional<Atlas::AllocResult> Atlas::allocate(uint32_t w, uint32_t h, uint32_t pad) {
+    if (w == 0 || h == 0) return std::nullopt;
+    if (w + pad > pageWidth_ || h + pad > pageHeight_) return std::nullopt;
+
+    // Each rectangle reserves its padding to the right and below.
+    auto place = [&](Page& p) {
+        return packing_ == AtlasPacking::Skyline ? placeOnSkyline(p, w + pad, h + pad)
+                                                 : placeOnShelf(p, w + pad, h + pad);
+    };
+
+    uint8_t pageIdx = fillPage_;
+    auto pos = place(pages_[pageIdx]);
+    if (!pos) {
+        if (!releasedPages_.empty()) {
+            pageIdx = releasedPages_.front();
+            releasedPages_.erase(releasedPages_.begin());
+        } else {
+            if (pages_.size() >= maxPages_) return std::nullopt;
+            pageIdx = addPage();
+        }
+        fillPage_ = pageIdx;
+        pos = place(pages_[pageIdx]);
+        if (!pos) return std::nullopt;
+    }
 
-    expandDirtyRect(pageIdx, ox, oy, w, h);
+    const auto [ox, oy] = *pos;
+
+    // A released page still holds old glyphs around the rectangle; clear the padding on every
+    // side so filtering at the edges reads zeros, and upload it with the rectangle.
+    const uint32_t px0 = ox >= pad ? ox - pad : 0;
+    const uint32_t py0 = oy >= pad ? oy - pad : 0;
+    const uint32_t px1 = std::min(ox + w + pad, pageWidth_);
+    const uint32_t py1 = std::min(oy + h + pad, pageHeight_);
+    for (uint32_t row = py0; row < py1; ++row) {
+        std::memset(rowData(pageIdx, row) + static_cast<size_t>(px0) * bpp_, 0,
+                    static_cast<size_t>(px1 - px0) * bpp_);
+    }
+    expandDirtyRect(pageIdx, px0, py0, px1 - px0, py1 - py0);
 
     const float invW = 1.0f / static_cast<float>(pageWidth_);
     const float invH = 1.0f / static_cast<float>(pageHeight_);
@@ -78,13 +167,18 @@ std::optional<Atlas::AllocResult> Atlas::allocate(uint32_t w, uint32_t h, uint32
     out.v0 = static_cast<float>(oy) * invH;
     out.u1 = static_cast<float>(ox + w) * invW;
     out.v1 = static_cast<float>(oy + h) * invH;
-
-    page->cursorX += w + pad;
-    page->rowHeight = std::max(page->rowHeight, h);
-
     return out;
 }
 
+void Atlas::releasePage(uint8_t pageIndex) {
+    if (pageIndex >= pages_.size()) return;
+    resetPacking(pages_[pageIndex]);
+    if (pageIndex != fillPage_ &&
+        std::find(releasedPages_.begin(), releasedPages_.end(), pageIndex) == releasedPages_.end()) {
+        releasedPages_.push_back(pageIndex);
+    }
+}
+
 bool Atlas::dirty() const {
     for (const auto& p : pages_) {
         if (p.dirty) return true;
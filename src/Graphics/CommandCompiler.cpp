@@ -1,9 +1,11 @@
 #include <Flux/Graphics/CommandCompiler.hpp>
+#include <Flux/Core/ThreadPool.hpp>
 #include <tesselator.h>
 #include <cstring>
 #include <cmath>
 #include <algorithm>
 #include <optional>
+#include <type_traits>
 
 namespace flux {
 
@@ -87,66 +89,281 @@ CommandCompiler::StateFingerprint CommandCompiler::computeStateFingerprint() con
     StateFingerprint fp;
     fp.m00 = quantizeAffine(current_.m00);
     fp.m01 = quantizeAffine(current_.m01);
-    fp.m02 = quantizeAffine(current_.m02);
     fp.m10 = quantizeAffine(current_.m10);
     fp.m11 = quantizeAffine(current_.m11);
-    fp.m12 = quantizeAffine(current_.m12);
     fp.qOpacity = quantizeAffine(current_.opacity);
     fp.scissor = current_.scissor;
     return fp;
 }
 
-void CommandCompiler::spliceCacheEntry(const CachedElementData& entry, CompiledBatches& out) {
-    auto& g = out.groups.back();
-    uint32_t pathVertBase = static_cast<uint32_t>(out.pathVertices.size()) - g.pathOffset;
+static ScissorState intersectScissor(const ScissorState& a, const ScissorState& b) {
+    if (!a.active) return b;
+    if (!b.active) return a;
+    float x1 = std::max(a.x, b.x);
+    float y1 = std::max(a.y, b.y);
+    float x2 = std::min(a.x + a.width, b.x + b.width);
+    float y2 = std::min(a.y + a.height, b.y + b.height);
+    return {true, x1, y1, std::max(0.0f, x2 - x1), std::max(0.0f, y2 - y1)};
+}
 
-    for (auto& op : entry.drawOps) {
-        DrawOp adjusted = op;
-        switch (op.type) {
-            case DrawOpType::Rect:   adjusted.offset += g.rectCount; break;
-            case DrawOpType::Circle: adjusted.offset += g.circleCount; break;
-            case DrawOpType::Line:   adjusted.offset += g.lineCount; break;
-            case DrawOpType::Glyph:  adjusted.offset += g.glyphCount; break;
-            case DrawOpType::Path:   adjusted.offset += pathVertBase; break;
-            case DrawOpType::Image:  adjusted.offset += static_cast<uint32_t>(g.imageDraws.size()); break;
+void CommandCompiler::replayCacheEntry(const CachedElementData& entry, CompiledBatches& out,
+                                       float x, float y, const ScissorState& entryScissor) {
+    entry.lastAccessFrame = compileFrame_;
+    const float dx = x - entry.originX;
+    const float dy = y - entry.originY;
+    const bool moved = dx != 0 || dy != 0;
+    // Compiled scissors hold while the element sits where, and under what, it was compiled.
+    const bool inPlace = !moved && entryScissor == entry.fingerprint.scissor;
+    ScissorState scissor = entryScissor;
+    size_t rect = 0, circle = 0, line = 0, glyph = 0, pathVert = 0, image = 0, opIndex = 0;
+    for (const auto& piece : entry.pieces) {
+        if (piece.child) {
+            replayCacheEntry(*piece.child, out, x + piece.offsetX, y + piece.offsetY, scissor);
+            continue;
+        }
+        if (piece.startsGroup) {
+            if (inPlace) {
+                scissor = piece.scissor;
+            } else if (piece.clip.active) {
+                ScissorState clip = piece.clip;
+                clip.x += dx;
+                clip.y += dy;
+                scissor = intersectScissor(entryScissor, clip);
+            } else {
+                scissor = entryScissor;
+            }
+            openGroup(out, scissor);
+        }
+
+        auto& g = out.groups.back();
+        const uint32_t pathVertBase = static_cast<uint32_t>(out.pathVertices.size()) - g.pathOffset;
+        const size_t rectStart = out.rects.size(), circleStart = out.circles.size();
+        const size_t lineStart = out.lines.size(), glyphStart = out.glyphs.size();
+        const size_t pathStart = out.pathVertices.size(), imageStart = g.imageDraws.size();
+        const size_t opStart = g.drawOps.size();
+
+        for (; opIndex < piece.opEnd; ++opIndex) {
+            DrawOp adjusted = entry.drawOps[opIndex];
+            switch (adjusted.type) {
+                case DrawOpType::Rect:   adjusted.offset += g.rectCount; break;
+                case DrawOpType::Circle: adjusted.offset += g.circleCount; break;
+                case DrawOpType::Line:   adjusted.offset += g.lineCount; break;
+                case DrawOpType::Glyph:  adjusted.offset += g.glyphCount; break;
+                case DrawOpType::Path:   adjusted.offset += pathVertBase; break;
+                case DrawOpType::Image:  adjusted.offset += static_cast<uint32_t>(g.imageDraws.size()); break;
+            }
+            g.drawOps.push_back(adjusted);
+        }
+
+        auto append = [](auto& dst, const auto& src, size_t& from, uint32_t to) {
+            dst.insert(dst.end(), src.begin() + static_cast<ptrdiff_t>(from),
+                       src.begin() + static_cast<ptrdiff_t>(to));
+            const auto n = static_cast<uint32_t>(to - from);
+            from = to;
+            return n;
+        };
+        g.rectCount += append(out.rects, entry.rects, rect, piece.rectEnd);
+        g.circleCount += append(out.circles, entry.circles, circle, piece.circleEnd);
+        g.lineCount += append(out.lines, entry.lines, line, piece.lineEnd);
+        g.glyphCount += append(out.glyphs, entry.glyphs, glyph, piece.glyphEnd);
+        g.pathCount += append(out.pathVertices, entry.pathVerts, pathVert, piece.pathEnd);
+        append(g.imageDraws, entry.imageDraws, image, piece.imageEnd);
+
+        if (!moved) continue;
+        // Everything the compiler emits is positioned by its first two coordinates (quad
+        // min corner or vertex); sizes, rotations and colors do not depend on translation.
+        auto shift = [&](auto& items, size_t start, auto position) {
+            for (size_t i = start; i < items.size(); ++i) {
+                float* p = position(items[i]);
+                p[0] += dx;
+                p[1] += dy;
+            }
+        };
+        shift(out.rects, rectStart, [](SDFQuadInstance& q) { return q.rect; });
+        shift(out.circles, circleStart, [](SDFQuadInstance& q) { return q.rect; });
+        shift(out.lines, lineStart, [](SDFQuadInstance& q) { return q.rect; });
+        shift(out.glyphs, glyphStart, [](GlyphInstance& q) { return q.screenRect; });
+        shift(out.pathVertices, pathStart, [](PathVertex& v) { return &v.x; });
+        shift(g.imageDraws, imageStart, [](ImageDrawCmd& d) { return d.instance.screenRect; });
+        for (size_t i = opStart; i < g.drawOps.size(); ++i) {
+            g.drawOps[i].bounds.x += dx;
+            g.drawOps[i].bounds.y += dy;
         }
-        g.drawOps.push_back(adjusted);
     }
+}
 
-    out.rects.insert(out.rects.end(), entry.rects.begin(), entry.rects.end());
-    g.rectCount += static_cast<uint32_t>(entry.rects.size());
+void CommandCompiler::beginRun(ElementTrack& t, const CompiledBatches& out) {
+    const auto& g = out.groups.back();
+    t.rectStart = out.rects.size();
+    t.circleStart = out.circles.size();
+    t.lineStart = out.lines.size();
+    t.glyphStart = out.glyphs.size();
+    t.pathStart = out.pathVertices.size();
+    t.imageStart = g.imageDraws.size();
+    t.drawOpStart = g.drawOps.size();
+    t.runStartsGroup = false;
+}
 
-    out.circles.insert(out.circles.end(), entry.circles.begin(), entry.circles.end());
-    g.circleCount += static_cast<uint32_t>(entry.circles.size());
+// Copies the element's own output since the run began into its entry; the run lies in
+// the last group, which it started if runStartsGroup.
+void CommandCompiler::endRun(ElementTrack& t, CompiledBatches& out) {
+    const auto& g = out.groups.back();
+    if (!t.runStartsGroup && g.drawOps.size() == t.drawOpStart && out.rects.size() == t.rectStart &&
+        out.circles.size() == t.circleStart && out.lines.size() == t.lineStart &&
+        out.glyphs.size() == t.glyphStart && out.pathVertices.size() == t.pathStart) {
+        return;
+    }
+    CachedElementData& entry = *t.entry;
+    auto copy = [](auto& dst, const auto& src, size_t from) {
+        dst.insert(dst.end(), src.begin() + static_cast<ptrdiff_t>(from), src.end());
+        return static_cast<uint32_t>(dst.size());
+    };
 
-    out.lines.insert(out.lines.end(), entry.lines.begin(), entry.lines.end());
-    g.lineCount += static_cast<uint32_t>(entry.lines.size());
+    CachedElementData::Piece piece;
+    piece.startsGroup = t.runStartsGroup;
+    piece.scissor = t.runScissor;
+    piece.clip = t.runClip;
+    piece.rectEnd = copy(entry.rects, out.rects, t.rectStart);
+    piece.circleEnd = copy(entry.circles, out.circles, t.circleStart);
+    piece.lineEnd = copy(entry.lines, out.lines, t.lineStart);
+    piece.glyphEnd = copy(entry.glyphs, out.glyphs, t.glyphStart);
+    piece.pathEnd = copy(entry.pathVerts, out.pathVertices, t.pathStart);
+    piece.imageEnd = copy(entry.imageDraws, g.imageDraws, t.imageStart);
+    cacheStats_.storedInstances += (out.rects.size() - t.rectStart) + (out.circles.size() - t.circleStart) +
+                                   (out.lines.size() - t.lineStart) + (out.glyphs.size() - t.glyphStart) +
+                                   (g.imageDraws.size() - t.imageStart);
+
+    // Group-local positions where the run starts
+    const auto rectBase = static_cast<uint32_t>(t.rectStart) - g.rectOffset;
+    const auto circleBase = static_cast<uint32_t>(t.circleStart) - g.circleOffset;
+    const auto lineBase = static_cast<uint32_t>(t.lineStart) - g.lineOffset;
+    const auto glyphBase = static_cast<uint32_t>(t.glyphStart) - g.glyphOffset;
+    const auto pathBase = static_cast<uint32_t>(t.pathStart) - g.pathOffset;
+    for (size_t i = t.drawOpStart; i < g.drawOps.size(); ++i) {
+        DrawOp dop = g.drawOps[i];
+        switch (dop.type) {
+            case DrawOpType::Rect:   dop.offset -= rectBase; break;
+            case DrawOpType::Circle: dop.offset -= circleBase; break;
+            case DrawOpType::Line:   dop.offset -= lineBase; break;
+            case DrawOpType::Glyph:  dop.offset -= glyphBase; break;
+            case DrawOpType::Path:   dop.offset -= pathBase; break;
+            case DrawOpType::Image:  dop.offset -= static_cast<uint32_t>(t.imageStart); break;
+        }
+        entry.drawOps.push_back(dop);
+    }
+    piece.opEnd = static_cast<uint32_t>(entry.drawOps.size());
+    entry.pieces.push_back(piece);
+    beginRun(t, out);
+}
 
-    out.glyphs.insert(out.glyphs.end(), entry.glyphs.begin(), entry.glyphs.end());
-    g.glyphCount += static_cast<uint32_t>(entry.glyphs.size());
+// Records a child's output, placed at translation (x, y), in the enclosing element's
+// entry by reference.
+void CommandCompiler::addChildPiece(std::shared_ptr<const CachedElementData> child, float x, float y,
+                                    CompiledBatches& out) {
+    if (elementTrackStack_.empty()) return;
+    auto& t = elementTrackStack_.back();
+    if (child) {
+        CachedElementData::Piece piece;
+        piece.offsetX = x - t.entry->originX;
+        piece.offsetY = y - t.entry->originY;
+        piece.child = std::move(child);
+        t.entry->pieces.push_back(std::move(piece));
+    } else {
+        t.cacheable = false;
+    }
+    beginRun(t, out);
+}
 
-    out.pathVertices.insert(out.pathVertices.end(), entry.pathVerts.begin(), entry.pathVerts.end());
-    g.pathCount += static_cast<uint32_t>(entry.pathVerts.size());
+void CommandCompiler::storeCacheEntry(ElementTrack& t) {
+    // A subtree that leaves the clip state different from how it found it cannot be
+    // replayed by skipping it; drop any older entry so it recompiles.
+    if (!t.cacheable || current_.clipNode != t.clipNode || current_.scissor != t.entry->fingerprint.scissor) {
+        elementCache_.erase(t.elementId);
+        t.entry.reset();
+        return;
+    }
+    t.entry->translatable = t.translatable;
+    t.entry->lastAccessFrame = compileFrame_;
+    elementCache_[t.elementId] = t.entry;
 }
 
-static ScissorState intersectScissor(const ScissorState& a, const ScissorState& b) {
-    if (!a.active) return b;
-    if (!b.active) return a;
-    float x1 = std::max(a.x, b.x);
-    float y1 = std::max(a.y, b.y);
-    float x2 = std::min(a.x + a.width, b.x + b.width);
-    float y2 = std::min(a.y + a.height, b.y + b.height);
-    return {true, x1, y1, std::max(0.0f, x2 - x1), std::max(0.0f, y2 - y1)};
+// ---- Damage tracking helpers ----
+
+static uint64_t mixDamageHash(uint64_t h, uint32_t word) {
+    return (h ^ word) * 0x100000001b3ULL;
+}
+
+static uint64_t hashDamageBytes(uint64_t h, const void* data, size_t size) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i + sizeof(uint32_t) <= size; i += sizeof(uint32_t)) {
+        uint32_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        h = mixDamageHash(h, word);
+    }
+    return h;
+}
+
+static bool isEmptyExtent(const Rect& r) {
+    return !(r.width > 0 && r.height > 0);
+}
+
+static Rect uniteExtents(const Rect& a, const Rect& b) {
+    if (isEmptyExtent(a)) return b;
+    if (isEmptyExtent(b)) return a;
+    const float x0 = std::min(a.x, b.x);
+    const float y0 = std::min(a.y, b.y);
+    const float x1 = std::max(a.x + a.width, b.x + b.width);
+    const float y1 = std::max(a.y + a.height, b.y + b.height);
+    return {x0, y0, x1 - x0, y1 - y0};
+}
+
+/// True when two extents share pixels (with a pixel of slack for antialiased edges).
+/// Empty or non-finite extents overlap everything, so draws without known bounds never move.
+static bool extentsOverlap(const Rect& a, const Rect& b) {
+    if (isEmptyExtent(a) || isEmptyExtent(b)) return true;
+    return a.x < b.x + b.width + 1.f && b.x < a.x + a.width + 1.f &&
+           a.y < b.y + b.height + 1.f && b.y < a.y + a.height + 1.f;
+}
+
+/// Axis-aligned extent of a quad the SDF/glyph/image vertex shaders expand from
+/// (x, y, w, h) by `pad` on each side and rotate about its center by (cos, sin).
+static Rect quadExtent(float x, float y, float w, float h, float pad, float co, float si) {
+    const float hw = w * 0.5f + pad;
+    const float hh = h * 0.5f + pad;
+    const float ac = std::abs(co), as = std::abs(si);
+    const float ex = hw * ac + hh * as;
+    const float ey = hw * as + hh * ac;
+    return {x + w * 0.5f - ex, y + h * 0.5f - ey, ex * 2.f, ey * 2.f};
+}
+
+static Rect sdfQuadExtent(const SDFQuadInstance& inst) {
+    return quadExtent(inst.rect[0], inst.rect[1], inst.rect[2], inst.rect[3],
+                      std::max(inst.strokeWidth, 1.f), std::cos(inst.rotation), std::sin(inst.rotation));
+}
+
+static Rect sdfLineExtent(const SDFQuadInstance& inst) {
+    // Lines carry their direction in corners.xy.
+    return quadExtent(inst.rect[0], inst.rect[1], inst.rect[2], inst.rect[3],
+                      std::max(inst.strokeWidth, 1.f), inst.corners[0], inst.corners[1]);
 }
 
 void CommandCompiler::startNewGroup(CompiledBatches& out) {
-    // Mark all active element tracks as having a scissor break
-    for (auto& t : elementTrackStack_) {
-        t.hadScissorBreak = true;
+    if (elementTrackStack_.empty()) {
+        openGroup(out, current_.scissor);
+        return;
     }
+    auto& t = elementTrackStack_.back();
+    endRun(t, out);
+    openGroup(out, current_.scissor);
+    beginRun(t, out);
+    t.runStartsGroup = true;
+    t.runScissor = current_.scissor;
+    if (!subtreeClip(current_.clipNode, t.clipNode, t.runClip)) t.cacheable = false;
+}
 
+void CommandCompiler::openGroup(CompiledBatches& out, const ScissorState& scissor) {
     DrawGroup g;
-    g.scissor = current_.scissor;
+    g.scissor = scissor;
     g.rectOffset   = static_cast<uint32_t>(out.rects.size());
     g.circleOffset = static_cast<uint32_t>(out.circles.size());
     g.lineOffset   = static_cast<uint32_t>(out.lines.size());
@@ -155,6 +372,43 @@ void CommandCompiler::startNewGroup(CompiledBatches& out) {
     out.groups.push_back(std::move(g));
 }
 
+bool CommandCompiler::subtreeClip(int32_t node, int32_t entryNode, ScissorState& clip) const {
+    clip = {};
+    for (; node != entryNode; node = clipNodes_[static_cast<size_t>(node)].parent) {
+        if (node < 0) return false; // group lies outside the subtree's clips
+        clip = intersectScissor(clip, clipNodes_[static_cast<size_t>(node)].rect);
+    }
+    return true;
+}
+
+CommandCompiler::CommandCompiler() = default;
+CommandCompiler::~CommandCompiler() = default;
+
+void CommandCompiler::setWorkerThreads(size_t threads) {
+    setWorkerPool(threads > 0 ? std::make_shared<ThreadPool>(threads) : nullptr);
+}
+
+void CommandCompiler::setWorkerPool(std::shared_ptr<ThreadPool> pool) {
+    workers_.clear();
+    pool_ = std::move(pool);
+    if (!pool_) return;
+    for (size_t i = 0; i < pool_->slotCount(); ++i) {
+        workers_.push_back(std::make_unique<CommandCompiler>());
+    }
+}
+
+void CommandCompiler::resetState(float dpiScaleX, float dpiScaleY) {
+    current_ = State{};
+    current_.m00 = dpiScaleX;
+    current_.m11 = dpiScaleY;
+    current_.fill = FillStyle::none();
+    current_.stroke = StrokeStyle::none();
+    current_.textStyle = TextStyle{};
+    stateStack_.clear();
+    elementTrackStack_.clear();
+    clipNodes_.clear();
+}
+
 void CommandCompiler::compile(const RenderCommandBuffer& buffer,
                               float vpWidth, float vpHeight,
                               float dpiScaleX, float dpiScaleY,
@@ -175,80 +429,169 @@ void CommandCompiler::compile(const RenderCommandBuffer& buffer,
     out.viewportHeight = vpHeight;
     out.clearColor = {};
 
-    current_ = State{};
-    current_.m00 = dpiScaleX;
-    current_.m11 = dpiScaleY;
-    current_.fill = FillStyle::none();
-    current_.stroke = StrokeStyle::none();
-    current_.textStyle = TextStyle{};
-    stateStack_.clear();
-    elementTrackStack_.clear();
     ++compileFrame_;
+    if (atlas_ && atlas_->generation() != atlasGeneration_) {
+        atlasGeneration_ = atlas_->generation();
+        elementCache_.clear();
+        atlasReset_ = true;
+    }
     cacheStats_ = {};
+    parallelStats_ = {};
+    jobs_.clear();
+    nextJob_ = 0;
+    if (pool_) {
+        resetState(dpiScaleX, dpiScaleY);
+        planJobs(buffer, vpWidth, vpHeight);
+        parallelStats_.jobs = jobs_.size();
+        pool_->parallelFor(jobs_.size(), [&](size_t index, size_t slot) {
+            workers_[slot]->runJob(*this, buffer, jobs_[index], vpWidth, vpHeight);
+        });
+    }
+
+    resetState(dpiScaleX, dpiScaleY);
+    out.damage.clear();
+    damageStack_.clear();
+    beginDamageTrack(0);
 
     startNewGroup(out);
 
     auto r = buffer.reader();
-    while (r.hasNext()) {
+    compileRange(buffer, r, static_cast<uint32_t>(buffer.size()), out);
+
+    finishDamage(out);
+    drawCallStats_ = {};
+    reorderDrawOps(out);
+    mergeDrawOps(out);
+
+    rectPeak_ = std::max(rectPeak_, out.rects.size());
+    circlePeak_ = std::max(circlePeak_, out.circles.size());
+    linePeak_ = std::max(linePeak_, out.lines.size());
+    glyphPeak_ = std::max(glyphPeak_, out.glyphs.size());
+    pathVertPeak_ = std::max(pathVertPeak_, out.pathVertices.size());
+    groupPeak_ = std::max(groupPeak_, out.groups.size());
+
+    // Evict stale cache entries every 120 frames
+    if (compileFrame_ % 120 == 0) {
+        for (auto it = elementCache_.begin(); it != elementCache_.end();) {
+            if (compileFrame_ - it->second->lastAccessFrame > 60) {
+                it = elementCache_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+bool CommandCompiler::applyStateOp(CmdOp op, RenderCommandBuffer::Reader& r,
+                                   const RenderCommandBuffer& buffer, CompiledBatches& out) {
+    switch (op) {
+        case CmdOp::Save:
+            stateStack_.push_back(current_);
+            return true;
+        case CmdOp::Restore:
+            if (stateStack_.empty()) {
+                // A job cannot see the saves it would pop
+                if (job_) jobFailed_ = true;
+            } else {
+                ScissorState prevScissor = current_.scissor;
+                current_ = stateStack_.back();
+                stateStack_.pop_back();
+                if (current_.scissor != prevScissor)
+                    startNewGroup(out);
+            }
+            return true;
+        case CmdOp::Translate: {
+            float x = r.readFloat(), y = r.readFloat();
+            current_.m02 += current_.m00 * x + current_.m01 * y;
+            current_.m12 += current_.m10 * x + current_.m11 * y;
+            return true;
+        }
+        case CmdOp::Rotate: {
+            float angle = r.readFloat();
+            const float co = std::cos(angle);
+            const float si = std::sin(angle);
+            const float n00 = current_.m00 * co + current_.m01 * si;
+            const float n01 = -current_.m00 * si + current_.m01 * co;
+            const float n10 = current_.m10 * co + current_.m11 * si;
+            const float n11 = -current_.m10 * si + current_.m11 * co;
+            current_.m00 = n00;
+            current_.m01 = n01;
+            current_.m10 = n10;
+            current_.m11 = n11;
+            return true;
+        }
+        case CmdOp::Scale: {
+            float sx = r.readFloat(), sy = r.readFloat();
+            current_.m00 *= sx;
+            current_.m01 *= sy;
+            current_.m10 *= sx;
+            current_.m11 *= sy;
+            return true;
+        }
+        case CmdOp::SetOpacity:
+            current_.opacity = r.readFloat();
+            return true;
+        case CmdOp::SetFillStyle:
+            current_.fill = buffer.fillStyle(r.readUint32());
+            return true;
+        case CmdOp::SetStrokeStyle:
+            current_.stroke = buffer.strokeStyle(r.readUint32());
+            return true;
+        case CmdOp::SetTextStyle:
+            current_.textStyle = buffer.textStyle(r.readUint32());
+            return true;
+        case CmdOp::ClipPath: {
+            const Path& clipPath = buffer.path(r.readUint32());
+            auto bounds = clipPath.getBounds();
+            float bx = bounds.x, by = bounds.y, bw = bounds.width, bh = bounds.height;
+            float x0 = bx, y0 = by;
+            float x1 = bx + bw, y1 = by;
+            float x2 = bx + bw, y2 = by + bh;
+            float x3 = bx, y3 = by + bh;
+            applyTransform(x0, y0);
+            applyTransform(x1, y1);
+            applyTransform(x2, y2);
+            applyTransform(x3, y3);
+            const float minX = std::min({x0, x1, x2, x3});
+            const float maxX = std::max({x0, x1, x2, x3});
+            const float minY = std::min({y0, y1, y2, y3});
+            const float maxY = std::max({y0, y1, y2, y3});
+            ScissorState newClip{true, minX, minY, maxX - minX, maxY - minY};
+            ScissorState merged = intersectScissor(current_.scissor, newClip);
+            clipNodes_.push_back({newClip, current_.clipNode});
+            current_.clipNode = static_cast<int32_t>(clipNodes_.size()) - 1;
+            if (merged != current_.scissor) {
+                current_.scissor = merged;
+                startNewGroup(out);
+            } else {
+                // Only covers the scissor at this position; moved, it might not.
+                for (auto& t : elementTrackStack_) t.translatable = false;
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+void CommandCompiler::compileRange(const RenderCommandBuffer& buffer, RenderCommandBuffer::Reader& r,
+                                   uint32_t end, CompiledBatches& out) {
+    while (r.hasNext() && r.wordOffset() < end) {
+        while (nextJob_ < jobs_.size() && jobs_[nextJob_].begin < r.wordOffset()) ++nextJob_;
+        if (nextJob_ < jobs_.size() && jobs_[nextJob_].begin == r.wordOffset() &&
+            spliceJob(jobs_[nextJob_++], r, out)) {
+            continue;
+        }
+
         CmdOp op = r.nextOp();
+        if (applyStateOp(op, r, buffer, out)) continue;
+        const size_t opsBefore = out.groups.back().drawOps.size();
         switch (op) {
             case CmdOp::Clear: {
                 Color col{r.readFloat(), r.readFloat(), r.readFloat(), r.readFloat()};
                 out.clearColor = {col.r, col.g, col.b, col.a};
                 break;
             }
-            case CmdOp::Save:
-                stateStack_.push_back(current_);
-                break;
-            case CmdOp::Restore:
-                if (!stateStack_.empty()) {
-                    ScissorState prevScissor = current_.scissor;
-                    current_ = stateStack_.back();
-                    stateStack_.pop_back();
-                    if (current_.scissor != prevScissor)
-                        startNewGroup(out);
-                }
-                break;
-            case CmdOp::Translate: {
-                float x = r.readFloat(), y = r.readFloat();
-                current_.m02 += current_.m00 * x + current_.m01 * y;
-                current_.m12 += current_.m10 * x + current_.m11 * y;
-                break;
-            }
-            case CmdOp::Rotate: {
-                float angle = r.readFloat();
-                const float co = std::cos(angle);
-                const float si = std::sin(angle);
-                const float n00 = current_.m00 * co + current_.m01 * si;
-                const float n01 = -current_.m00 * si + current_.m01 * co;
-                const float n10 = current_.m10 * co + current_.m11 * si;
-                const float n11 = -current_.m10 * si + current_.m11 * co;
-                current_.m00 = n00;
-                current_.m01 = n01;
-                current_.m10 = n10;
-                current_.m11 = n11;
-                break;
-            }
-            case CmdOp::Scale: {
-                float sx = r.readFloat(), sy = r.readFloat();
-                current_.m00 *= sx;
-                current_.m01 *= sy;
-                current_.m10 *= sx;
-                current_.m11 *= sy;
-                break;
-            }
-            case CmdOp::SetOpacity:
-                current_.opacity = r.readFloat();
-                break;
-            case CmdOp::SetFillStyle:
-                current_.fill = buffer.fillStyle(r.readUint32());
-                break;
-            case CmdOp::SetStrokeStyle:
-                current_.stroke = buffer.strokeStyle(r.readUint32());
-                break;
-            case CmdOp::SetTextStyle:
-                current_.textStyle = buffer.textStyle(r.readUint32());
-                break;
             case CmdOp::DrawRect: {
                 Rect bounds{r.readFloat(), r.readFloat(), r.readFloat(), r.readFloat()};
                 CornerRadius cr{r.readFloat(), r.readFloat(), r.readFloat(), r.readFloat()};
@@ -288,30 +631,6 @@ void CommandCompiler::compile(const RenderCommandBuffer& buffer,
                 pushTextBox(out, buffer.str(strId), pos, maxWidth, hAlign);
                 break;
             }
-            case CmdOp::ClipPath: {
-                const Path& clipPath = buffer.path(r.readUint32());
-                auto bounds = clipPath.getBounds();
-                float bx = bounds.x, by = bounds.y, bw = bounds.width, bh = bounds.height;
-                float x0 = bx, y0 = by;
-                float x1 = bx + bw, y1 = by;
-                float x2 = bx + bw, y2 = by + bh;
-                float x3 = bx, y3 = by + bh;
-                applyTransform(x0, y0);
-                applyTransform(x1, y1);
-                applyTransform(x2, y2);
-                applyTransform(x3, y3);
-                const float minX = std::min({x0, x1, x2, x3});
-                const float maxX = std::max({x0, x1, x2, x3});
-                const float minY = std::min({y0, y1, y2, y3});
-                const float maxY = std::max({y0, y1, y2, y3});
-                ScissorState newClip{true, minX, minY, maxX - minX, maxY - minY};
-                ScissorState merged = intersectScissor(current_.scissor, newClip);
-                if (merged != current_.scissor) {
-                    current_.scissor = merged;
-                    startNewGroup(out);
-                }
-                break;
-            }
             case CmdOp::DrawImage: {
                 int imageId = r.readInt32();
                 Rect rect{r.readFloat(), r.readFloat(), r.readFloat(), r.readFloat()};
@@ -341,105 +660,575 @@ void CommandCompiler::compile(const RenderCommandBuffer& buffer,
                                       (static_cast<uint64_t>(verHi) << 32);
                 uint32_t endOffset = r.readUint32();
 
-                auto fp = computeStateFingerprint();
-                auto cacheIt = elementCache_.find(elemId);
-                if (cacheIt != elementCache_.end()) {
-                    auto& entry = cacheIt->second;
-                    if (entry.subtreeVersion == subtreeVer &&
-                        entry.fingerprint == fp &&
-                        !entry.hasScissorBreaks) {
-                        entry.lastAccessFrame = compileFrame_;
-                        spliceCacheEntry(entry, out);
-                        ++cacheStats_.hits;
-                        r.seekTo(endOffset);
-                        // Consume the EndElement opcode
-                        if (r.hasNext()) r.nextOp();
-                        break;
+                if (auto entry = findCacheHit(elemId, subtreeVer)) {
+                    if (!entry->translatable) {
+                        for (auto& t : elementTrackStack_) t.translatable = false;
                     }
+                    if (!elementTrackStack_.empty()) endRun(elementTrackStack_.back(), out);
+                    replayCacheEntry(*entry, out, current_.m02, current_.m12, current_.scissor);
+                    if (current_.m02 != entry->originX || current_.m12 != entry->originY) {
+                        ++cacheStats_.translated;
+                    }
+                    addChildPiece(std::move(entry), current_.m02, current_.m12, out);
+                    damageStack_.back().children.push_back(elemId);
+                    placeDamageRecords(elemId, current_.m02, current_.m12, current_.scissor, out);
+                    ++cacheStats_.hits;
+                    r.seekTo(endOffset);
+                    // Consume the EndElement opcode
+                    if (r.hasNext()) r.nextOp();
+                    break;
                 }
 
                 ++cacheStats_.misses;
-                elementTrackStack_.push_back({
-                    elemId, subtreeVer, fp,
-                    out.rects.size(), out.circles.size(), out.lines.size(),
-                    out.glyphs.size(), out.pathVertices.size(),
-                    out.groups.back().drawOps.size(),
-                    current_.scissor, false
-                });
+                if (!elementTrackStack_.empty()) endRun(elementTrackStack_.back(), out);
+                ElementTrack track{elemId, current_.clipNode};
+                track.entry = std::make_shared<CachedElementData>();
+                track.entry->subtreeVersion = subtreeVer;
+                track.entry->fingerprint = computeStateFingerprint();
+                track.entry->originX = current_.m02;
+                track.entry->originY = current_.m12;
+                beginRun(track, out);
+                elementTrackStack_.push_back(std::move(track));
+                beginDamageTrack(elemId);
                 break;
             }
             case CmdOp::EndElement: {
                 if (!elementTrackStack_.empty()) {
                     auto& t = elementTrackStack_.back();
-
-                    // Detect scissor breaks (group structure changed during this element)
-                    bool scissorBroke = t.hadScissorBreak ||
-                                       (current_.scissor != t.entryScissor);
-
-                    CachedElementData entry;
-                    entry.subtreeVersion = t.subtreeVersion;
-                    entry.fingerprint = t.fingerprint;
-                    entry.lastAccessFrame = compileFrame_;
-                    entry.hasScissorBreaks = scissorBroke;
-
-                    if (!scissorBroke) {
-                        entry.rects.assign(out.rects.begin() + static_cast<ptrdiff_t>(t.rectStart), out.rects.end());
-                        entry.circles.assign(out.circles.begin() + static_cast<ptrdiff_t>(t.circleStart), out.circles.end());
-                        entry.lines.assign(out.lines.begin() + static_cast<ptrdiff_t>(t.lineStart), out.lines.end());
-                        entry.glyphs.assign(out.glyphs.begin() + static_cast<ptrdiff_t>(t.glyphStart), out.glyphs.end());
-                        entry.pathVerts.assign(out.pathVertices.begin() + static_cast<ptrdiff_t>(t.pathStart), out.pathVertices.end());
-
-                        auto& g = out.groups.back();
-                        auto opBegin = g.drawOps.begin() + static_cast<ptrdiff_t>(t.drawOpStart);
-                        entry.drawOps.assign(opBegin, g.drawOps.end());
-
-                        // Compute the group-local counts that existed when this element started
-                        uint32_t rectCountAtStart = g.rectCount - static_cast<uint32_t>(entry.rects.size());
-                        uint32_t circleCountAtStart = g.circleCount - static_cast<uint32_t>(entry.circles.size());
-                        uint32_t lineCountAtStart = g.lineCount - static_cast<uint32_t>(entry.lines.size());
-                        uint32_t glyphCountAtStart = g.glyphCount - static_cast<uint32_t>(entry.glyphs.size());
-                        uint32_t pathVertAtStart = static_cast<uint32_t>(t.pathStart) - g.pathOffset;
-
-                        for (auto& dop : entry.drawOps) {
-                            switch (dop.type) {
-                                case DrawOpType::Rect:   dop.offset -= rectCountAtStart; break;
-                                case DrawOpType::Circle: dop.offset -= circleCountAtStart; break;
-                                case DrawOpType::Line:   dop.offset -= lineCountAtStart; break;
-                                case DrawOpType::Glyph:  dop.offset -= glyphCountAtStart; break;
-                                case DrawOpType::Path:   dop.offset -= pathVertAtStart; break;
-                                default: break;
-                            }
-                        }
+                    endRun(t, out);
+                    storeCacheEntry(t);
+                    const uintptr_t elemId = t.elementId;
+                    std::shared_ptr<CachedElementData> entry = std::move(t.entry);
+                    elementTrackStack_.pop_back();
+                    if (job_ && elementTrackStack_.empty()) {
+                        if (entry) job_->roots.emplace_back(elemId, entry);
+                        else jobFailed_ = true;
                     }
+                    const float x = entry ? entry->originX : 0.f, y = entry ? entry->originY : 0.f;
+                    addChildPiece(std::move(entry), x, y, out);
+                    if (damageStack_.size() > 1) endDamageTrack(out);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        if (op >= CmdOp::DrawRect && op <= CmdOp::DrawImagePath) {
+            noteDrawOps(out, opsBefore);
+        }
+    }
+}
 
-                    elementCache_[t.elementId] = std::move(entry);
+std::shared_ptr<CommandCompiler::CachedElementData>
+CommandCompiler::findCacheHit(uintptr_t elementId, uint64_t subtreeVersion) const {
+    // A job reads the cache of the compiler that planned it, as that cache stood when
+    // the compile began.
+    const auto& cache = cacheSource_ ? cacheSource_->elementCache_ : elementCache_;
+    auto it = cache.find(elementId);
+    if (it == cache.end()) return nullptr;
+    const auto& entry = it->second;
+    const bool moved = current_.m02 != entry->originX || current_.m12 != entry->originY;
+    if (entry->subtreeVersion != subtreeVersion || !(entry->fingerprint == computeStateFingerprint()) ||
+        (moved && !entry->translatable)) {
+        return nullptr;
+    }
+    return entry;
+}
 
-                    elementTrackStack_.pop_back();
+// ---- Parallel compile ----
+
+// Runs smaller than this cost less to compile than to hand off.
+static constexpr uint32_t kMinJobWords = 128;
+// Jobs planned per pool slot, so uneven subtrees still balance.
+static constexpr size_t kJobsPerSlot = 4;
+
+// Walks the stream the way the serial pass will, without emitting anything, and cuts
+// it into jobs: runs of adjacent sibling subtrees that miss the cache, no larger than
+// an even share of the stream. Larger subtrees are descended into; cache hits and
+// loose draws between elements stay with the serial pass.
+void CommandCompiler::planJobs(const RenderCommandBuffer& buffer, float vpWidth, float vpHeight) {
+    const uint32_t maxWords = std::max(
+        kMinJobWords * 4, static_cast<uint32_t>(buffer.size() / (pool_->slotCount() * kJobsPerSlot)));
+    jobOut_ = {};
+    jobOut_.viewportWidth = vpWidth;
+    jobOut_.viewportHeight = vpHeight;
+    openGroup(jobOut_, current_.scissor);
+
+    bool open = false;
+    auto closeJob = [&] {
+        if (open && jobs_.back().end - jobs_.back().begin < kMinJobWords) jobs_.pop_back();
+        open = false;
+    };
+
+    auto r = buffer.reader();
+    while (r.hasNext()) {
+        const uint32_t at = r.wordOffset();
+        CmdOp op = r.nextOp();
+        if (op != CmdOp::BeginElement) {
+            closeJob();
+            if (!applyStateOp(op, r, buffer, jobOut_)) r.skipOperands(op);
+            continue;
+        }
+
+        uint32_t idLo = r.readUint32();
+        uint32_t idHi = r.readUint32();
+        uintptr_t elemId = static_cast<uintptr_t>(idLo) | (static_cast<uintptr_t>(idHi) << 32);
+        uint32_t verLo = r.readUint32();
+        uint32_t verHi = r.readUint32();
+        uint64_t subtreeVer = static_cast<uint64_t>(verLo) | (static_cast<uint64_t>(verHi) << 32);
+        uint32_t endOffset = r.readUint32();
+        const uint32_t after = endOffset + 1; // past the EndElement opcode
+
+        if (findCacheHit(elemId, subtreeVer)) {
+            closeJob();
+            r.seekTo(after);
+            continue;
+        }
+        if (after - at > maxWords) {
+            closeJob(); // descend
+            continue;
+        }
+        if (open && jobs_.back().end == at && after - jobs_.back().begin <= maxWords) {
+            jobs_.back().end = after;
+        } else {
+            closeJob();
+            CompileJob job;
+            job.begin = at;
+            job.end = after;
+            job.entry = current_;
+            jobs_.push_back(std::move(job));
+            open = true;
+        }
+        r.seekTo(after);
+    }
+    closeJob();
+}
+
+// Compiles one job on a worker's own state. Text may only use glyphs already in the
+// atlas, which cannot move while the compile runs; a job that would rasterize one is
+// left to the serial pass.
+void CommandCompiler::runJob(const CommandCompiler& owner, const RenderCommandBuffer& buffer,
+                             CompileJob& job, float vpWidth, float vpHeight) {
+    cacheSource_ = &owner;
+    job_ = &job;
+    jobFailed_ = false;
+    atlas_ = owner.atlas_;
+    compileFrame_ = owner.compileFrame_;
+    current_ = job.entry;
+    current_.clipNode = -1;
+    stateStack_.clear();
+    elementTrackStack_.clear();
+    clipNodes_.clear();
+    elementCache_.clear();
+    cacheStats_ = {};
+    damageStack_.clear();
+    beginDamageTrack(0);
+
+    jobOut_ = {};
+    jobOut_.viewportWidth = vpWidth;
+    jobOut_.viewportHeight = vpHeight;
+    openGroup(jobOut_, current_.scissor);
+
+    bool missed;
+    {
+        GlyphAtlas::LookupOnlyScope lookupOnly;
+        auto r = buffer.reader();
+        r.seekTo(job.begin);
+        compileRange(buffer, r, job.end, jobOut_);
+        missed = lookupOnly.missed();
+    }
+
+    State exit = current_;
+    exit.clipNode = job.entry.clipNode;
+    job.valid = !jobFailed_ && !missed && stateStack_.empty() && elementTrackStack_.empty() &&
+                current_.clipNode == -1 && exit == job.entry;
+    job.entries.assign(elementCache_.begin(), elementCache_.end());
+    elementCache_.clear();
+    job.stats = cacheStats_;
+    job_ = nullptr;
+    cacheSource_ = nullptr;
+}
+
+// Stands in for compiling [job.begin, job.end): the job's subtrees are replayed like
+// cache hits at the position they were compiled for. Returns false, leaving the
+// reader where it was, when the job has to be compiled serially.
+bool CommandCompiler::spliceJob(CompileJob& job, RenderCommandBuffer::Reader& r, CompiledBatches& out) {
+    State entry = current_;
+    entry.clipNode = job.entry.clipNode;
+    if (!job.valid || !(entry == job.entry)) {
+        ++parallelStats_.fallbacks;
+        return false;
+    }
+
+    for (auto& [elemId, root] : job.roots) {
+        if (!root->translatable) {
+            for (auto& t : elementTrackStack_) t.translatable = false;
+        }
+        if (!elementTrackStack_.empty()) endRun(elementTrackStack_.back(), out);
+        replayCacheEntry(*root, out, current_.m02, current_.m12, current_.scissor);
+        addChildPiece(root, current_.m02, current_.m12, out);
+        damageStack_.back().children.push_back(elemId);
+    }
+    for (auto& e : job.damage) {
+        if (e.place) {
+            placeDamageRecords(e.track.elementId, e.x, e.y, e.scissor, out);
+        } else {
+            // Compiled elements that left no entry must not keep an older one
+            elementCache_.erase(e.track.elementId);
+            commitDamageTrack(std::move(e.track), out);
+        }
+    }
+    for (auto& [elemId, cached] : job.entries) elementCache_[elemId] = std::move(cached);
+
+    cacheStats_.hits += job.stats.hits;
+    cacheStats_.misses += job.stats.misses;
+    cacheStats_.translated += job.stats.translated;
+    cacheStats_.storedInstances += job.stats.storedInstances;
+    r.seekTo(job.end);
+    return true;
+}
+
+void CommandCompiler::beginDamageTrack(uintptr_t elementId) {
+    if (!damageStack_.empty()) damageStack_.back().children.push_back(elementId);
+    damageStack_.push_back({elementId, 0xcbf29ce484222325ULL, {}, {}, current_.m02, current_.m12, {}});
+}
+
+void CommandCompiler::touchDamageRecords(uintptr_t elementId) {
+    auto it = damageRecords_.find(elementId);
+    if (it == damageRecords_.end()) return;
+    it->second.lastFrame = compileFrame_;
+    for (uintptr_t child : it->second.children) touchDamageRecords(child);
+}
+
+// A cache hit places the element's whole subtree at the current translation. Records
+// are moved from where they were last drawn, which is not the cache entry's origin once
+// the subtree has been replayed at more than one position.
+void CommandCompiler::placeDamageRecords(uintptr_t elementId, float x, float y,
+                                         const ScissorState& scissor, CompiledBatches& out) {
+    if (job_) {
+        // Records belong to the compiler that splices the job
+        DamageEvent e;
+        e.track.elementId = elementId;
+        e.place = true;
+        e.x = x;
+        e.y = y;
+        e.scissor = scissor;
+        job_->damage.push_back(std::move(e));
+        return;
+    }
+    auto it = damageRecords_.find(elementId);
+    if (it == damageRecords_.end()) return;
+    const float dx = x - it->second.originX;
+    const float dy = y - it->second.originY;
+    if (dx != 0 || dy != 0) {
+        moveDamageRecords(elementId, dx, dy, scissor, out);
+    } else {
+        touchDamageRecords(elementId);
+    }
+}
+
+// Damage where each record was drawn and where it is drawn now. Clips inside the subtree
+// are not re-applied, so the new extents are clipped by the entry scissor only; that
+// over-covers but never misses pixels.
+void CommandCompiler::moveDamageRecords(uintptr_t elementId, float dx, float dy,
+                                        const ScissorState& scissor, CompiledBatches& out) {
+    auto it = damageRecords_.find(elementId);
+    if (it == damageRecords_.end()) return;
+    DamageRecord& rec = it->second;
+    rec.lastFrame = compileFrame_;
+    if (!isEmptyExtent(rec.extent)) out.damage.push_back(rec.extent);
+    rec.drawn.x += dx;
+    rec.drawn.y += dy;
+    rec.originX += dx;
+    rec.originY += dy;
+    rec.extent = rec.drawn;
+    if (scissor.active && !isEmptyExtent(rec.drawn)) {
+        const ScissorState clipped = intersectScissor(
+            scissor, {true, rec.drawn.x, rec.drawn.y, rec.drawn.width, rec.drawn.height});
+        rec.extent = {clipped.x, clipped.y, clipped.width, clipped.height};
+    }
+    if (!isEmptyExtent(rec.extent)) out.damage.push_back(rec.extent);
+    for (uintptr_t child : rec.children) moveDamageRecords(child, dx, dy, scissor, out);
+}
+
+void CommandCompiler::endDamageTrack(CompiledBatches& out) {
+    DamageTrack t = std::move(damageStack_.back());
+    damageStack_.pop_back();
+    if (job_) {
+        job_->damage.push_back({std::move(t)});
+        return;
+    }
+    commitDamageTrack(std::move(t), out);
+}
+
+void CommandCompiler::commitDamageTrack(DamageTrack t, CompiledBatches& out) {
+    auto addDamage = [&](const Rect& r) {
+        if (!isEmptyExtent(r)) out.damage.push_back(r);
+    };
+    auto [it, inserted] = damageRecords_.try_emplace(t.elementId);
+    DamageRecord& rec = it->second;
+    if (inserted || rec.hash != t.hash) {
+        addDamage(rec.extent);
+        addDamage(t.extent);
+    }
+
+    // Children added or removed damage themselves; children kept but drawn in a new
+    // order change what is on top where they overlap.
+    if (!inserted && rec.children != t.children) {
+        std::unordered_map<uintptr_t, size_t> oldOrder;
+        oldOrder.reserve(rec.children.size());
+        for (size_t i = 0; i < rec.children.size(); ++i) oldOrder.emplace(rec.children[i], i);
+        size_t last = 0;
+        bool reordered = false;
+        for (uintptr_t child : t.children) {
+            auto o = oldOrder.find(child);
+            if (o == oldOrder.end()) continue;
+            if (o->second < last) { reordered = true; break; }
+            last = o->second;
+        }
+        if (reordered) {
+            std::vector<uintptr_t> pending = t.children;
+            while (!pending.empty()) {
+                auto c = damageRecords_.find(pending.back());
+                pending.pop_back();
+                if (c == damageRecords_.end()) continue;
+                addDamage(c->second.extent);
+                pending.insert(pending.end(), c->second.children.begin(), c->second.children.end());
+            }
+        }
+    }
+
+    rec.hash = t.hash;
+    rec.extent = t.extent;
+    rec.drawn = t.drawn;
+    rec.originX = t.originX;
+    rec.originY = t.originY;
+    rec.lastFrame = compileFrame_;
+    rec.children = std::move(t.children);
+}
+
+void CommandCompiler::noteDrawOps(CompiledBatches& out, size_t firstOp) {
+    auto& g = out.groups.back();
+    DamageTrack& t = damageStack_.back();
+    uint64_t h = t.hash;
+    for (size_t i = firstOp; i < g.drawOps.size(); ++i) {
+        DrawOp& op = g.drawOps[i];
+        Rect bounds;
+        h = mixDamageHash(h, static_cast<uint32_t>(op.type) | (static_cast<uint32_t>(op.pageIndex) << 8));
+        switch (op.type) {
+            case DrawOpType::Rect:
+            case DrawOpType::Circle: {
+                const auto& src = op.type == DrawOpType::Rect ? out.rects : out.circles;
+                const uint32_t base = op.type == DrawOpType::Rect ? g.rectOffset : g.circleOffset;
+                for (uint32_t k = 0; k < op.count; ++k) {
+                    const SDFQuadInstance& inst = src[base + op.offset + k];
+                    bounds = uniteExtents(bounds, sdfQuadExtent(inst));
+                    h = hashDamageBytes(h, &inst, sizeof(inst));
+                }
+                break;
+            }
+            case DrawOpType::Line:
+                for (uint32_t k = 0; k < op.count; ++k) {
+                    const SDFQuadInstance& inst = out.lines[g.lineOffset + op.offset + k];
+                    bounds = uniteExtents(bounds, sdfLineExtent(inst));
+                    h = hashDamageBytes(h, &inst, sizeof(inst));
+                }
+                break;
+            case DrawOpType::Glyph:
+                for (uint32_t k = 0; k < op.count; ++k) {
+                    const GlyphInstance& gi = out.glyphs[g.glyphOffset + op.offset + k];
+                    bounds = uniteExtents(bounds, quadExtent(gi.screenRect[0], gi.screenRect[1],
+                                                             gi.screenRect[2], gi.screenRect[3], 1.f,
+                                                             std::cos(gi.rotation), std::sin(gi.rotation)));
+                    h = hashDamageBytes(h, &gi, sizeof(gi));
+                }
+                break;
+            case DrawOpType::Path: {
+                if (op.count == 0) break;
+                const PathVertex* v = out.pathVertices.data() + g.pathOffset + op.offset;
+                float x0 = v[0].x, y0 = v[0].y, x1 = v[0].x, y1 = v[0].y;
+                for (uint32_t k = 0; k < op.count; ++k) {
+                    x0 = std::min(x0, v[k].x);
+                    y0 = std::min(y0, v[k].y);
+                    x1 = std::max(x1, v[k].x);
+                    y1 = std::max(y1, v[k].y);
                 }
+                // One pixel of slack for antialiased edges.
+                bounds = {x0 - 1.f, y0 - 1.f, x1 - x0 + 2.f, y1 - y0 + 2.f};
+                h = hashDamageBytes(h, v, sizeof(PathVertex) * op.count);
+                break;
+            }
+            case DrawOpType::Image: {
+                const ImageDrawCmd& draw = g.imageDraws[op.offset];
+                const ImageInstance& inst = draw.instance;
+                bounds = quadExtent(inst.screenRect[0], inst.screenRect[1], inst.screenRect[2],
+                                    inst.screenRect[3], 1.f, std::cos(inst.rotation), std::sin(inst.rotation));
+                h = hashDamageBytes(h, &inst, sizeof(inst));
+                h = mixDamageHash(h, static_cast<uint32_t>(draw.imageId));
+                h = mixDamageHash(h, static_cast<uint32_t>(std::hash<std::string>{}(draw.path)));
                 break;
             }
         }
+        op.bounds = bounds;
+
+        Rect visible = bounds;
+        h = mixDamageHash(h, g.scissor.active ? 1u : 0u);
+        if (g.scissor.active) {
+            const ScissorState clipped = intersectScissor(
+                g.scissor, {true, bounds.x, bounds.y, bounds.width, bounds.height});
+            visible = {clipped.x, clipped.y, clipped.width, clipped.height};
+            h = hashDamageBytes(h, &g.scissor.x, sizeof(float) * 4);
+        }
+        t.extent = uniteExtents(t.extent, visible);
+        t.drawn = uniteExtents(t.drawn, bounds);
     }
+    t.hash = h;
+}
 
-    // Propagate scissor-break flag up the tracking stack when a group starts
-    // (already handled inline via startNewGroup detection below)
+void CommandCompiler::finishDamage(CompiledBatches& out) {
+    while (!damageStack_.empty()) endDamageTrack(out);
 
-    rectPeak_ = std::max(rectPeak_, out.rects.size());
-    circlePeak_ = std::max(circlePeak_, out.circles.size());
-    linePeak_ = std::max(linePeak_, out.lines.size());
-    glyphPeak_ = std::max(glyphPeak_, out.glyphs.size());
-    pathVertPeak_ = std::max(pathVertPeak_, out.pathVertices.size());
-    groupPeak_ = std::max(groupPeak_, out.groups.size());
+    for (auto it = damageRecords_.begin(); it != damageRecords_.end();) {
+        if (it->second.lastFrame != compileFrame_) {
+            if (!isEmptyExtent(it->second.extent)) out.damage.push_back(it->second.extent);
+            it = damageRecords_.erase(it);
+        } else {
+            ++it;
+        }
+    }
 
-    // Evict stale cache entries every 120 frames
-    if (compileFrame_ % 120 == 0) {
-        for (auto it = elementCache_.begin(); it != elementCache_.end();) {
-            if (compileFrame_ - it->second.lastAccessFrame > 60) {
-                it = elementCache_.erase(it);
+    const gpu::ClearColor& c = out.clearColor;
+    out.fullDamage = compileFrame_ == 1 || atlasReset_ ||
+                     out.viewportWidth != lastViewportWidth_ || out.viewportHeight != lastViewportHeight_ ||
+                     c.r != lastClearColor_.r || c.g != lastClearColor_.g ||
+                     c.b != lastClearColor_.b || c.a != lastClearColor_.a;
+    if (out.fullDamage) out.damage.clear();
+    atlasReset_ = false;
+    lastViewportWidth_ = out.viewportWidth;
+    lastViewportHeight_ = out.viewportHeight;
+    lastClearColor_ = c;
+}
+
+void CommandCompiler::reorderDrawOps(CompiledBatches& out) {
+    // How many batches back a draw may travel; bounds the cost on long, busy groups.
+    static constexpr size_t kReorderWindow = 32;
+
+    auto sameBatch = [](const DrawGroup& g, const DrawOp& a, const DrawOp& b) {
+        if (a.type != b.type) return false;
+        if (a.type == DrawOpType::Glyph) return a.pageIndex == b.pageIndex;
+        if (a.type == DrawOpType::Image) {
+            const ImageDrawCmd& ia = g.imageDraws[a.offset];
+            const ImageDrawCmd& ib = g.imageDraws[b.offset];
+            return ia.imageId == ib.imageId && ia.path == ib.path;
+        }
+        return true;
+    };
+
+    struct Batch {
+        Rect bounds;
+        std::vector<uint32_t> ops;
+    };
+    std::vector<Batch> batches;
+    std::vector<DrawOp> ordered;
+
+    for (auto& g : out.groups) {
+        drawCallStats_.beforeMerge += g.drawOps.size();
+        if (g.drawOps.size() < 3) continue;
+
+        // Each draw joins the latest batch with the same pipeline that it can reach
+        // without passing a draw it overlaps; otherwise it starts a new batch.
+        batches.clear();
+        bool moved = false;
+        for (uint32_t i = 0; i < g.drawOps.size(); ++i) {
+            const DrawOp& op = g.drawOps[i];
+            size_t target = batches.size();
+            const size_t stop = batches.size() > kReorderWindow ? batches.size() - kReorderWindow : 0;
+            for (size_t b = batches.size(); b-- > stop;) {
+                if (sameBatch(g, g.drawOps[batches[b].ops.front()], op)) {
+                    target = b;
+                    break;
+                }
+                if (extentsOverlap(batches[b].bounds, op.bounds)) break;
+            }
+            if (target == batches.size()) {
+                batches.push_back({op.bounds, {i}});
             } else {
-                ++it;
+                moved |= target + 1 != batches.size();
+                batches[target].ops.push_back(i);
+                batches[target].bounds = uniteExtents(batches[target].bounds, op.bounds);
+            }
+        }
+        if (!moved) continue;
+
+        // Rewrite the group's instance ranges in the new draw order so batched draws
+        // address contiguous instances and mergeDrawOps can fold them.
+        ordered.clear();
+        ordered.reserve(g.drawOps.size());
+        for (const Batch& b : batches) {
+            for (uint32_t i : b.ops) ordered.push_back(g.drawOps[i]);
+        }
+        auto permute = [&](auto& instances, uint32_t base, uint32_t count, DrawOpType type) {
+            using Inst = typename std::decay_t<decltype(instances)>::value_type;
+            std::vector<Inst> tmp;
+            tmp.reserve(count);
+            for (DrawOp& op : ordered) {
+                if (op.type != type) continue;
+                const uint32_t start = static_cast<uint32_t>(tmp.size());
+                tmp.insert(tmp.end(), instances.begin() + base + op.offset,
+                           instances.begin() + base + op.offset + op.count);
+                op.offset = start;
+            }
+            std::copy(tmp.begin(), tmp.end(), instances.begin() + base);
+        };
+        permute(out.rects, g.rectOffset, g.rectCount, DrawOpType::Rect);
+        permute(out.circles, g.circleOffset, g.circleCount, DrawOpType::Circle);
+        permute(out.lines, g.lineOffset, g.lineCount, DrawOpType::Line);
+        permute(out.glyphs, g.glyphOffset, g.glyphCount, DrawOpType::Glyph);
+        permute(out.pathVertices, g.pathOffset, g.pathCount, DrawOpType::Path);
+        {
+            std::vector<ImageDrawCmd> images;
+            images.reserve(g.imageDraws.size());
+            for (DrawOp& op : ordered) {
+                if (op.type != DrawOpType::Image) continue;
+                const uint32_t start = static_cast<uint32_t>(images.size());
+                for (uint32_t k = 0; k < op.count; ++k) {
+                    images.push_back(std::move(g.imageDraws[op.offset + k]));
+                }
+                op.offset = start;
+            }
+            g.imageDraws = std::move(images);
+        }
+        g.drawOps.swap(ordered);
+    }
+}
+
+void CommandCompiler::mergeDrawOps(CompiledBatches& out) {
+    for (auto& g : out.groups) {
+        if (g.drawOps.size() < 2) {
+            drawCallStats_.afterMerge += g.drawOps.size();
+            continue;
+        }
+        size_t n = 0;
+        for (size_t i = 1; i < g.drawOps.size(); ++i) {
+            DrawOp& prev = g.drawOps[n];
+            const DrawOp& op = g.drawOps[i];
+            bool mergeable = op.type == prev.type && op.offset == prev.offset + prev.count;
+            if (mergeable && op.type == DrawOpType::Glyph) {
+                mergeable = op.pageIndex == prev.pageIndex;
+            } else if (mergeable && op.type == DrawOpType::Image) {
+                const ImageDrawCmd& a = g.imageDraws[prev.offset];
+                const ImageDrawCmd& b = g.imageDraws[op.offset];
+                mergeable = a.imageId == b.imageId && a.path == b.path;
+            }
+            if (mergeable) {
+                prev.count += op.count;
+                prev.bounds = uniteExtents(prev.bounds, op.bounds);
+            } else {
+                g.drawOps[++n] = op;
             }
         }
+        g.drawOps.resize(n + 1);
+        drawCallStats_.afterMerge += g.drawOps.size();
     }
 }
 
@@ -475,7 +1264,6 @@ void CommandCompiler::transformGlyphInstance(GlyphInstance& gi) const {
     gi.screenRect[2] = w;
     gi.screenRect[3] = h;
     gi.rotation = std::atan2(current_.m10, current_.m00);
-    gi.atlasPage = 0.f;
 }
 
 void CommandCompiler::fillInstanceColors(SDFQuadInstance& inst) const {
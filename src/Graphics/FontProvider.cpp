@@ -19,4 +19,11 @@ std::optional<std::string> FontProvider::findFontPathForCodepoint(uint32_t codep
     return std::nullopt;
 }
 
+bool FontProvider::codepointLookupPending() {
+    if (auto* resolver = PlatformRegistry::instance().fontResolver()) {
+        return resolver->codepointLookupPending();
+    }
+    return false;
+}
+
 } // namespace flux
@@ -18,20 +18,18 @@ void GPURenderContext::beginFrame() {
     commandBufferPeak_ = std::max(commandBufferPeak_, ownedBuffer_.size());
     ownedBuffer_.clear();
     ownedBuffer_.reserve(commandBufferPeak_);
-    cmdBuf_ = &ownedBuffer_;
     recordingBuffer_ = &ownedBuffer_;
 }
 
 void GPURenderContext::clear(const Color& color) {
-    if (cmdBuf_) cmdBuf_->pushClear(color);
+    if (recordingBuffer_) recordingBuffer_->pushClear(color);
 }
 
 void GPURenderContext::present() {
-    RenderCommandBuffer* buf = cmdBuf_ ? cmdBuf_ : &ownedBuffer_;
+    RenderCommandBuffer* buf = recordingBuffer_ ? recordingBuffer_ : &ownedBuffer_;
     if (gpuBackend_ && !buf->empty()) {
         gpuBackend_->execute(*buf);
     }
-    cmdBuf_ = nullptr;
     recordingBuffer_ = nullptr;
 }
 
@@ -47,7 +45,7 @@ void GPURenderContext::updateDPIScale(float dpiScaleX, float dpiScaleY) {
 
 void GPURenderContext::save() {
     transformStack_.push_back(transform_);
-    if (cmdBuf_) cmdBuf_->pushSave();
+    if (recordingBuffer_) recordingBuffer_->pushSave();
 }
 
 void GPURenderContext::restore() {
@@ -55,7 +53,7 @@ void GPURenderContext::restore() {
         transform_ = transformStack_.back();
         transformStack_.pop_back();
     }
-    if (cmdBuf_) cmdBuf_->pushRestore();
+    if (recordingBuffer_) recordingBuffer_->pushRestore();
 }
 
 void GPURenderContext::reset() {
@@ -70,7 +68,7 @@ void GPURenderContext::translate(float x, float y) {
     transform_.matrix[5] += transform_.matrix[1] * x + transform_.matrix[3] * y;
     transform_.tx += x;
     transform_.ty += y;
-    if (cmdBuf_) cmdBuf_->pushTranslate(x, y);
+    if (recordingBuffer_) recordingBuffer_->pushTranslate(x, y);
 }
 
 void GPURenderContext::rotate(float angle) {
@@ -84,7 +82,7 @@ void GPURenderContext::rotate(float angle) {
     transform_.matrix[2] = -m00 * si + m01 * co;
     transform_.matrix[1] = m10 * co + m11 * si;
     transform_.matrix[3] = -m10 * si + m11 * co;
-    if (cmdBuf_) cmdBuf_->pushRotate(angle);
+    if (recordingBuffer_) recordingBuffer_->pushRotate(angle);
 }
 
 void GPURenderContext::scale(float sx, float sy) {
@@ -94,7 +92,7 @@ void GPURenderContext::scale(float sx, float sy) {
     transform_.matrix[2] *= sy;
     transform_.matrix[1] *= sx;
     transform_.matrix[3] *= sy;
-    if (cmdBuf_) cmdBuf_->pushScale(sx, sy);
+    if (recordingBuffer_) recordingBuffer_->pushScale(sx, sy);
 }
 
 void GPURenderContext::skewX(float) {}
@@ -119,7 +117,7 @@ void GPURenderContext::getTransform(float* matrix) {
 void GPURenderContext::setCompositeOperation(CompositeOperation) {}
 
 void GPURenderContext::setOpacity(float alpha) {
-    if (cmdBuf_) cmdBuf_->pushSetOpacity(alpha);
+    if (recordingBuffer_) recordingBuffer_->pushSetOpacity(alpha);
 }
 
 void GPURenderContext::setShapeAntiAlias(bool) {}
@@ -151,7 +149,7 @@ void GPURenderContext::setDashPattern(const std::vector<float>& pattern, float o
 
 void GPURenderContext::setStrokeStyle(const StrokeStyle& style) {
     currentStroke_ = style;
-    if (cmdBuf_) cmdBuf_->pushSetStrokeStyle(style);
+    if (recordingBuffer_) recordingBuffer_->pushSetStrokeStyle(style);
 }
 
 void GPURenderContext::setFillColor(const Color& color) {
@@ -164,37 +162,37 @@ void GPURenderContext::setPathWinding(PathWinding winding) {
 
 void GPURenderContext::setFillStyle(const FillStyle& style) {
     currentFill_ = style;
-    if (cmdBuf_) cmdBuf_->pushSetFillStyle(style);
+    if (recordingBuffer_) recordingBuffer_->pushSetFillStyle(style);
 }
 
 void GPURenderContext::drawPath(const Path& path) {
     if (path.isEmpty()) return;
-    if (cmdBuf_) cmdBuf_->pushDrawPath(path);
+    if (recordingBuffer_) recordingBuffer_->pushDrawPath(path);
 }
 
 void GPURenderContext::drawCircle(const Point& center, float radius) {
-    if (cmdBuf_) cmdBuf_->pushDrawCircle(center, radius);
+    if (recordingBuffer_) recordingBuffer_->pushDrawCircle(center, radius);
 }
 
 void GPURenderContext::drawLine(const Point& start, const Point& end) {
-    if (cmdBuf_) cmdBuf_->pushDrawLine(start, end);
+    if (recordingBuffer_) recordingBuffer_->pushDrawLine(start, end);
 }
 
 void GPURenderContext::drawRect(const Rect& rect, const CornerRadius& cornerRadius) {
-    if (cmdBuf_) cmdBuf_->pushDrawRect(rect, cornerRadius);
+    if (recordingBuffer_) recordingBuffer_->pushDrawRect(rect, cornerRadius);
 }
 
 void GPURenderContext::drawEllipse(const Point& center, float radiusX, float radiusY) {
     Path p;
     p.ellipse(center, radiusX, radiusY);
-    if (cmdBuf_) cmdBuf_->pushDrawPath(std::move(p));
+    if (recordingBuffer_) recordingBuffer_->pushDrawPath(std::move(p));
 }
 
 void GPURenderContext::drawArc(const Point& center, float radius,
                                 float startAngle, float endAngle, bool clockwise) {
     Path p;
     p.arc(center, radius, startAngle, endAngle, clockwise);
-    if (cmdBuf_) cmdBuf_->pushDrawPath(std::move(p));
+    if (recordingBuffer_) recordingBuffer_->pushDrawPath(std::move(p));
 }
 
 void GPURenderContext::setFont(const std::string& name, FontWeight weight) {
@@ -218,22 +216,22 @@ void GPURenderContext::setLineHeight(float height) {
 
 void GPURenderContext::setTextStyle(const TextStyle& style) {
     currentTextStyle_ = style;
-    if (cmdBuf_) cmdBuf_->pushSetTextStyle(style);
+    if (recordingBuffer_) recordingBuffer_->pushSetTextStyle(style);
 }
 
 void GPURenderContext::drawText(const std::string& text, const Point& position,
                                 HorizontalAlignment hAlign, VerticalAlignment vAlign) {
-    if (cmdBuf_) {
-        uint32_t sid = cmdBuf_->internString(std::string(text));
-        cmdBuf_->pushDrawText(sid, position, hAlign, vAlign);
+    if (recordingBuffer_) {
+        uint32_t sid = recordingBuffer_->internString(std::string(text));
+        recordingBuffer_->pushDrawText(sid, position, hAlign, vAlign);
     }
 }
 
 void GPURenderContext::drawTextBox(const std::string& text, const Point& position,
                                     float maxWidth, HorizontalAlignment hAlign) {
-    if (cmdBuf_) {
-        uint32_t sid = cmdBuf_->internString(std::string(text));
-        cmdBuf_->pushDrawTextBox(sid, position, maxWidth, hAlign);
+    if (recordingBuffer_) {
+        uint32_t sid = recordingBuffer_->internString(std::string(text));
+        recordingBuffer_->pushDrawTextBox(sid, position, maxWidth, hAlign);
     }
 }
 
@@ -277,8 +275,11 @@ Rect GPURenderContext::getTextBounds(const std::string& text, const Point& posit
     return {position.x, position.y - sz.height, sz.width, sz.height};
 }
 
+// Image loads create and destroy device textures, which the render thread may be using
+// in pipelined mode; they wait for queued frames first.
 int GPURenderContext::createImage(const std::string& filename) {
     if (!imageCache_) return 0;
+    if (gpuBackend_) gpuBackend_->finishFrames();
     return imageCache_->loadFromFile(filename);
 }
 
@@ -288,6 +289,7 @@ int GPURenderContext::createImageMem(const unsigned char*, int) {
 
 int GPURenderContext::createImageRGBA(int width, int height, const unsigned char* data) {
     if (!imageCache_) return 0;
+    if (gpuBackend_) gpuBackend_->finishFrames();
     return imageCache_->loadFromMemory(data, width, height, 4);
 }
 
@@ -298,24 +300,26 @@ Size GPURenderContext::getImageSize(int) {
 }
 
 void GPURenderContext::deleteImage(int imageId) {
-    if (imageCache_) imageCache_->removeById(imageId);
+    if (!imageCache_) return;
+    if (gpuBackend_) gpuBackend_->finishFrames();
+    imageCache_->removeById(imageId);
 }
 
 void GPURenderContext::drawImage(int imageId, const Rect& rect, ImageFit fit,
                                   const CornerRadius& cornerRadius, float alpha) {
-    if (cmdBuf_) cmdBuf_->pushDrawImage(imageId, rect, fit, cornerRadius, alpha);
+    if (recordingBuffer_) recordingBuffer_->pushDrawImage(imageId, rect, fit, cornerRadius, alpha);
 }
 
 void GPURenderContext::drawImage(const std::string& path, const Rect& rect, ImageFit fit,
                                   const CornerRadius& cornerRadius, float alpha) {
-    if (cmdBuf_) {
-        uint32_t pid = cmdBuf_->internString(std::string(path));
-        cmdBuf_->pushDrawImagePath(pid, rect, fit, cornerRadius, alpha);
+    if (recordingBuffer_) {
+        uint32_t pid = recordingBuffer_->internString(std::string(path));
+        recordingBuffer_->pushDrawImagePath(pid, rect, fit, cornerRadius, alpha);
     }
 }
 
 void GPURenderContext::clipPath(const Path& path) {
-    if (cmdBuf_) cmdBuf_->pushClipPath(path);
+    if (recordingBuffer_) recordingBuffer_->pushClipPath(path);
 }
 
 void GPURenderContext::resetClip() {}
@@ -346,11 +350,12 @@ void GPURenderContext::setCurrentFocusKey(const std::string& focusKey) {
 }
 
 std::string GPURenderContext::getFocusedKey() const {
+    noteInteractionRead(!currentViewFocusKey_.empty() && currentViewFocusKey_ == globalFocusedKey_);
     return globalFocusedKey_;
 }
 
 bool GPURenderContext::isCurrentViewFocused() const {
-    return !currentViewFocusKey_.empty() && currentViewFocusKey_ == globalFocusedKey_;
+    return noteInteractionRead(!currentViewFocusKey_.empty() && currentViewFocusKey_ == globalFocusedKey_);
 }
 
 void GPURenderContext::setHoveredBounds(const Rect& bounds) {
@@ -363,11 +368,11 @@ void GPURenderContext::setCurrentViewGlobalBounds(const Rect& bounds) {
 }
 
 bool GPURenderContext::isCurrentViewHovered() const {
-    if (!hasHovered_) return false;
-    return currentViewBounds_.x == hoveredBounds_.x &&
-           currentViewBounds_.y == hoveredBounds_.y &&
-           currentViewBounds_.width == hoveredBounds_.width &&
-           currentViewBounds_.height == hoveredBounds_.height;
+    return noteInteractionRead(hasHovered_ &&
+                               currentViewBounds_.x == hoveredBounds_.x &&
+                               currentViewBounds_.y == hoveredBounds_.y &&
+                               currentViewBounds_.width == hoveredBounds_.width &&
+                               currentViewBounds_.height == hoveredBounds_.height);
 }
 
 void GPURenderContext::setPressedBounds(const Rect& bounds) {
@@ -380,11 +385,11 @@ void GPURenderContext::clearPressedBounds() {
 }
 
 bool GPURenderContext::isCurrentViewPressed() const {
-    if (!hasPressed_) return false;
-    return currentViewBounds_.x == pressedBounds_.x &&
-           currentViewBounds_.y == pressedBounds_.y &&
-           currentViewBounds_.width == pressedBounds_.width &&
-           currentViewBounds_.height == pressedBounds_.height;
+    return noteInteractionRead(hasPressed_ &&
+                               currentViewBounds_.x == pressedBounds_.x &&
+                               currentViewBounds_.y == pressedBounds_.y &&
+                               currentViewBounds_.width == pressedBounds_.width &&
+                               currentViewBounds_.height == pressedBounds_.height);
 }
 
 } // namespace flux
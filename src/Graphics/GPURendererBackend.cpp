@@ -2,7 +2,9 @@
 #include <Flux/Platform/PathUtil.hpp>
 #include <Flux/Platform/PlatformRegistry.hpp>
 #include <cstring>
+#include <cmath>
 #include <algorithm>
+#include <bit>
 #include <fstream>
 #include <span>
 #include <string_view>
@@ -59,22 +61,77 @@ static constexpr float kQuadVertices[] = {
 
 GPURendererBackend::GPURendererBackend(gpu::Device* device)
     : device_(device)
+    , frameRing_(device)
 {
     glyphAtlas_ = std::make_unique<GlyphAtlas>(device_);
     imageCache_ = std::make_unique<ImageCache>(device_);
     compiler_.setGlyphAtlas(glyphAtlas_.get());
 }
 
+GPURendererBackend::~GPURendererBackend() {
+    setPipelined(false);
+}
+
 void GPURendererBackend::setViewportSize(float width, float height) {
+    finishFrames();
     viewportWidth_ = width;
     viewportHeight_ = height;
 }
 
 void GPURendererBackend::setDPIScale(float scaleX, float scaleY) {
+    finishFrames();
     dpiScaleX_ = scaleX;
     dpiScaleY_ = scaleY;
 }
 
+void GPURendererBackend::setCompileThreads(size_t threads) {
+    finishFrames();
+    // Compiling and drawing take turns on the rendering thread, so a device's own CPU
+    // workers (the software rasterizer's) can compile too.
+    std::shared_ptr<ThreadPool> devicePool = threads > 0 ? device_->workerPool() : nullptr;
+    if (devicePool) {
+        compiler_.setWorkerPool(std::move(devicePool));
+    } else {
+        compiler_.setWorkerThreads(threads);
+    }
+}
+
+void GPURendererBackend::setPipelined(bool enabled) {
+    if (enabled == pipelined()) return;
+    if (enabled) {
+        stopRenderThread_ = false;
+        renderThread_ = std::thread([this]() { renderThreadLoop(); });
+        return;
+    }
+    {
+        std::lock_guard lock(queueMutex_);
+        stopRenderThread_ = true;
+    }
+    frameQueued_.notify_one();
+    renderThread_.join(); // submits what is still queued first
+}
+
+void GPURendererBackend::finishFrames() {
+    if (!pipelined()) return;
+    std::unique_lock lock(queueMutex_);
+    frameDone_.wait(lock, [this]() { return queuedCount_ == 0; });
+}
+
+void GPURendererBackend::renderThreadLoop() {
+    std::unique_lock lock(queueMutex_);
+    for (;;) {
+        frameQueued_.wait(lock, [this]() { return queuedCount_ > 0 || stopRenderThread_; });
+        if (queuedCount_ == 0) return;
+        const RenderCommandBuffer& frame = queuedFrames_[queueHead_];
+        lock.unlock();
+        executeFrame(frame);
+        lock.lock();
+        queueHead_ = (queueHead_ + 1) % kFrames;
+        --queuedCount_;
+        frameDone_.notify_all();
+    }
+}
+
 void GPURendererBackend::ensureQuadVertexBuffer() {
     if (quadVB_) return;
     gpu::BufferDesc desc;
@@ -153,8 +210,10 @@ void GPURendererBackend::ensurePipelines() {
         return s;
     };
 
-    auto makePipeline = [&](std::string_view fragMSL, std::span<const uint8_t> fragSPV) {
+    auto makePipeline = [&](gpu::ShaderProgram program, std::string_view fragMSL,
+                            std::span<const uint8_t> fragSPV) {
         gpu::RenderPipelineDesc desc;
+        desc.program = program;
         desc.vertexShader = makeShaderSrc(vertMSLStr, vertSPV);
         desc.fragmentShader = makeShaderSrc(fragMSL, fragSPV);
         desc.vertexFunction = "main0";
@@ -165,10 +224,11 @@ void GPURendererBackend::ensurePipelines() {
         return device_->createRenderPipeline(desc);
     };
 
-    rectPipeline_ = makePipeline(rectMSLStr, rectSPV);
-    circlePipeline_ = makePipeline(circleMSLStr, circleSPV);
+    rectPipeline_ = makePipeline(gpu::ShaderProgram::SDFRect, rectMSLStr, rectSPV);
+    circlePipeline_ = makePipeline(gpu::ShaderProgram::SDFCircle, circleMSLStr, circleSPV);
     {
         gpu::RenderPipelineDesc lineDesc;
+        lineDesc.program = gpu::ShaderProgram::SDFLine;
         lineDesc.vertexShader = makeShaderSrc(lineVertMSLStr, lineVertSPV);
         lineDesc.fragmentShader = makeShaderSrc(lineMSLStr, lineSPV);
         lineDesc.vertexFunction = "main0";
@@ -185,6 +245,8 @@ void GPURendererBackend::ensurePipelines() {
     const std::string_view glyphFragMSL = flux::gpu::embedded::msl_glyph_frag_glsl();
     const auto glyphVertSPV = flux::gpu::embedded::spv_glyph_vert_glsl();
     const auto glyphFragSPV = flux::gpu::embedded::spv_glyph_frag_glsl();
+    const std::string_view glyphSdfFragMSL = flux::gpu::embedded::msl_glyph_sdf_frag_glsl();
+    const auto glyphSdfFragSPV = flux::gpu::embedded::spv_glyph_sdf_frag_glsl();
 #else
     static const std::string glyphVertMSLStored = readFileStr("glyph.vert.glsl.metal");
     static const std::string glyphFragMSLStored = readFileStr("glyph.frag.glsl.metal");
@@ -194,6 +256,10 @@ void GPURendererBackend::ensurePipelines() {
     static const std::vector<uint8_t> glyphFragSPVStored = readFileBin("glyph.frag.glsl.spv");
     const std::span<const uint8_t> glyphVertSPV = glyphVertSPVStored;
     const std::span<const uint8_t> glyphFragSPV = glyphFragSPVStored;
+    static const std::string glyphSdfFragMSLStored = readFileStr("glyph_sdf.frag.glsl.metal");
+    const std::string_view glyphSdfFragMSL = glyphSdfFragMSLStored;
+    static const std::vector<uint8_t> glyphSdfFragSPVStored = readFileBin("glyph_sdf.frag.glsl.spv");
+    const std::span<const uint8_t> glyphSdfFragSPV = glyphSdfFragSPVStored;
 #endif
 
     gpu::VertexBufferLayout glyphInstLayout;
@@ -207,17 +273,22 @@ void GPURendererBackend::ensurePipelines() {
         {5, 56, gpu::VertexFormat::Float4},  // rotation + pad
     };
 
-    {
+    auto makeGlyphPipeline = [&](gpu::ShaderProgram program, std::string_view fragMSL,
+                                 std::span<const uint8_t> fragSPV) {
         gpu::RenderPipelineDesc desc;
+        desc.program = program;
         desc.vertexShader = makeShaderSrc(glyphVertMSL, glyphVertSPV);
-        desc.fragmentShader = makeShaderSrc(glyphFragMSL, glyphFragSPV);
+        desc.fragmentShader = makeShaderSrc(fragMSL, fragSPV);
         desc.vertexFunction = "main0";
         desc.fragmentFunction = "main0";
         desc.vertexBuffers = {vertLayout, glyphInstLayout};
         desc.colorFormat = device_->swapchainFormat();
         desc.blendEnabled = true;
-        glyphPipeline_ = device_->createRenderPipeline(desc);
-    }
+        return device_->createRenderPipeline(desc);
+    };
+    glyphPipeline_ = makeGlyphPipeline(gpu::ShaderProgram::Glyph, glyphFragMSL, glyphFragSPV);
+    glyphSdfPipeline_ = makeGlyphPipeline(gpu::ShaderProgram::GlyphSDF, glyphSdfFragMSL,
+                                          glyphSdfFragSPV);
 
     // Path pipeline — non-instanced, per-vertex color
 #if defined(FLUX_HAS_EMBEDDED_SHADERS)
@@ -247,6 +318,7 @@ void GPURendererBackend::ensurePipelines() {
         };
 
         gpu::RenderPipelineDesc desc;
+        desc.program = gpu::ShaderProgram::Path;
         desc.vertexShader = makeShaderSrc(pathVertMSL, pathVertSPV);
         desc.fragmentShader = makeShaderSrc(pathFragMSL, pathFragSPV);
         desc.vertexFunction = "main0";
@@ -287,6 +359,7 @@ void GPURendererBackend::ensurePipelines() {
         };
 
         gpu::RenderPipelineDesc desc;
+        desc.program = gpu::ShaderProgram::Image;
         desc.vertexShader = makeShaderSrc(imageVertMSL, imageVertSPV);
         desc.fragmentShader = makeShaderSrc(imageFragMSL, imageFragSPV);
         desc.vertexFunction = "main0";
@@ -300,25 +373,6 @@ void GPURendererBackend::ensurePipelines() {
     pipelinesReady_ = true;
 }
 
-/// Grow GPU vertex buffer for instance data: high-water with slack to reduce realloc spikes.
-template<typename T>
-static void ensureInstanceBuffer(gpu::Device* device, std::unique_ptr<gpu::Buffer>& buf,
-                                 size_t& capacity, size_t needed, size_t minCapacity = 64) {
-    if (needed == 0) return;
-    if (!buf || capacity < needed) {
-        const size_t oldCap = capacity;
-        size_t newCap = std::max(needed, minCapacity);
-        if (oldCap > 0) {
-            newCap = std::max(needed, oldCap + (oldCap >> 1));
-        }
-        capacity = newCap;
-        gpu::BufferDesc desc;
-        desc.size = capacity * sizeof(T);
-        desc.usage = gpu::BufferUsage::Vertex;
-        buf = device->createBuffer(desc);
-    }
-}
-
 static gpu::Texture* resolveImageTexture(ImageCache* cache, const ImageDrawCmd& d) {
     if (!cache) return nullptr;
     if (!d.path.empty()) return cache->getOrLoad(d.path);
@@ -326,66 +380,287 @@ static gpu::Texture* resolveImageTexture(ImageCache* cache, const ImageDrawCmd&
     return nullptr;
 }
 
-static void ensureImageInstanceBuffer(gpu::Device* device,
-                                      std::unique_ptr<gpu::Buffer>& buf,
-                                      size_t& capacity, size_t needed) {
-    ensureInstanceBuffer<ImageInstance>(device, buf, capacity, needed, 16);
+void GPURendererBackend::execute(const RenderCommandBuffer& buffer) {
+    if (!pipelined()) {
+        executeFrame(buffer);
+        return;
+    }
+    std::unique_lock lock(queueMutex_);
+    frameDone_.wait(lock, [this]() { return queuedCount_ < kFrames; });
+    const uint32_t slot = (queueHead_ + queuedCount_) % kFrames;
+    lock.unlock();
+    queuedFrames_[slot] = buffer;
+    lock.lock();
+    ++queuedCount_;
+    frameQueued_.notify_one();
 }
 
-void GPURendererBackend::execute(const RenderCommandBuffer& buffer) {
+void GPURendererBackend::executeFrame(const RenderCommandBuffer& buffer) {
     if (viewportWidth_ <= 0 || viewportHeight_ <= 0) return;
 
     ensurePipelines();
+    if (glyphAtlas_) glyphAtlas_->beginFrame();
+
+    // Unchanged commands at the same atlas generation redraw from the streams on the GPU.
+    const uint64_t atlasGeneration = glyphAtlas_ ? glyphAtlas_->generation() : 0;
+    const bool unchanged = hasCompiled_ &&
+        compiledViewport_[0] == viewportWidth_ && compiledViewport_[1] == viewportHeight_ &&
+        compiledDpiScale_[0] == dpiScaleX_ && compiledDpiScale_[1] == dpiScaleY_ &&
+        compiledAtlasGeneration_ == atlasGeneration &&
+        buffer.contentEquals(compiledBuffer_);
+    if (unchanged) {
+        ++skippedCompiles_;
+        uploadAndDraw(compiledBatches_[compiledIndex_], true);
+        return;
+    }
 
+    const uint32_t previous = compiledIndex_;
+    compiledIndex_ ^= 1;
+    CompiledBatches& batches = compiledBatches_[compiledIndex_];
     compiler_.compile(buffer, viewportWidth_, viewportHeight_,
-                      dpiScaleX_, dpiScaleY_, compiledBatches_);
-    uploadAndDraw(compiledBatches_);
+                      dpiScaleX_, dpiScaleY_, batches);
+    if (glyphAtlas_ && glyphAtlas_->reclaimColdPages()) {
+        // Glyphs that did not fit dropped out of this compile; the reclaimed pages have room
+        // for them, and output cached from before points into those pages.
+        compiler_.compile(buffer, viewportWidth_, viewportHeight_,
+                          dpiScaleX_, dpiScaleY_, batches);
+    }
+
+    ImageStream& images = imageStreams_[compiledIndex_];
+    images.instances.clear();
+    images.groupBase.clear();
+    for (const auto& group : batches.groups) {
+        images.groupBase.push_back(static_cast<uint32_t>(images.instances.size()));
+        for (const auto& draw : group.imageDraws) images.instances.push_back(draw.instance);
+    }
+
+    identifyStreams(hasCompiled_ ? previous : compiledIndex_);
+    compiledBuffer_ = buffer;
+    compiledViewport_[0] = viewportWidth_;
+    compiledViewport_[1] = viewportHeight_;
+    compiledDpiScale_[0] = dpiScaleX_;
+    compiledDpiScale_[1] = dpiScaleY_;
+    compiledAtlasGeneration_ = glyphAtlas_ ? glyphAtlas_->generation() : 0;
+    hasCompiled_ = true;
+
+    uploadAndDraw(batches, false);
+}
+
+std::span<const uint8_t> GPURendererBackend::streamBytes(uint32_t index, int stream) const {
+    const CompiledBatches& b = compiledBatches_[index];
+    auto bytes = [](const auto& v) {
+        return std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(v.data()),
+                                        v.size() * sizeof(v[0]));
+    };
+    switch (stream) {
+        case kRectStream: return bytes(b.rects);
+        case kCircleStream: return bytes(b.circles);
+        case kLineStream: return bytes(b.lines);
+        case kGlyphStream: return bytes(b.glyphs);
+        case kPathStream: return bytes(b.pathVertices);
+        case kImageStream: return bytes(imageStreams_[index].instances);
+    }
+    return {};
+}
+
+void GPURendererBackend::identifyStreams(uint32_t previous) {
+    for (int s = 0; s < kStreamCount; ++s) {
+        const auto now = streamBytes(compiledIndex_, s);
+        const auto before = streamBytes(previous, s);
+        const bool same = previous != compiledIndex_ && streamContent_[s] != 0 &&
+                          now.size() == before.size() &&
+                          std::memcmp(now.data(), before.data(), now.size()) == 0;
+        if (!same) streamContent_[s] = nextContentId_++;
+    }
 }
 
-void GPURendererBackend::uploadAndDraw(const CompiledBatches& batches) {
-    if (!device_->beginFrame()) return;
+void GPURendererBackend::layoutStreamSlot(StreamSlot& slot) {
+    // Each region has room for its stream to double before the slot is laid out again.
+    size_t total = 0;
+    for (int s = 0; s < kStreamCount; ++s) {
+        slot.regionOffset[s] = total;
+        slot.regionSize[s] =
+            std::bit_ceil(std::max(kMinStreamRegion, streamBytes(compiledIndex_, s).size()));
+        slot.content[s] = 0;
+        total += slot.regionSize[s];
+    }
+    gpu::BufferDesc desc;
+    desc.size = total;
+    desc.usage = gpu::BufferUsage::Vertex;
+    slot.buffer = device_->createBuffer(desc);
+    slot.mapped = static_cast<uint8_t*>(slot.buffer->mappedData());
+    // Zero the buffer so the copy kept for diffing matches it from the start.
+    slot.held.assign(total, 0);
+    if (slot.mapped) {
+        std::memset(slot.mapped, 0, total);
+        slot.buffer->flushMapped(0, total);
+    } else {
+        slot.buffer->write(slot.held.data(), total);
+    }
+}
 
-    auto& fb = frameBuffers_[device_->currentFrameIndex()];
+void GPURendererBackend::bindStreams() {
+    // Device::beginFrame() has waited for the GPU to finish with this slot's buffer.
+    StreamSlot& slot = streamSlots_[device_->currentFrameIndex() % kFrames];
+    bool fits = slot.buffer != nullptr;
+    for (int s = 0; s < kStreamCount && fits; ++s) {
+        fits = streamBytes(compiledIndex_, s).size() <= slot.regionSize[s];
+    }
+    if (!fits) layoutStreamSlot(slot);
+
+    streamBuffer_ = slot.buffer.get();
+    streamBytesCopied_ = 0;
+    for (int s = 0; s < kStreamCount; ++s) {
+        const auto data = streamBytes(compiledIndex_, s);
+        streamOffsets_[s] = slot.regionOffset[s];
+        streamBound_[s] = !data.empty();
+        if (data.empty() || slot.content[s] == streamContent_[s]) continue;
+
+        uint8_t* held = slot.held.data() + slot.regionOffset[s];
+        auto blockDiffers = [&](size_t at) {
+            return std::memcmp(held + at, data.data() + at,
+                               std::min(kStreamDiffBlock, data.size() - at)) != 0;
+        };
+        for (size_t at = 0; at < data.size();) {
+            if (!blockDiffers(at)) {
+                at += kStreamDiffBlock;
+                continue;
+            }
+            // Copy each run of differing blocks as one range.
+            size_t end = at + kStreamDiffBlock;
+            while (end < data.size() && blockDiffers(end)) end += kStreamDiffBlock;
+            end = std::min(end, data.size());
+            const size_t size = end - at;
+            const size_t offset = slot.regionOffset[s] + at;
+            std::memcpy(held + at, data.data() + at, size);
+            if (slot.mapped) {
+                std::memcpy(slot.mapped + offset, data.data() + at, size);
+                slot.buffer->flushMapped(offset, size);
+            } else {
+                slot.buffer->write(held + at, size, offset);
+            }
+            streamBytesCopied_ += size;
+            at = end;
+        }
+        slot.content[s] = streamContent_[s];
+    }
+}
 
-    ensureInstanceBuffer<SDFQuadInstance>(device_, fb.rect, fb.rectCap, batches.rects.size());
-    ensureInstanceBuffer<SDFQuadInstance>(device_, fb.circle, fb.circleCap, batches.circles.size());
-    ensureInstanceBuffer<SDFQuadInstance>(device_, fb.line, fb.lineCap, batches.lines.size());
+/// Snaps damage rects outward to whole pixels inside the viewport and merges overlapping
+/// ones. Returns false when the region is better drawn as a full frame.
+static bool mergeRedrawRects(std::vector<Rect>& rects, float vpW, float vpH) {
+    constexpr size_t kMaxRects = 8;
+    constexpr float kMaxCoverage = 0.6f;
+
+    size_t n = 0;
+    for (const Rect& r : rects) {
+        const float x0 = std::floor(std::max(0.f, r.x));
+        const float y0 = std::floor(std::max(0.f, r.y));
+        const float x1 = std::ceil(std::min(vpW, r.x + r.width));
+        const float y1 = std::ceil(std::min(vpH, r.y + r.height));
+        if (x1 > x0 && y1 > y0) rects[n++] = {x0, y0, x1 - x0, y1 - y0};
+    }
+    rects.resize(n);
 
-    if (!batches.rects.empty())
-        fb.rect->write(batches.rects.data(), batches.rects.size() * sizeof(SDFQuadInstance));
-    if (!batches.circles.empty())
-        fb.circle->write(batches.circles.data(), batches.circles.size() * sizeof(SDFQuadInstance));
-    if (!batches.lines.empty())
-        fb.line->write(batches.lines.data(), batches.lines.size() * sizeof(SDFQuadInstance));
+    auto unite = [](const Rect& a, const Rect& b) {
+        const float x0 = std::min(a.x, b.x), y0 = std::min(a.y, b.y);
+        const float x1 = std::max(a.x + a.width, b.x + b.width);
+        const float y1 = std::max(a.y + a.height, b.y + b.height);
+        return Rect{x0, y0, x1 - x0, y1 - y0};
+    };
+    auto touches = [](const Rect& a, const Rect& b) {
+        return a.x <= b.x + b.width && b.x <= a.x + a.width &&
+               a.y <= b.y + b.height && b.y <= a.y + a.height;
+    };
 
-    if (!batches.glyphs.empty() && glyphAtlas_) {
-        glyphAtlas_->uploadIfDirty();
-        ensureInstanceBuffer<GlyphInstance>(device_, fb.glyph, fb.glyphCap, batches.glyphs.size());
-        fb.glyph->write(batches.glyphs.data(), batches.glyphs.size() * sizeof(GlyphInstance));
+    if (rects.size() > kMaxRects * 8) {
+        for (size_t i = 1; i < rects.size(); ++i) rects[0] = unite(rects[0], rects[i]);
+        rects.resize(1);
+    }
+    for (bool merged = true; merged;) {
+        merged = false;
+        for (size_t i = 0; i < rects.size() && !merged; ++i) {
+            for (size_t j = i + 1; j < rects.size(); ++j) {
+                if (touches(rects[i], rects[j])) {
+                    rects[i] = unite(rects[i], rects[j]);
+                    rects.erase(rects.begin() + static_cast<ptrdiff_t>(j));
+                    merged = true;
+                    break;
+                }
+            }
+        }
+    }
+    if (rects.size() > kMaxRects) {
+        for (size_t i = 1; i < rects.size(); ++i) rects[0] = unite(rects[0], rects[i]);
+        rects.resize(1);
     }
 
-    if (!batches.pathVertices.empty()) {
-        const size_t pathCount = batches.pathVertices.size();
-        ensureInstanceBuffer<PathVertex>(device_, fb.path, fb.pathCap, pathCount, 256);
-        fb.path->write(batches.pathVertices.data(), pathCount * sizeof(PathVertex));
+    float area = 0;
+    for (const Rect& r : rects) area += r.width * r.height;
+    return area <= kMaxCoverage * vpW * vpH;
+}
+
+bool GPURendererBackend::planPartialRedraw(const CompiledBatches& batches, bool unchanged) {
+    // The back buffer is missing this frame's damage and that of the age - 1 frames
+    // presented since it was last on screen. A frame redrawn unchanged has no damage.
+    const uint32_t age = device_->bufferAge();
+    const bool fullDamage = batches.fullDamage && !unchanged;
+    bool partial = !fullDamage && age > 0 && age <= damageHistoryCount_ + 1 &&
+                   batches.clearColor.a >= 1.f;
+    if (partial) {
+        redrawRects_.clear();
+        if (!unchanged) redrawRects_.assign(batches.damage.begin(), batches.damage.end());
+        for (uint32_t i = 0; i + 1 < age; ++i) {
+            const auto& past = damageHistory_[(damageHistoryHead_ + kDamageHistory - i) % kDamageHistory];
+            redrawRects_.insert(redrawRects_.end(), past.begin(), past.end());
+        }
+        partial = mergeRedrawRects(redrawRects_, viewportWidth_, viewportHeight_);
     }
 
-    gpu::RenderPassDesc passDesc;
-    passDesc.clearColor = batches.clearColor;
-    auto* enc = device_->beginRenderPass(passDesc);
-    if (!enc) { device_->endFrame(); return; }
+    damageHistoryHead_ = (damageHistoryHead_ + 1) % kDamageHistory;
+    auto& slot = damageHistory_[damageHistoryHead_];
+    if (fullDamage) {
+        slot.assign(1, Rect{0, 0, viewportWidth_, viewportHeight_});
+    } else if (unchanged) {
+        slot.clear();
+    } else {
+        slot.assign(batches.damage.begin(), batches.damage.end());
+    }
+    damageHistoryCount_ = std::min(damageHistoryCount_ + 1, kDamageHistory);
+    return partial;
+}
 
+void GPURendererBackend::drawGroups(gpu::RenderPassEncoder* enc, const CompiledBatches& batches,
+                                    const Rect* clip) {
+    const ImageStream& images = imageStreams_[compiledIndex_];
     uint32_t vpW = static_cast<uint32_t>(viewportWidth_);
     uint32_t vpH = static_cast<uint32_t>(viewportHeight_);
 
-    for (const auto& group : batches.groups) {
-        // Set scissor for this group
+    for (size_t gi = 0; gi < batches.groups.size(); ++gi) {
+        const auto& group = batches.groups[gi];
+        // Set scissor for this group, limited to the redrawn rect
+        float sx = 0, sy = 0, sw = viewportWidth_, sh = viewportHeight_;
         if (group.scissor.active) {
+            sx = group.scissor.x;
+            sy = group.scissor.y;
+            sw = group.scissor.width;
+            sh = group.scissor.height;
+        }
+        if (clip) {
+            const float x1 = std::min(sx + sw, clip->x + clip->width);
+            const float y1 = std::min(sy + sh, clip->y + clip->height);
+            sx = std::max(sx, clip->x);
+            sy = std::max(sy, clip->y);
+            sw = x1 - sx;
+            sh = y1 - sy;
+            if (sw <= 0 || sh <= 0) continue;
+        }
+        if (group.scissor.active || clip) {
             enc->setScissorRect(
-                static_cast<uint32_t>(group.scissor.x),
-                static_cast<uint32_t>(group.scissor.y),
-                static_cast<uint32_t>(std::max(0.0f, group.scissor.width)),
-                static_cast<uint32_t>(std::max(0.0f, group.scissor.height)));
+                static_cast<uint32_t>(std::max(0.0f, sx)),
+                static_cast<uint32_t>(std::max(0.0f, sy)),
+                static_cast<uint32_t>(std::max(0.0f, sw)),
+                static_cast<uint32_t>(std::max(0.0f, sh)));
         } else {
             enc->setScissorRect(0, 0, vpW, vpH);
         }
@@ -393,35 +668,45 @@ void GPURendererBackend::uploadAndDraw(const CompiledBatches& batches) {
         // Draw in command order (batch consecutive image ops that share the same texture)
         for (size_t i = 0; i < group.drawOps.size();) {
             const auto& op = group.drawOps[i];
+            if (clip && (op.bounds.x >= sx + sw || op.bounds.x + op.bounds.width <= sx ||
+                         op.bounds.y >= sy + sh || op.bounds.y + op.bounds.height <= sy)) {
+                ++i;
+                continue;
+            }
             switch (op.type) {
                 case DrawOpType::Rect:
+                    if (!streamBound_[kRectStream]) { ++i; break; }
                     enc->setPipeline(rectPipeline_.get());
                     enc->setVertexBuffer(0, quadVB_.get());
-                    enc->setVertexBuffer(1, fb.rect.get());
+                    enc->setVertexBuffer(1, streamBuffer_, streamOffsets_[kRectStream]);
                     enc->draw(6, op.count, 0, group.rectOffset + op.offset);
                     ++i;
                     break;
                 case DrawOpType::Circle:
+                    if (!streamBound_[kCircleStream]) { ++i; break; }
                     enc->setPipeline(circlePipeline_.get());
                     enc->setVertexBuffer(0, quadVB_.get());
-                    enc->setVertexBuffer(1, fb.circle.get());
+                    enc->setVertexBuffer(1, streamBuffer_, streamOffsets_[kCircleStream]);
                     enc->draw(6, op.count, 0, group.circleOffset + op.offset);
                     ++i;
                     break;
                 case DrawOpType::Line:
+                    if (!streamBound_[kLineStream]) { ++i; break; }
                     enc->setPipeline(linePipeline_.get());
                     enc->setVertexBuffer(0, quadVB_.get());
-                    enc->setVertexBuffer(1, fb.line.get());
+                    enc->setVertexBuffer(1, streamBuffer_, streamOffsets_[kLineStream]);
                     enc->draw(6, op.count, 0, group.lineOffset + op.offset);
                     ++i;
                     break;
                 case DrawOpType::Glyph:
-                    if (glyphAtlas_ && op.count > 0) {
+                    if (glyphAtlas_ && streamBound_[kGlyphStream] && op.count > 0) {
                         auto* pageTex = glyphAtlas_->texture(op.pageIndex);
                         if (pageTex) {
-                            enc->setPipeline(glyphPipeline_.get());
+                            enc->setPipeline(GlyphAtlas::isSdfPage(op.pageIndex)
+                                                 ? glyphSdfPipeline_.get()
+                                                 : glyphPipeline_.get());
                             enc->setVertexBuffer(0, quadVB_.get());
-                            enc->setVertexBuffer(1, fb.glyph.get());
+                            enc->setVertexBuffer(1, streamBuffer_, streamOffsets_[kGlyphStream]);
                             enc->setFragmentTexture(0, pageTex);
                             enc->draw(6, op.count, 0, group.glyphOffset + op.offset);
                         }
@@ -429,9 +714,9 @@ void GPURendererBackend::uploadAndDraw(const CompiledBatches& batches) {
                     ++i;
                     break;
                 case DrawOpType::Path:
-                    if (op.count > 0) {
+                    if (streamBound_[kPathStream] && op.count > 0) {
                         enc->setPipeline(pathPipeline_.get());
-                        enc->setVertexBuffer(0, fb.path.get());
+                        enc->setVertexBuffer(0, streamBuffer_, streamOffsets_[kPathStream]);
                         enc->draw(op.count, 1, group.pathOffset + op.offset, 0);
                     }
                     ++i;
@@ -447,37 +732,107 @@ void GPURendererBackend::uploadAndDraw(const CompiledBatches& batches) {
                         ++i;
                         break;
                     }
-                    imageBatchScratch_.clear();
-                    imageBatchScratch_.push_back(draw0.instance);
+                    // A merged op covers op.count consecutive draws of the same image; following
+                    // ops that continue the run with the same texture join the draw.
+                    size_t runEnd = std::min<size_t>(op.offset + op.count, group.imageDraws.size());
                     size_t j = i + 1;
                     while (j < group.drawOps.size() &&
                            group.drawOps[j].type == DrawOpType::Image) {
                         const auto& oj = group.drawOps[j];
-                        if (oj.offset >= group.imageDraws.size()) break;
+                        if (oj.offset != runEnd || oj.offset >= group.imageDraws.size()) break;
                         const auto& dj = group.imageDraws[oj.offset];
                         gpu::Texture* tj = resolveImageTexture(imageCache_.get(), dj);
                         if (tj != tex) break;
-                        imageBatchScratch_.push_back(dj.instance);
+                        runEnd = std::min<size_t>(oj.offset + oj.count, group.imageDraws.size());
                         ++j;
                     }
-                    const uint32_t instCount = static_cast<uint32_t>(imageBatchScratch_.size());
-                    ensureImageInstanceBuffer(device_, fb.image, fb.imageCap,
-                                              imageBatchScratch_.size());
-                    fb.image->write(imageBatchScratch_.data(),
-                                    imageBatchScratch_.size() * sizeof(ImageInstance));
-                    enc->setPipeline(imagePipeline_.get());
-                    enc->setVertexBuffer(0, quadVB_.get());
-                    enc->setVertexBuffer(1, fb.image.get());
-                    enc->setFragmentTexture(0, tex);
-                    enc->draw(6, instCount);
+                    if (streamBound_[kImageStream]) {
+                        enc->setPipeline(imagePipeline_.get());
+                        enc->setVertexBuffer(0, quadVB_.get());
+                        enc->setVertexBuffer(1, streamBuffer_, streamOffsets_[kImageStream]);
+                        enc->setFragmentTexture(0, tex);
+                        enc->draw(6, static_cast<uint32_t>(runEnd - op.offset), 0,
+                                  images.groupBase[gi] + op.offset);
+                    }
                     i = j;
                     break;
                 }
             }
         }
     }
+}
+
+void GPURendererBackend::uploadAndDraw(const CompiledBatches& batches, bool unchanged) {
+    if (!device_->beginFrame()) {
+        // This frame's damage never reaches the screen; redraw in full next time.
+        damageHistoryCount_ = 0;
+        return;
+    }
+
+    frameRing_.beginFrame();
+    damageClearSlice_ = {};
+    if (!batches.glyphs.empty() && glyphAtlas_) {
+        for (const auto& group : batches.groups) {
+            for (const auto& op : group.drawOps) {
+                if (op.type == DrawOpType::Glyph) glyphAtlas_->markPageUsed(op.pageIndex);
+            }
+        }
+        glyphAtlas_->uploadIfDirty();
+    }
+    bindStreams();
+
+    const bool partial = planPartialRedraw(batches, unchanged);
+
+    if (partial && !redrawRects_.empty()) {
+        // Clear each damaged rect back to the clear color before redrawing it. The quads
+        // overhang the rects; the scissor set per rect keeps the clear inside it.
+        damageClearQuads_.clear();
+        for (const Rect& r : redrawRects_) {
+            SDFQuadInstance q{};
+            q.rect[0] = r.x - 2.f;
+            q.rect[1] = r.y - 2.f;
+            q.rect[2] = r.width + 4.f;
+            q.rect[3] = r.height + 4.f;
+            q.fillColor[0] = batches.clearColor.r;
+            q.fillColor[1] = batches.clearColor.g;
+            q.fillColor[2] = batches.clearColor.b;
+            q.fillColor[3] = batches.clearColor.a;
+            q.opacity = 1.f;
+            q.viewport[0] = viewportWidth_;
+            q.viewport[1] = viewportHeight_;
+            damageClearQuads_.push_back(q);
+        }
+        damageClearSlice_ = frameRing_.upload(damageClearQuads_);
+    }
+
+    gpu::RenderPassDesc passDesc;
+    passDesc.clearColor = batches.clearColor;
+    passDesc.loadAction = partial ? gpu::LoadAction::Load : gpu::LoadAction::Clear;
+    auto* enc = device_->beginRenderPass(passDesc);
+    if (!enc) {
+        damageHistoryCount_ = 0;
+        frameRing_.flush();
+        device_->endFrame();
+        return;
+    }
+
+    if (!partial) {
+        drawGroups(enc, batches, nullptr);
+    } else {
+        for (size_t k = 0; k < redrawRects_.size(); ++k) {
+            const Rect& r = redrawRects_[k];
+            enc->setScissorRect(static_cast<uint32_t>(r.x), static_cast<uint32_t>(r.y),
+                                static_cast<uint32_t>(r.width), static_cast<uint32_t>(r.height));
+            enc->setPipeline(rectPipeline_.get());
+            enc->setVertexBuffer(0, quadVB_.get());
+            enc->setVertexBuffer(1, damageClearSlice_.buffer, damageClearSlice_.offset);
+            enc->draw(6, 1, 0, static_cast<uint32_t>(k));
+            drawGroups(enc, batches, &r);
+        }
+    }
 
     device_->endRenderPass();
+    frameRing_.flush();
     device_->endFrame();
 }
 
@@ -1,4 +1,6 @@
 #include <Flux/Graphics/GlyphAtlas.hpp>
+#include FT_OUTLINE_H
+#include FT_MODULE_H
 #include <Flux/GPU/Types.hpp>
 #include <cmath>
 #include <cstring>
@@ -34,31 +36,78 @@ void utf8ForEach(const std::string& text, Fn&& fn) {
     }
 }
 
+thread_local GlyphAtlas::LookupOnlyScope* tlsLookupOnly = nullptr;
+
+// FT_RENDER_MODE_SDF arrived in FreeType 2.11; older versions draw every size from bitmaps.
+#if FREETYPE_MAJOR > 2 || (FREETYPE_MAJOR == 2 && FREETYPE_MINOR >= 11)
+#define FLUX_FREETYPE_SDF 1
+#else
+#define FLUX_FREETYPE_SDF 0
+#endif
+constexpr bool kFreeTypeHasSdf = FLUX_FREETYPE_SDF;
+
 } // namespace
 
+bool GlyphAtlas::missInLookupOnlyScope() {
+    if (!tlsLookupOnly) return false;
+    tlsLookupOnly->missed_ = true;
+    return true;
+}
+
+GlyphAtlas::LookupOnlyScope::LookupOnlyScope() : previous_(tlsLookupOnly) {
+    tlsLookupOnly = this;
+}
+
+GlyphAtlas::LookupOnlyScope::~LookupOnlyScope() {
+    tlsLookupOnly = previous_;
+}
+
 GlyphAtlas::GlyphAtlas(gpu::Device* device, uint32_t atlasSize)
     : atlas_(device,
              AtlasDesc{.pageWidth = atlasSize,
                        .pageHeight = atlasSize,
                        .maxPages = kDefaultMaxPages,
-                       .format = gpu::PixelFormat::R8})
+                       .format = gpu::PixelFormat::R8,
+                       .packing = AtlasPacking::Skyline})
+    , sdfAtlas_(device,
+                AtlasDesc{.pageWidth = atlasSize,
+                          .pageHeight = atlasSize,
+                          .maxPages = kSdfMaxPages,
+                          .format = gpu::PixelFormat::R8,
+                          .packing = AtlasPacking::Skyline})
+    , pageLastUse_(kDefaultMaxPages + kSdfMaxPages, 0)
 {
     FT_Init_FreeType(&ftLib_);
+    if constexpr (kFreeTypeHasSdf) {
+        // The default spread of 2 leaves too little field to scale far from the reference size.
+        FT_Int spread = kSdfSpread;
+        FT_Property_Set(ftLib_, "sdf", "spread", &spread);
+        FT_Property_Set(ftLib_, "bsdf", "spread", &spread);
+    }
 }
 
 float GlyphAtlas::advanceWhenGlyphMissing(uint16_t fsz, uint16_t fontIndex, float fontSize) {
-    if (const auto* sp = getGlyph(static_cast<uint32_t>(' '), fsz, fontIndex)) {
+    if (const auto* sp = getGlyphMetrics(static_cast<uint32_t>(' '), fsz, fontIndex)) {
         return sp->advance;
     }
     return fontSize * 0.5f;
 }
 
 gpu::Texture* GlyphAtlas::texture(uint8_t page) const {
+    if (isSdfPage(page)) return sdfAtlas_.texture(static_cast<uint8_t>(page - kDefaultMaxPages));
     return atlas_.texture(page);
 }
 
 bool GlyphAtlas::dirty() const {
-    return atlas_.dirty();
+    return atlas_.dirty() || sdfAtlas_.dirty();
+}
+
+void GlyphAtlas::setSdfThreshold(uint16_t fontSize) {
+    std::lock_guard lock(mutex_);
+    if (fontSize == sdfThreshold_) return;
+    sdfThreshold_ = fontSize;
+    // Compiled text at the sizes that switch kind points at the other set of glyphs.
+    ++generation_;
 }
 
 GlyphAtlas::~GlyphAtlas() {
@@ -68,6 +117,7 @@ GlyphAtlas::~GlyphAtlas() {
 }
 
 bool GlyphAtlas::loadFont(const std::string& path, uint16_t fontIndex) {
+    std::lock_guard lock(mutex_);
     FT_Face face = nullptr;
     if (FT_New_Face(ftLib_, path.c_str(), 0, &face) != 0) {
         return false;
@@ -83,6 +133,8 @@ bool GlyphAtlas::loadFont(const std::string& path, uint16_t fontIndex) {
                 ++cit;
             }
         }
+        std::erase_if(metricsCache_, [&](const auto& e) { return e.first.fontIndex == fontIndex; });
+        std::erase_if(sdfUnsupported_, [&](const GlyphKey& k) { return k.fontIndex == fontIndex; });
     }
     faces_[fontIndex] = face;
     // FreeType may retain pathname.pointer without copying; keep path alive for loadFallbackForCodepoint.
@@ -92,12 +144,14 @@ bool GlyphAtlas::loadFont(const std::string& path, uint16_t fontIndex) {
 }
 
 bool GlyphAtlas::loadFontByName(const std::string& name, FontWeight weight, uint16_t fontIndex) {
+    std::lock_guard lock(mutex_);
     auto path = FontProvider::findFontPath(name, weight);
     if (!path.has_value()) return false;
     return loadFont(path.value(), fontIndex);
 }
 
 std::optional<uint16_t> GlyphAtlas::ensureFontLoaded(const std::string& name, FontWeight weight) {
+    std::lock_guard lock(mutex_);
     // Views use makeTextStyle("default", …); "default" is not a real family name on any OS.
     const std::string cacheName = (name.empty() || name == "default") ? std::string("default") : name;
     const std::string key = cacheName + "_" + std::to_string(static_cast<int>(weight));
@@ -118,6 +172,8 @@ std::optional<uint16_t> GlyphAtlas::ensureFontLoaded(const std::string& name, Fo
         }
     }
 
+    if (missInLookupOnlyScope()) return std::nullopt;
+
     auto tryLoad = [&](const std::string& family) -> bool {
         const uint16_t idx = nextFontIndex_;
         if (loadFontByName(family, weight, idx)) {
@@ -167,9 +223,18 @@ std::optional<uint16_t> GlyphAtlas::loadFallbackForCodepoint(uint32_t codepoint,
     if (auto pit = facePaths_.find(baseFontIndex); pit != facePaths_.end()) {
         basePath = pit->second;
     }
+    // Loading a fallback assigns it the next font index; leave that to unscoped callers.
+    if (missInLookupOnlyScope()) return std::nullopt;
+    // Asked first: a lookup that misses while this is true may succeed next time.
+    const bool pending = FontProvider::codepointLookupPending();
     auto resolved = FontProvider::findFontPathForCodepoint(codepoint, basePath);
     if (!resolved.has_value()) {
-        codepointMisses_.insert(codepoint);
+        if (pending) {
+            ++pendingFallbackMisses_;
+            fallbackPending_ = true;
+        } else {
+            codepointMisses_.insert(codepoint);
+        }
         return std::nullopt;
     }
 
@@ -201,6 +266,7 @@ std::optional<uint16_t> GlyphAtlas::loadFallbackForCodepoint(uint32_t codepoint,
 }
 
 bool GlyphAtlas::rasterizeGlyph(const GlyphKey& key, GlyphInfo& out) {
+    bool noOutline = false;
     auto tryRender = [&](uint16_t fi) -> bool {
         auto it = faces_.find(fi);
         if (it == faces_.end()) return false;
@@ -211,7 +277,23 @@ bool GlyphAtlas::rasterizeGlyph(const GlyphKey& key, GlyphInfo& out) {
         FT_UInt glyphIndex = FT_Get_Char_Index(face, key.codepoint);
         if (glyphIndex == 0) return false;
 
-        if (FT_Load_Glyph(face, glyphIndex, FT_LOAD_RENDER) != 0) return false;
+        if (key.sdf) {
+            // Hinting fits outlines to one pixel grid; the field is scaled to many.
+            if (FT_Load_Glyph(face, glyphIndex, FT_LOAD_NO_HINTING) != 0) return false;
+            if (face->glyph->format != FT_GLYPH_FORMAT_OUTLINE) {
+                noOutline = true;
+                return false;
+            }
+#if FLUX_FREETYPE_SDF
+            // Fails when FreeType was built without its sdf module.
+            if (FT_Render_Glyph(face->glyph, FT_RENDER_MODE_SDF) != 0) {
+                noOutline = true;
+                return false;
+            }
+#endif
+        } else if (FT_Load_Glyph(face, glyphIndex, FT_LOAD_RENDER) != 0) {
+            return false;
+        }
 
         FT_GlyphSlot g = face->glyph;
         uint32_t gw = g->bitmap.width;
@@ -228,13 +310,20 @@ bool GlyphAtlas::rasterizeGlyph(const GlyphKey& key, GlyphInfo& out) {
             return true;
         }
 
+        Atlas& atlas = key.sdf ? sdfAtlas_ : atlas_;
         const uint32_t pad = 1;
-        auto slot = atlas_.allocate(gw, gh, pad);
-        if (!slot) return false;
+        auto slot = atlas.allocate(gw, gh, pad);
+        if (!slot) {
+            // Reclaiming pages cannot help a glyph larger than a page.
+            if (gw + pad <= atlas.pageWidth() && gh + pad <= atlas.pageHeight()) {
+                allocationFailed_ = true;
+            }
+            return false;
+        }
 
-        const uint32_t bpp = gpu::bytesPerPixel(atlas_.format());
+        const uint32_t bpp = gpu::bytesPerPixel(atlas.format());
         for (uint32_t row = 0; row < gh; row++) {
-            uint8_t* dst = atlas_.rowData(slot->pageIndex, slot->y + row);
+            uint8_t* dst = atlas.rowData(slot->pageIndex, slot->y + row);
             if (!dst) return false;
             dst += static_cast<size_t>(slot->x) * bpp;
             std::memcpy(dst, &g->bitmap.buffer[row * g->bitmap.pitch], gw);
@@ -249,7 +338,7 @@ bool GlyphAtlas::rasterizeGlyph(const GlyphKey& key, GlyphInfo& out) {
         out.bearingX = static_cast<float>(g->bitmap_left);
         out.bearingY = static_cast<float>(g->bitmap_top);
         out.advance = static_cast<float>(g->advance.x >> 6);
-        out.pageIndex = slot->pageIndex;
+        out.pageIndex = static_cast<uint8_t>(slot->pageIndex + (key.sdf ? kDefaultMaxPages : 0));
         return true;
     };
 
@@ -258,22 +347,141 @@ bool GlyphAtlas::rasterizeGlyph(const GlyphKey& key, GlyphInfo& out) {
     auto fb = loadFallbackForCodepoint(key.codepoint, key.fontIndex);
     if (fb.has_value() && tryRender(fb.value())) return true;
 
+    if (noOutline) sdfUnsupported_.insert(key);
     return false;
 }
 
 const GlyphInfo* GlyphAtlas::getGlyph(uint32_t codepoint, uint16_t fontSize, uint16_t fontIndex) {
-    GlyphKey key{codepoint, fontSize, fontIndex};
+    return findOrRasterize(GlyphKey{codepoint, fontSize, fontIndex});
+}
+
+const GlyphInfo* GlyphAtlas::getSdfGlyph(uint32_t codepoint, uint16_t fontIndex) {
+    std::lock_guard lock(mutex_);
+    GlyphKey key{codepoint, kSdfReferenceSize, fontIndex, true};
+    if (!kFreeTypeHasSdf || sdfUnsupported_.count(key)) return nullptr;
+    return findOrRasterize(key);
+}
+
+const GlyphInfo* GlyphAtlas::findOrRasterize(const GlyphKey& key) {
+    std::lock_guard lock(mutex_);
     auto it = cache_.find(key);
-    if (it != cache_.end()) return &it->second;
+    if (it != cache_.end()) {
+        it->second.lastUseFrame = frame_;
+        if (it->second.width > 0) pageLastUse_[it->second.pageIndex] = frame_;
+        return &it->second;
+    }
+    if (missInLookupOnlyScope()) return nullptr;
 
     GlyphInfo info{};
     if (!rasterizeGlyph(key, info)) return nullptr;
+    info.lastUseFrame = frame_;
+    if (info.width > 0) pageLastUse_[info.pageIndex] = frame_;
     auto [inserted, _] = cache_.emplace(key, info);
     return &inserted->second;
 }
 
+void GlyphAtlas::beginFrame() {
+    std::lock_guard lock(mutex_);
+    ++frame_;
+    // Text compiled while fallbacks were pending drew without the glyphs they would supply.
+    if (fallbackPending_ && !FontProvider::codepointLookupPending()) {
+        fallbackPending_ = false;
+        ++generation_;
+    }
+}
+
+void GlyphAtlas::markPageUsed(uint8_t page) {
+    std::lock_guard lock(mutex_);
+    if (page < pageLastUse_.size()) pageLastUse_[page] = frame_;
+}
+
+bool GlyphAtlas::reclaimColdPages() {
+    std::lock_guard lock(mutex_);
+    if (!allocationFailed_) return false;
+    allocationFailed_ = false;
+
+    // Uploading into a page rewrites pixels the frames in flight may still sample; only
+    // pages none of them drew from are free to reuse. Neither packer can reuse the
+    // hole a single glyph leaves, so cold glyphs go with their page.
+    std::vector<bool> released(pageLastUse_.size(), false);
+    bool any = false;
+    auto releaseCold = [&](Atlas& atlas, uint8_t firstPage) {
+        for (uint8_t p = 0; p < atlas.pageCount(); ++p) {
+            if (pageLastUse_[firstPage + p] + gpu::Device::kMaxFramesInFlight > frame_) continue;
+            atlas.releasePage(p);
+            released[firstPage + p] = true;
+            any = true;
+        }
+    };
+    releaseCold(atlas_, 0);
+    releaseCold(sdfAtlas_, kDefaultMaxPages);
+    if (!any) return false;
+
+    // Zero-size glyphs (spaces) hold no atlas space; drop only those gone cold themselves.
+    std::erase_if(cache_, [&](const auto& entry) -> bool {
+        const GlyphInfo& g = entry.second;
+        if (g.width == 0) return g.lastUseFrame + gpu::Device::kMaxFramesInFlight <= frame_;
+        return released[g.pageIndex];
+    });
+    ++generation_;
+    return true;
+}
+
+bool GlyphAtlas::loadGlyphMetrics(const GlyphKey& key, GlyphMetrics& out) {
+    auto tryLoad = [&](uint16_t fi) -> bool {
+        auto it = faces_.find(fi);
+        if (it == faces_.end()) return false;
+
+        FT_Face face = it->second;
+        FT_Set_Pixel_Sizes(face, 0, key.fontSize);
+
+        FT_UInt glyphIndex = FT_Get_Char_Index(face, key.codepoint);
+        if (glyphIndex == 0) return false;
+
+        // Same load flags as FT_LOAD_RENDER minus the render, so hinted advances match.
+        if (FT_Load_Glyph(face, glyphIndex, FT_LOAD_DEFAULT) != 0) return false;
+
+        FT_GlyphSlot g = face->glyph;
+        float height = static_cast<float>(g->bitmap.rows);
+        if (g->format == FT_GLYPH_FORMAT_OUTLINE) {
+            // The rows rendering would produce: the control box rounded out to whole pixels.
+            FT_BBox box;
+            FT_Outline_Get_CBox(&g->outline, &box);
+            const FT_Pos yMin = box.yMin & ~63;
+            const FT_Pos yMax = (box.yMax + 63) & ~63;
+            height = box.yMax > box.yMin ? static_cast<float>((yMax - yMin) >> 6) : 0.0f;
+        }
+        out.advance = static_cast<float>(g->advance.x >> 6);
+        out.height = height;
+        return true;
+    };
+
+    if (tryLoad(key.fontIndex)) return true;
+
+    auto fb = loadFallbackForCodepoint(key.codepoint, key.fontIndex);
+    if (fb.has_value() && tryLoad(fb.value())) return true;
+
+    return false;
+}
+
+const GlyphMetrics* GlyphAtlas::getGlyphMetrics(uint32_t codepoint, uint16_t fontSize,
+                                                uint16_t fontIndex) {
+    std::lock_guard lock(mutex_);
+    GlyphKey key{codepoint, fontSize, fontIndex};
+    auto it = metricsCache_.find(key);
+    if (it != metricsCache_.end()) return &it->second;
+
+    // Loading metrics leaves the atlas alone, so lookup-only callers may do it too.
+    GlyphMetrics metrics{};
+    if (!loadGlyphMetrics(key, metrics)) return nullptr;
+    auto [inserted, _] = metricsCache_.emplace(key, metrics);
+    return &inserted->second;
+}
+
 void GlyphAtlas::uploadIfDirty() {
+    std::lock_guard lock(mutex_);
     atlas_.uploadIfDirty();
+    sdfAtlas_.uploadIfDirty();
 }
 
 void GlyphAtlas::clearTextLayoutCaches() {
@@ -285,10 +493,12 @@ void GlyphAtlas::clearTextLayoutCaches() {
 
 void GlyphAtlas::markFullAtlasDirty() {
     atlas_.markAllPagesDirty();
+    sdfAtlas_.markAllPagesDirty();
     clearTextLayoutCaches();
 }
 
 Size GlyphAtlas::measureText(const std::string& text, float fontSize, uint16_t fontIndex) {
+    std::lock_guard lock(mutex_);
     uint16_t fsz = static_cast<uint16_t>(fontSize);
     MeasureKey key{text, fsz, fontIndex};
     auto idxIt = measureIndex_.find(key);
@@ -296,11 +506,12 @@ Size GlyphAtlas::measureText(const std::string& text, float fontSize, uint16_t f
         measureLru_.splice(measureLru_.end(), measureLru_, idxIt->second);
         return idxIt->second->second;
     }
+    const uint64_t pendingMisses = pendingFallbackMisses_;
 
     float width = 0, maxH = 0;
 
     utf8ForEach(text, [&](uint32_t cp) {
-        auto* g = getGlyph(cp, fsz, fontIndex);
+        auto* g = getGlyphMetrics(cp, fsz, fontIndex);
         if (g) {
             width += g->advance;
             maxH = std::max(maxH, g->height);
@@ -309,6 +520,10 @@ Size GlyphAtlas::measureText(const std::string& text, float fontSize, uint16_t f
         }
     });
     Size sz{width, std::max(maxH, fontSize)};
+    // Widths of glyphs a lookup-only caller could not add, or whose fallback font is still
+    // being resolved, are placeholders; keep them out.
+    if (tlsLookupOnly && tlsLookupOnly->missed()) return sz;
+    if (pendingFallbackMisses_ != pendingMisses) return sz;
     while (measureIndex_.size() >= kAtlasTextCacheMax) {
         measureIndex_.erase(measureLru_.front().first);
         measureLru_.pop_front();
@@ -319,6 +534,7 @@ Size GlyphAtlas::measureText(const std::string& text, float fontSize, uint16_t f
 }
 
 Size GlyphAtlas::measureTextBox(const std::string& text, float fontSize, float maxWidth, uint16_t fontIndex) {
+    std::lock_guard lock(mutex_);
     auto lines = wrapText(text, fontSize, maxWidth, fontIndex);
     float totalH = 0;
     float maxW = 0;
@@ -340,6 +556,7 @@ std::vector<std::string> GlyphAtlas::wrapText(const std::string& text, float fon
         wrapLru_.splice(wrapLru_.end(), wrapLru_, widxIt->second);
         return widxIt->second->second;
     }
+    const uint64_t pendingMisses = pendingFallbackMisses_;
 
     std::vector<std::string> lines;
     std::istringstream stream(text);
@@ -349,7 +566,7 @@ std::vector<std::string> GlyphAtlas::wrapText(const std::string& text, float fon
     auto wordWidth = [&](const std::string& w) -> float {
         float ww = 0;
         utf8ForEach(w, [&](uint32_t cp) {
-            auto* g = getGlyph(cp, fsz, fontIndex);
+            auto* g = getGlyphMetrics(cp, fsz, fontIndex);
             if (g) {
                 ww += g->advance;
             } else {
@@ -378,6 +595,8 @@ std::vector<std::string> GlyphAtlas::wrapText(const std::string& text, float fon
     }
     if (!currentLine.empty()) lines.push_back(currentLine);
     if (lines.empty()) lines.push_back("");
+    if (tlsLookupOnly && tlsLookupOnly->missed()) return lines;
+    if (pendingFallbackMisses_ != pendingMisses) return lines;
 
     while (wrapIndex_.size() >= kAtlasTextCacheMax) {
         wrapIndex_.erase(wrapLru_.front().first);
@@ -392,26 +611,41 @@ std::vector<std::string> GlyphAtlas::wrapText(const std::string& text, float fon
 std::vector<GlyphInstance> GlyphAtlas::layoutText(const std::string& text, float x, float y,
                                                     float fontSize, const Color& color,
                                                     float vpW, float vpH, uint16_t fontIndex) {
+    std::lock_guard lock(mutex_);
     std::vector<GlyphInstance> out;
     uint16_t fsz = static_cast<uint16_t>(fontSize);
     float penX = x;
+    const bool sdf = sdfThreshold_ > 0 && fsz >= sdfThreshold_;
+    // Scaled from the integer size so quads stay in step with the advances measureText uses.
+    const float sdfScale = static_cast<float>(fsz) / kSdfReferenceSize;
 
     utf8ForEach(text, [&](uint32_t cp) {
-        auto* g = getGlyph(cp, fsz, fontIndex);
+        const GlyphInfo* g = sdf ? getSdfGlyph(cp, fontIndex) : nullptr;
+        float scale = 1.0f;
+        float advance = 0.0f;
+        if (g) {
+            // Pen positions come from this size's hinted metrics, as in measureText.
+            scale = sdfScale;
+            const GlyphMetrics* m = getGlyphMetrics(cp, fsz, fontIndex);
+            advance = m ? m->advance : g->advance * scale;
+        } else {
+            g = getGlyph(cp, fsz, fontIndex);
+            if (g) advance = g->advance;
+        }
         if (!g) {
             penX += advanceWhenGlyphMissing(fsz, fontIndex, fontSize);
             return;
         }
         if (g->width == 0 && g->height == 0) {
-            penX += g->advance;
+            penX += advance;
             return;
         }
 
         GlyphInstance inst{};
-        inst.screenRect[0] = penX + g->bearingX;
-        inst.screenRect[1] = y - g->bearingY;
-        inst.screenRect[2] = g->width;
-        inst.screenRect[3] = g->height;
+        inst.screenRect[0] = penX + g->bearingX * scale;
+        inst.screenRect[1] = y - g->bearingY * scale;
+        inst.screenRect[2] = g->width * scale;
+        inst.screenRect[3] = g->height * scale;
         inst.uvRect[0] = g->u0;
         inst.uvRect[1] = g->v0;
         inst.uvRect[2] = g->u1;
@@ -426,7 +660,7 @@ std::vector<GlyphInstance> GlyphAtlas::layoutText(const std::string& text, float
         inst.atlasPage = static_cast<float>(g->pageIndex);
 
         out.push_back(inst);
-        penX += g->advance;
+        penX += advance;
     });
 
     return out;
@@ -438,6 +672,7 @@ std::vector<GlyphInstance> GlyphAtlas::layoutTextBox(const std::string& text, fl
                                                        float vpW, float vpH,
                                                        HorizontalAlignment hAlign,
                                                        uint16_t fontIndex) {
+    std::lock_guard lock(mutex_);
     auto lines = wrapText(text, fontSize, maxWidth, fontIndex);
     std::vector<GlyphInstance> out;
     float lineH = fontSize * 1.2f;
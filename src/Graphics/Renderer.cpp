@@ -27,10 +27,16 @@ struct OverlayHideDeferral {
 void Renderer::rebuildCachedLayoutTree(const Rect& windowBounds) {
     suppressRedrawRequests();
     renderContext_->clearEnvironmentStack();
-    cachedLayoutTree_ = rootView_->layout(*renderContext_, windowBounds);
+    cachedLayoutTree_ = rootView_.layout(*renderContext_, windowBounds);
     resumeRedrawRequests();
     cachedBounds_ = windowBounds;
     layoutCacheValid_ = true;
+
+    // Elements point into the layout tree they were reconciled against; keep them
+    // in step with the tree that was just replaced.
+    if (rootElement_) {
+        rootElement_->reconcile(cachedLayoutTree_);
+    }
 }
 
 void Renderer::renderFrame(const Rect& bounds) {
@@ -39,6 +45,16 @@ void Renderer::renderFrame(const Rect& bounds) {
     renderContext_->beginFrame();
     renderContext_->clearEnvironmentStack();
 
+    // Record into commandBuffer_ (executed by present()); last frame's recording stays
+    // readable in previousBuffer_ for subtrees that have not changed since.
+    std::swap(commandBuffer_, previousBuffer_);
+    retainedSlices_.swap(nextRetainedSlices_);
+    nextRetainedSlices_.clear();
+    commandBuffer_.clear();
+    commandBuffer_.reserve(previousBuffer_.size());
+    retainedStats_ = {};
+    renderContext_->setRecordingBuffer(&commandBuffer_);
+
     if (rootView_.operator->()) {
         // Always drain keyboard/text BEFORE clearFocusableViews().
         // 1) Auto-generated focus keys (TextInput_0, …) change when the tree is rebuilt;
@@ -49,7 +65,9 @@ void Renderer::renderFrame(const Rect& bounds) {
             window_->processPendingEvents(cachedLayoutTree_);
         }
 
+        size_t previousFocusableCount = 0;
         if (window_) {
+            previousFocusableCount = window_->focus().getFocusableViewCount();
             window_->focus().clearFocusableViews();
         }
 
@@ -65,7 +83,7 @@ void Renderer::renderFrame(const Rect& bounds) {
         // views before overlay click handlers finish across frames. Skip the main relayout until the
         // overlay layer is empty; overlay still lays out inside renderOverlays.
         if (overlayManager_.empty()) {
-            cachedLayoutTree_ = rootView_->layout(*renderContext_, bounds);
+            cachedLayoutTree_ = rootView_.layout(*renderContext_, bounds);
         }
         resumeRedrawRequests();
 
@@ -98,14 +116,24 @@ void Renderer::renderFrame(const Rect& bounds) {
             renderContext_->clearPressedBounds();
         }
 
-        // Attach command buffer for recording, then render the tree (full buffer each frame;
-        // incremental dirty-subtree compile would require retained per-element command slices).
-        commandBuffer_.clear();
-        commandBuffer_.reserve(512);
-        renderContext_->setRecordingBuffer(&commandBuffer_);
+        InteractionSnapshot interaction{
+            window_ ? window_->focus().getFocusedKey() : std::string(), previousFocusableCount,
+            hasHoveredView_, hoveredBounds_, hasPressedView_, pressedBounds_};
+        if (!(interaction == interaction_)) {
+            interaction_ = std::move(interaction);
+            ++interactionEpoch_;
+        }
+
         renderTree(cachedLayoutTree_, rootElement_.get());
         renderOverlays(bounds);
-        renderContext_->setRecordingBuffer(nullptr);
+
+        // Marked only now: the slices just recorded must keep the versions they were
+        // rendered at, so that next frame finds them stale.
+        for (Element* element : animatedElements_) element->markRenderDirty();
+        if (unmountedAnimation_) requestApplicationRedraw();
+        else if (!animatedElements_.empty()) requestRedrawOnly();
+        animatedElements_.clear();
+        unmountedAnimation_ = false;
 
         // Dispatch deferred focus/blur notifications now that views are valid
         if (window_) {
@@ -260,14 +288,20 @@ bool Renderer::dispatchPointerEvent(LayoutNode& root, PointerEvent& event) {
 }
 
 void Renderer::renderTree(LayoutNode& node, Element* element, Point parentOrigin) {
+    const Point offset = {node.bounds.x - parentOrigin.x, node.bounds.y - parentOrigin.y};
+    if (element && replayRetainedSlice(node, element, offset)) {
+        return;
+    }
+
     renderContext_->pushEnvironment(node.environment.value_or(Environment::defaults()));
 
-    // Emit element boundary marker into the command buffer (for incremental compilation)
+    // Emit element boundary marker into the command buffer. Its version identifies this
+    // recording, so CommandCompiler reuses compiled output exactly for replayed copies.
     uint32_t beginPatch = 0;
     bool emittedMarker = false;
+    const RenderContext::InteractionReads readsBefore = renderContext_->interactionReads();
     if (element) {
-        uint64_t stVer = element->subtreeRenderVersion_;
-        beginPatch = commandBuffer_.pushBeginElement(reinterpret_cast<uintptr_t>(element), stVer);
+        beginPatch = commandBuffer_.pushBeginElement(reinterpret_cast<uintptr_t>(element), nextRecordingId_++);
         emittedMarker = true;
     }
 
@@ -282,9 +316,7 @@ void Renderer::renderTree(LayoutNode& node, Element* element, Point parentOrigin
 
     renderContext_->save();
 
-    float relX = node.bounds.x - parentOrigin.x;
-    float relY = node.bounds.y - parentOrigin.y;
-    renderContext_->translate(relX, relY);
+    renderContext_->translate(offset.x, offset.y);
 
     Rect localBounds = {0, 0, node.bounds.width, node.bounds.height};
 
@@ -314,7 +346,12 @@ void Renderer::renderTree(LayoutNode& node, Element* element, Point parentOrigin
     if (opacityVal < 1.0f)
         renderContext_->setOpacity(opacityVal);
 
+    const uint64_t animationRequests = renderContext_->animationFrameRequests();
     node.view->render(*renderContext_, localBounds);
+    if (renderContext_->animationFrameRequests() != animationRequests) {
+        if (element) animatedElements_.push_back(element);
+        else unmountedAnimation_ = true;
+    }
 
     Point currentOrigin = {node.bounds.x, node.bounds.y};
     size_t elemChildCount = element ? element->children.size() : 0;
@@ -328,6 +365,57 @@ void Renderer::renderTree(LayoutNode& node, Element* element, Point parentOrigin
 
     if (emittedMarker) {
         commandBuffer_.pushEndElement(beginPatch);
+        ++retainedStats_.recorded;
+
+        // Something drawn focused, hovered or pressed may change without a new version
+        // (a blinking caret), so such subtrees are rendered fresh every frame.
+        const RenderContext::InteractionReads readsAfter = renderContext_->interactionReads();
+        if (readsAfter.active == readsBefore.active) {
+            nextRetainedSlices_[element] = {
+                beginPatch, static_cast<uint32_t>(commandBuffer_.size()),
+                element->subtreeRenderVersion_, offset,
+                readsAfter.total != readsBefore.total, interactionEpoch_};
+        }
+    }
+}
+
+bool Renderer::replayRetainedSlice(const LayoutNode& node, Element* element, Point offset) {
+    auto it = retainedSlices_.find(element);
+    if (it == retainedSlices_.end()) return false;
+    const RetainedSlice& slice = it->second;
+    if (slice.subtreeVersion != element->subtreeRenderVersion_ || !(slice.offset == offset)) return false;
+    if (slice.readsInteraction && slice.interactionEpoch != interactionEpoch_) return false;
+
+    const uint32_t begin = commandBuffer_.appendRange(previousBuffer_, slice.begin, slice.end);
+    carryRetainedSlices(element, static_cast<int64_t>(begin) - static_cast<int64_t>(slice.begin));
+    registerFocusables(node, element);
+    ++retainedStats_.replayed;
+    return true;
+}
+
+// The slices of a replayed element's descendants moved with it; keep them for the next frame.
+void Renderer::carryRetainedSlices(const Element* element, int64_t delta) {
+    auto it = retainedSlices_.find(element);
+    if (it != retainedSlices_.end()) {
+        RetainedSlice slice = it->second;
+        slice.begin = static_cast<uint32_t>(slice.begin + delta);
+        slice.end = static_cast<uint32_t>(slice.end + delta);
+        nextRetainedSlices_[element] = slice;
+    }
+    for (const auto& child : element->children) {
+        carryRetainedSlices(child.get(), delta);
+    }
+}
+
+// Focusable views register while rendering; a replayed subtree still has to register its own.
+void Renderer::registerFocusables(const LayoutNode& node, Element* element) {
+    if (!window_) return;
+    if (element && node.view.canBeFocused()) {
+        window_->focus().registerFocusableElement(element, node.bounds);
+    }
+    size_t elemChildCount = element ? element->children.size() : 0;
+    for (size_t i = 0; i < node.children.size(); ++i) {
+        registerFocusables(node.children[i], i < elemChildCount ? element->children[i].get() : nullptr);
     }
 }
 
@@ -1,5 +1,6 @@
 #include <Flux/Platform/EventLoopWake.hpp>
 #include <Flux/Platform/PlatformRegistry.hpp>
+#include <Flux/Platform/HeadlessWindow.hpp>
 
 namespace flux {
 
@@ -7,6 +8,7 @@ void wakePlatformEventLoop() {
     if (auto* w = PlatformRegistry::instance().eventLoopWake()) {
         w->wake();
     }
+    HeadlessWindow::wakeEventLoop();
 }
 
 } // namespace flux
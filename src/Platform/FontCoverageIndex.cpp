@@ -0,0 +1,263 @@
+#include <Flux/Platform/FontCoverageIndex.hpp>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <system_error>
+
+namespace flux {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr char kMagic[8] = {'F', 'L', 'X', 'F', 'C', 'I', '0', '1'};
+
+bool isFontFile(const fs::path& path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext == ".ttf" || ext == ".otf" || ext == ".ttc" || ext == ".otc";
+}
+
+struct ScannedFont {
+    std::string path;
+    int rank; // 0 regular sans, 1 other regular, 2 bold or italic
+    std::vector<std::pair<uint32_t, uint32_t>> ranges;
+};
+
+/// The Unicode coverage of the first face in `path`, as sorted inclusive ranges.
+bool scanFont(FT_Library lib, const std::string& path, ScannedFont& out) {
+    FT_Face face = nullptr;
+    if (FT_New_Face(lib, path.c_str(), 0, &face) != 0) return false;
+    const bool usable = FT_IS_SCALABLE(face) && FT_Select_Charmap(face, FT_ENCODING_UNICODE) == 0;
+    if (usable) {
+        out.path = path;
+        const std::string family = face->family_name ? face->family_name : "";
+        if (face->style_flags & (FT_STYLE_FLAG_BOLD | FT_STYLE_FLAG_ITALIC)) {
+            out.rank = 2;
+        } else {
+            const bool sans = family.find("Sans") != std::string::npos &&
+                              family.find("Mono") == std::string::npos;
+            out.rank = sans ? 0 : 1;
+        }
+        FT_UInt glyph = 0;
+        for (FT_ULong cp = FT_Get_First_Char(face, &glyph); glyph != 0;
+             cp = FT_Get_Next_Char(face, cp, &glyph)) {
+            const auto c = static_cast<uint32_t>(cp);
+            if (!out.ranges.empty() && out.ranges.back().second + 1 == c) {
+                out.ranges.back().second = c;
+            } else {
+                out.ranges.push_back({c, c});
+            }
+        }
+    }
+    FT_Done_Face(face);
+    return usable && !out.ranges.empty();
+}
+
+void writeU32(std::ostream& out, uint32_t v) { out.write(reinterpret_cast<const char*>(&v), 4); }
+void writeI64(std::ostream& out, int64_t v) { out.write(reinterpret_cast<const char*>(&v), 8); }
+void writeString(std::ostream& out, const std::string& s) {
+    writeU32(out, static_cast<uint32_t>(s.size()));
+    out.write(s.data(), static_cast<std::streamsize>(s.size()));
+}
+
+bool readU32(std::istream& in, uint32_t& v) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&v), 4));
+}
+bool readI64(std::istream& in, int64_t& v) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&v), 8));
+}
+bool readString(std::istream& in, std::string& s) {
+    uint32_t size = 0;
+    if (!readU32(in, size) || size > 4096) return false;
+    s.resize(size);
+    return static_cast<bool>(in.read(s.data(), size));
+}
+
+} // namespace
+
+int64_t FontCoverageIndex::directoryStamp(const std::string& path) {
+    std::error_code ec;
+    const auto time = fs::last_write_time(path, ec);
+    if (ec) return -1;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+FontCoverageIndex FontCoverageIndex::build(const std::vector<std::string>& directories,
+                                           const std::atomic<bool>* cancel) {
+    FontCoverageIndex index;
+    index.rootCount_ = static_cast<uint32_t>(directories.size());
+    auto cancelled = [&] { return cancel && cancel->load(std::memory_order_relaxed); };
+
+    for (const std::string& root : directories) {
+        index.directories_.push_back({root, directoryStamp(root)});
+    }
+    std::vector<std::string> files;
+    for (const std::string& root : directories) {
+        std::error_code ec;
+        if (!fs::is_directory(root, ec)) continue;
+        fs::recursive_directory_iterator it(
+            root, fs::directory_options::follow_directory_symlink |
+                      fs::directory_options::skip_permission_denied, ec);
+        for (; !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+            // An entry that cannot be inspected is skipped, not the rest of the walk.
+            std::error_code entryEc;
+            std::string path = it->path().string();
+            if (it->is_directory(entryEc)) {
+                const int64_t stamp = directoryStamp(path);
+                index.directories_.push_back({std::move(path), stamp});
+            } else if (it->is_regular_file(entryEc) && isFontFile(it->path())) {
+                files.push_back(std::move(path));
+            }
+        }
+    }
+    std::sort(files.begin(), files.end());
+    files.erase(std::unique(files.begin(), files.end()), files.end());
+
+    FT_Library lib = nullptr;
+    if (FT_Init_FreeType(&lib) != 0) return index;
+    std::vector<ScannedFont> fonts;
+    for (const std::string& file : files) {
+        if (cancelled()) break;
+        ScannedFont font;
+        if (scanFont(lib, file, font)) fonts.push_back(std::move(font));
+    }
+    FT_Done_FreeType(lib);
+
+    // Font ids in priority order; the lowest id among the fonts covering a codepoint wins.
+    std::stable_sort(fonts.begin(), fonts.end(),
+                     [](const ScannedFont& a, const ScannedFont& b) { return a.rank < b.rank; });
+    struct Event {
+        uint32_t at;
+        uint32_t font;
+        bool opens;
+    };
+    std::vector<Event> events;
+    for (uint32_t id = 0; id < fonts.size(); ++id) {
+        index.fonts_.push_back(fonts[id].path);
+        for (auto [first, last] : fonts[id].ranges) {
+            events.push_back({first, id, true});
+            events.push_back({last + 1, id, false});
+        }
+    }
+    std::sort(events.begin(), events.end(),
+              [](const Event& a, const Event& b) { return a.at < b.at; });
+
+    std::set<uint32_t> active;
+    for (size_t i = 0; i < events.size();) {
+        const uint32_t at = events[i].at;
+        for (; i < events.size() && events[i].at == at; ++i) {
+            if (events[i].opens) {
+                active.insert(events[i].font);
+            } else {
+                active.erase(events[i].font);
+            }
+        }
+        if (active.empty() || i == events.size()) continue;
+        const uint32_t font = *active.begin();
+        const uint32_t last = events[i].at - 1;
+        if (!index.ranges_.empty() && index.ranges_.back().font == font &&
+            index.ranges_.back().last + 1 == at) {
+            index.ranges_.back().last = last;
+        } else {
+            index.ranges_.push_back({at, last, font});
+        }
+    }
+    return index;
+}
+
+std::optional<std::string> FontCoverageIndex::find(uint32_t codepoint) const {
+    auto it = std::upper_bound(ranges_.begin(), ranges_.end(), codepoint,
+                               [](uint32_t cp, const Range& r) { return cp < r.first; });
+    if (it == ranges_.begin()) return std::nullopt;
+    --it;
+    if (codepoint > it->last) return std::nullopt;
+    return fonts_[it->font];
+}
+
+bool FontCoverageIndex::save(const std::string& cachePath) const {
+    const fs::path path(cachePath);
+    std::error_code ec;
+    if (path.has_parent_path()) fs::create_directories(path.parent_path(), ec);
+    fs::path temp = path;
+    temp += ".tmp";
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out.write(kMagic, sizeof(kMagic));
+        writeU32(out, rootCount_);
+        writeU32(out, static_cast<uint32_t>(directories_.size()));
+        for (const DirectoryStamp& d : directories_) {
+            writeString(out, d.path);
+            writeI64(out, d.mtime);
+        }
+        writeU32(out, static_cast<uint32_t>(fonts_.size()));
+        for (const std::string& font : fonts_) writeString(out, font);
+        writeU32(out, static_cast<uint32_t>(ranges_.size()));
+        for (const Range& r : ranges_) {
+            writeU32(out, r.first);
+            writeU32(out, r.last);
+            writeU32(out, r.font);
+        }
+        if (!out.flush()) return false;
+    }
+    fs::rename(temp, path, ec);
+    if (ec) fs::remove(temp, ec);
+    return !ec;
+}
+
+std::optional<FontCoverageIndex> FontCoverageIndex::load(
+    const std::string& cachePath, const std::vector<std::string>& directories) {
+    std::ifstream in(cachePath, std::ios::binary);
+    if (!in) return std::nullopt;
+    char magic[sizeof(kMagic)];
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+        return std::nullopt;
+    }
+
+    FontCoverageIndex index;
+    uint32_t count = 0;
+    if (!readU32(in, index.rootCount_) || index.rootCount_ != directories.size()) {
+        return std::nullopt;
+    }
+    if (!readU32(in, count) || count < index.rootCount_) return std::nullopt;
+    for (uint32_t i = 0; i < count; ++i) {
+        DirectoryStamp d;
+        if (!readString(in, d.path) || !readI64(in, d.mtime)) return std::nullopt;
+        // build() stamps the roots first, in the order given.
+        if (i < index.rootCount_ && d.path != directories[i]) return std::nullopt;
+        if (directoryStamp(d.path) != d.mtime) return std::nullopt;
+        index.directories_.push_back(std::move(d));
+    }
+
+    if (!readU32(in, count)) return std::nullopt;
+    for (uint32_t i = 0; i < count; ++i) {
+        std::string font;
+        if (!readString(in, font)) return std::nullopt;
+        index.fonts_.push_back(std::move(font));
+    }
+
+    if (!readU32(in, count)) return std::nullopt;
+    index.ranges_.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        Range r;
+        if (!readU32(in, r.first) || !readU32(in, r.last) || !readU32(in, r.font)) {
+            return std::nullopt;
+        }
+        const bool ordered = index.ranges_.empty() || index.ranges_.back().last < r.first;
+        if (r.first > r.last || r.font >= index.fonts_.size() || !ordered) return std::nullopt;
+        index.ranges_.push_back(r);
+    }
+    return index;
+}
+
+} // namespace flux
@@ -17,7 +17,8 @@ bool GPUPlatformRenderer::initialize(int width, int height, float dpiScaleX, flo
     dpiScaleX_ = dpiScaleX;
     dpiScaleY_ = dpiScaleY;
 
-    if (surface_.kind == gpu::NativeGraphicsSurfaceKind::None || !surface_.ptr) {
+    const bool headless = surface_.kind == gpu::NativeGraphicsSurfaceKind::Headless;
+    if (surface_.kind == gpu::NativeGraphicsSurfaceKind::None || (!surface_.ptr && !headless)) {
         FLUX_LOG_ERROR("[GPUPlatformRenderer] graphics surface not set before initialize");
         return false;
     }
@@ -28,6 +29,10 @@ bool GPUPlatformRenderer::initialize(int width, int height, float dpiScaleX, flo
 
         int pw = static_cast<int>(width * dpiScaleX);
         int ph = static_cast<int>(height * dpiScaleY);
+        if (headless) {
+            // No swapchain to size the device from; allocate the framebuffer explicitly.
+            device_->resize(static_cast<uint32_t>(pw), static_cast<uint32_t>(ph));
+        }
         gpuBackend_->setViewportSize(static_cast<float>(pw), static_cast<float>(ph));
         gpuBackend_->setDPIScale(dpiScaleX, dpiScaleY);
 
@@ -46,7 +51,8 @@ bool GPUPlatformRenderer::initialize(int width, int height, float dpiScaleX, flo
         }
 
         FLUX_LOG_INFO("[GPUPlatformRenderer] Initialized %s backend %dx%d (fb %dx%d)",
-                      backend_ == gpu::Backend::Metal ? "Metal" : "Vulkan",
+                      backend_ == gpu::Backend::Metal ? "Metal"
+                          : backend_ == gpu::Backend::Vulkan ? "Vulkan" : "Software",
                       width, height, pw, ph);
         logMemoryFootprintIfRequested("after GPU init");
         return true;
@@ -76,6 +82,8 @@ void GPUPlatformRenderer::endFrame() {
 }
 
 void GPUPlatformRenderer::resize(int width, int height) {
+    // The device may not change size under a frame the render thread is drawing.
+    if (gpuBackend_) gpuBackend_->finishFrames();
     width_ = width;
     height_ = height;
     int pw = static_cast<int>(width * dpiScaleX_);
@@ -98,12 +106,28 @@ void GPUPlatformRenderer::updateDPIScale(float dpiScaleX, float dpiScaleY) {
 void GPUPlatformRenderer::swapBuffers() {
 }
 
+void GPUPlatformRenderer::setPipelined(bool enabled) {
+    if (gpuBackend_) gpuBackend_->setPipelined(enabled);
+}
+
+void GPUPlatformRenderer::setCompileThreads(size_t threads) {
+    if (gpuBackend_) gpuBackend_->setCompileThreads(threads);
+}
+
+void GPUPlatformRenderer::setSdfTextThreshold(uint16_t fontSize) {
+    if (auto* atlas = gpuBackend_ ? gpuBackend_->glyphAtlas() : nullptr) {
+        atlas->setSdfThreshold(fontSize);
+    }
+}
+
 bool GPUPlatformRenderer::readPixels(int x, int y, int w, int h, std::vector<uint8_t>& out) {
     if (!device_) return false;
+    if (gpuBackend_) gpuBackend_->finishFrames();
     return device_->readPixels(x, y, w, h, out);
 }
 
 void GPUPlatformRenderer::setReadbackEnabled(bool enabled) {
+    if (gpuBackend_) gpuBackend_->finishFrames();
     if (device_) {
         device_->setReadbackEnabled(enabled);
     }
@@ -0,0 +1,128 @@
+#include <Flux/Platform/HeadlessWindow.hpp>
+#include <Flux/Platform/GPUPlatformRenderer.hpp>
+#include <Flux/Platform/NativeGraphicsSurface.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+
+namespace flux {
+
+namespace {
+
+std::mutex wakeMutex;
+std::condition_variable wakeCv;
+uint64_t wakeSerial = 0;
+std::atomic<unsigned int> nextWindowId{1};
+
+} // namespace
+
+HeadlessWindow::HeadlessWindow(const std::string& title, const Size& size, float dpiScale)
+    : title_(title)
+    , size_(size)
+    , dpiScale_(dpiScale)
+    , id_(nextWindowId.fetch_add(1, std::memory_order_relaxed))
+{
+    auto gpuRenderer = std::make_unique<GPUPlatformRenderer>(gpu::Backend::Software);
+    gpuRenderer->setGraphicsSurface(gpu::NativeGraphicsSurface::headless());
+    if (!gpuRenderer->initialize(
+            static_cast<int>(size.width),
+            static_cast<int>(size.height),
+            dpiScale, dpiScale)) {
+        throw std::runtime_error("Failed to initialize software renderer");
+    }
+    renderer_ = std::move(gpuRenderer);
+}
+
+HeadlessWindow::~HeadlessWindow() {
+    renderer_.reset();
+}
+
+void HeadlessWindow::resize(const Size& newSize) {
+    size_ = newSize;
+    renderer_->resize(
+        static_cast<int>(newSize.width),
+        static_cast<int>(newSize.height)
+    );
+}
+
+void HeadlessWindow::setFullscreen(bool fullscreen) {
+    fullscreen_ = fullscreen;
+}
+
+void HeadlessWindow::setTitle(const std::string& title) {
+    title_ = title;
+}
+
+unsigned int HeadlessWindow::windowID() const {
+    return id_;
+}
+
+RenderContext* HeadlessWindow::renderContext() {
+    return renderer_ ? renderer_->renderContext() : nullptr;
+}
+
+PlatformRenderer* HeadlessWindow::platformRenderer() {
+    return renderer_.get();
+}
+
+void HeadlessWindow::swapBuffers() {
+}
+
+float HeadlessWindow::dpiScaleX() const {
+    return dpiScale_;
+}
+
+float HeadlessWindow::dpiScaleY() const {
+    return dpiScale_;
+}
+
+Size HeadlessWindow::currentSize() const {
+    return size_;
+}
+
+bool HeadlessWindow::isFullscreen() const {
+    return fullscreen_;
+}
+
+void HeadlessWindow::processEvents() {
+    // No input source: synthetic events from the test server arrive through `Window`.
+}
+
+void HeadlessWindow::waitForEvents(int timeoutMs) {
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    const uint64_t seen = wakeSerial;
+    auto woken = [&] { return wakeSerial != seen; };
+    if (timeoutMs < 0) {
+        wakeCv.wait(lock, woken);
+    } else {
+        wakeCv.wait_for(lock, std::chrono::milliseconds(timeoutMs), woken);
+    }
+}
+
+bool HeadlessWindow::shouldClose() const {
+    return false;
+}
+
+void HeadlessWindow::setCursor(CursorType cursor) {
+    currentCursor_ = cursor;
+}
+
+CursorType HeadlessWindow::currentCursor() const {
+    return currentCursor_;
+}
+
+void HeadlessWindow::setFluxWindow(Window* window) {
+    fluxWindow_ = window;
+}
+
+void HeadlessWindow::wakeEventLoop() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        ++wakeSerial;
+    }
+    wakeCv.notify_all();
+}
+
+} // namespace flux
@@ -1,11 +1,72 @@
 #include <Flux/Platform/LinuxFontResolver.hpp>
 #include <Flux/Core/Log.hpp>
+#include <Flux/Core/MainThreadQueue.hpp>
+#include <Flux/Core/Property.hpp>
 
+#include <chrono>
 #include <cstdio>
 #include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
 
 namespace flux {
 
+namespace {
+
+std::string envOr(const char* name, const std::string& fallback) {
+    const char* value = std::getenv(name);
+    return value && *value ? std::string(value) : fallback;
+}
+
+} // namespace
+
+LinuxFontResolver::~LinuxFontResolver() {
+    cancelIndex_ = true;
+    if (indexThread_.joinable()) indexThread_.join();
+}
+
+void LinuxFontResolver::startCoverageIndex() {
+    std::lock_guard lock(indexMutex_);
+    if (indexStarted_) return;
+    indexStarted_ = true;
+    indexThread_ = std::thread([this] {
+        const std::string home = envOr("HOME", "");
+        std::vector<std::string> dirs;
+        if (!home.empty()) {
+            dirs.push_back(envOr("XDG_DATA_HOME", home + "/.local/share") + "/fonts");
+            dirs.push_back(home + "/.fonts");
+        }
+        dirs.push_back("/usr/local/share/fonts");
+        dirs.push_back("/usr/share/fonts");
+        const std::string cacheHome = envOr("XDG_CACHE_HOME", home.empty() ? "" : home + "/.cache");
+        const std::string cachePath =
+            cacheHome.empty() ? std::string() : cacheHome + "/flux/font-coverage.bin";
+
+        [[maybe_unused]] const auto start = std::chrono::steady_clock::now();
+        std::optional<FontCoverageIndex> index;
+        if (!cachePath.empty()) index = FontCoverageIndex::load(cachePath, dirs);
+        const bool loaded = index.has_value();
+        if (!loaded) {
+            index = FontCoverageIndex::build(dirs, &cancelIndex_);
+            // A cancelled scan is partial; leave the saved copy for the next run to redo.
+            if (!cancelIndex_ && !cachePath.empty() && !index->save(cachePath)) {
+                FLUX_LOG_WARN("[FontProvider] Could not save font coverage to %s", cachePath.c_str());
+            }
+        }
+        FLUX_LOG_DEBUG("[FontProvider] Font coverage: %zu fonts, %zu ranges, %s in %lld ms",
+                       index->fontCount(), index->rangeCount(), loaded ? "loaded" : "scanned",
+                       static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - start).count()));
+        {
+            std::lock_guard indexLock(indexMutex_);
+            index_ = std::move(index);
+        }
+        // Text laid out in the meantime left codepoints without a fallback font.
+        if (!cancelIndex_) postToMainThread([] { requestApplicationRedraw(); });
+    });
+}
+
 std::optional<std::string> LinuxFontResolver::findFontPath(const std::string& familyName,
                                                             FontWeight weight) {
     (void)weight;
@@ -31,23 +92,25 @@ std::optional<std::string> LinuxFontResolver::findFontPath(const std::string& fa
 std::optional<std::string> LinuxFontResolver::findFontPathForCodepoint(uint32_t codepoint,
                                                                        const std::string& baseFontPath) {
     (void)baseFontPath;
-    char cmd[256];
-    snprintf(cmd, sizeof(cmd), "fc-match -f '%%{file}' ':charset=%x'", codepoint);
-    FILE* pipe = popen(cmd, "r");
-    if (!pipe) return std::nullopt;
-    char buf[1024];
-    std::string path;
-    while (fgets(buf, sizeof(buf), pipe)) {
-        path += buf;
+    // Only reached for a codepoint the loaded faces lack: most runs never scan.
+    startCoverageIndex();
+    std::optional<std::string> path;
+    {
+        std::lock_guard lock(indexMutex_);
+        // Callers holding the glyph atlas lock must not wait out a scan; see
+        // codepointLookupPending().
+        if (!index_) return std::nullopt;
+        path = index_->find(codepoint);
     }
-    int status = pclose(pipe);
-    if (status != 0 || path.empty()) return std::nullopt;
-    while (!path.empty() && (path.back() == '\n' || path.back() == '\r')) {
-        path.pop_back();
-    }
-    if (path.empty()) return std::nullopt;
-    FLUX_LOG_DEBUG("[FontProvider] Fallback for U+%04X → %s", codepoint, path.c_str());
+    if (!path) return std::nullopt;
+    FLUX_LOG_DEBUG("[FontProvider] Fallback for U+%04X → %s", codepoint, path->c_str());
     return path;
 }
 
+bool LinuxFontResolver::codepointLookupPending() {
+    startCoverageIndex();
+    std::lock_guard lock(indexMutex_);
+    return !index_.has_value();
+}
+
 } // namespace flux
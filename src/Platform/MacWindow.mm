@@ -598,6 +598,15 @@ float MacWindow::dpiScaleY() const {
     return dpiScaleX();
 }
 
+double MacWindow::refreshRate() const {
+    if (!impl_->window) return 0;
+    if (@available(macOS 12.0, *)) {
+        NSScreen* screen = impl_->window.screen;
+        return screen ? static_cast<double>(screen.maximumFramesPerSecond) : 0;
+    }
+    return 0;
+}
+
 Size MacWindow::currentSize() const {
     return size_;
 }
@@ -1,5 +1,6 @@
 #include <Flux/Platform/MacWindowFactory.hpp>
 #include <Flux/Platform/MacWindow.hpp>
+#include <Flux/Platform/HeadlessWindow.hpp>
 #include <stdexcept>
 
 namespace flux {
@@ -21,6 +22,9 @@ std::unique_ptr<PlatformWindow> MacWindowFactory::createWindow(
     bool resizable,
     bool fullscreen
 ) {
+    if (backend_ == RenderBackendType::Software) {
+        return std::make_unique<HeadlessWindow>(title, size);
+    }
     return std::make_unique<MacWindow>(title, size, resizable, fullscreen, backend_);
 }
 
@@ -4,6 +4,7 @@
 namespace flux {
 
 void SDLEventLoopWake::wake() {
+    if (!SDL_WasInit(SDL_INIT_EVENTS)) return;  // headless run: SDL never initialized
     SDL_Event wakeEvent{};
     wakeEvent.type = SDL_EVENT_USER;
     SDL_PushEvent(&wakeEvent);
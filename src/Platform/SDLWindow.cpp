@@ -107,6 +107,12 @@ float SDLWindow::dpiScaleY() const {
     return dpiScaleX();
 }
 
+double SDLWindow::refreshRate() const {
+    if (!window_) return 0;
+    const SDL_DisplayMode* mode = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(window_));
+    return mode ? static_cast<double>(mode->refresh_rate) : 0;
+}
+
 Size SDLWindow::currentSize() const {
     return size_;
 }
@@ -1,16 +1,13 @@
 #include <Flux/Platform/SDLWindowFactory.hpp>
 #include <Flux/Platform/SDLWindow.hpp>
+#include <Flux/Platform/HeadlessWindow.hpp>
+#include <Flux/Core/Log.hpp>
 #include <SDL3/SDL.h>
 #include <stdexcept>
 
 namespace flux {
 
-SDLWindowFactory::SDLWindowFactory() {
-    if (!SDL_Init(SDL_INIT_VIDEO)) {
-        throw std::runtime_error(std::string("Failed to initialize SDL3: ") + SDL_GetError());
-    }
-    sdlInitialized_ = true;
-}
+SDLWindowFactory::SDLWindowFactory() = default;
 
 SDLWindowFactory::~SDLWindowFactory() {
     if (sdlInitialized_) {
@@ -24,7 +21,28 @@ std::unique_ptr<PlatformWindow> SDLWindowFactory::createWindow(
     bool resizable,
     bool fullscreen
 ) {
+#if !defined(FLUX_HAS_VULKAN)
+    // A FLUX_SOFTWARE_ONLY build has no on-screen backend: say so rather than quietly
+    // running an app without a window.
+    if (backend_ == RenderBackendType::GPU_Auto) {
+        FLUX_LOG_WARN("[SDLWindowFactory] Built with FLUX_SOFTWARE_ONLY: \"%s\" renders headless "
+                      "through the software rasterizer and opens no window", title.c_str());
+        backend_ = RenderBackendType::Software;
+    }
+#endif
+    if (backend_ == RenderBackendType::Software) {
+        return std::make_unique<HeadlessWindow>(title, size);
+    }
+    ensureSdlInitialized();
     return std::make_unique<SDLWindow>(title, size, resizable, fullscreen, backend_);
 }
 
+void SDLWindowFactory::ensureSdlInitialized() {
+    if (sdlInitialized_) return;
+    if (!SDL_Init(SDL_INIT_VIDEO)) {
+        throw std::runtime_error(std::string("Failed to initialize SDL3: ") + SDL_GetError());
+    }
+    sdlInitialized_ = true;
+}
+
 } // namespace flux
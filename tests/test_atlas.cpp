@@ -0,0 +1,217 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <Flux/GPU/Device.hpp>
+#include <Flux/Graphics/Atlas.hpp>
+#include <Flux/Graphics/GlyphAtlas.hpp>
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <optional>
+#include <random>
+#include <vector>
+
+using namespace flux;
+
+namespace {
+
+struct GlyphSize {
+    uint32_t w, h;
+};
+
+// Glyph bitmaps as a UI with mixed text sizes rasterizes them: mostly Latin lowercase and
+// capitals, some descenders and punctuation, and square CJK fallback and emoji glyphs.
+std::vector<GlyphSize> mixedGlyphSet(size_t count) {
+    static constexpr float kSizes[] = {11, 12, 13, 14, 15, 16, 18, 20, 24, 28, 32, 48, 64};
+    struct Shape { float share, w, h; };
+    static constexpr Shape kShapes[] = {
+        {0.50f, 0.50f, 0.55f}, // x-height lowercase
+        {0.22f, 0.62f, 0.74f}, // capitals, ascenders
+        {0.10f, 0.52f, 0.95f}, // descenders
+        {0.08f, 0.22f, 0.25f}, // punctuation
+        {0.06f, 0.95f, 0.95f}, // CJK
+        {0.04f, 1.20f, 1.18f}, // emoji
+    };
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<size_t> sizeDist(0, std::size(kSizes) - 1);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<GlyphSize> out;
+    out.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const float size = kSizes[sizeDist(rng)];
+        float pick = unit(rng);
+        const Shape* shape = &kShapes[0];
+        for (const Shape& s : kShapes) {
+            shape = &s;
+            if (pick < s.share) break;
+            pick -= s.share;
+        }
+        const float jitter = 0.85f + 0.3f * unit(rng);
+        out.push_back({std::max(1u, static_cast<uint32_t>(size * shape->w * jitter)),
+                       std::max(1u, static_cast<uint32_t>(size * shape->h * jitter))});
+    }
+    return out;
+}
+
+std::optional<std::string> systemSansFont() {
+    for (const char* path : {"/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
+                             "/usr/share/fonts/TTF/DejaVuSans.ttf",
+                             "/usr/share/fonts/dejavu/DejaVuSans.ttf"}) {
+        if (std::filesystem::exists(path)) return std::string(path);
+    }
+    return std::nullopt;
+}
+
+bool approx(float a, float b) {
+    return std::abs(a - b) < 1e-3f;
+}
+
+/// Fraction of the pages in use covered by glyphs when the first glyph fails to fit.
+double occupancyWhenFull(gpu::Device& device, AtlasPacking packing,
+                         const std::vector<GlyphSize>& glyphs) {
+    Atlas atlas(&device, AtlasDesc{.pageWidth = 512, .pageHeight = 512, .maxPages = 4,
+                                  .packing = packing});
+    uint64_t area = 0;
+    for (const GlyphSize& g : glyphs) {
+        if (!atlas.allocate(g.w, g.h)) break;
+        area += static_cast<uint64_t>(g.w) * g.h;
+    }
+    return static_cast<double>(area) /
+           (static_cast<double>(atlas.pageCount()) * atlas.pageWidth() * atlas.pageHeight());
+}
+
+} // namespace
+
+TEST_CASE("Atlas reuses released pages and uploads only the rects it fills", "[atlas]") {
+    auto device = gpu::createDevice(gpu::Backend::Software, {});
+    REQUIRE(device);
+    for (AtlasPacking packing : {AtlasPacking::Shelf, AtlasPacking::Skyline}) {
+        Atlas atlas(device.get(), AtlasDesc{.pageWidth = 64, .pageHeight = 64, .maxPages = 2,
+                                            .packing = packing});
+
+        // Two 30x30 slots side by side, twice, per page.
+        for (int i = 0; i < 8; ++i) {
+            auto slot = atlas.allocate(30, 30);
+            REQUIRE(slot);
+            CHECK(slot->pageIndex == i / 4);
+        }
+        CHECK_FALSE(atlas.allocate(30, 30));
+        atlas.uploadIfDirty();
+
+        atlas.releasePage(0);
+        auto slot = atlas.allocate(30, 30);
+        REQUIRE(slot);
+        CHECK(slot->pageIndex == 0);
+        CHECK(slot->x == 0);
+        CHECK(slot->y == 0);
+
+        // The slot and its padding, not the page.
+        atlas.uploadIfDirty();
+        CHECK(atlas.lastGpuUploadBytes() == 31 * 31);
+    }
+}
+
+TEST_CASE("Skyline packing keeps rectangles on the page and apart", "[atlas]") {
+    auto device = gpu::createDevice(gpu::Backend::Software, {});
+    REQUIRE(device);
+    Atlas atlas(device.get(), AtlasDesc{.pageWidth = 256, .pageHeight = 256, .maxPages = 1,
+                                        .packing = AtlasPacking::Skyline});
+
+    struct Placed { uint32_t x, y, w, h; };
+    std::vector<Placed> placed;
+    for (const GlyphSize& g : mixedGlyphSet(400)) {
+        auto slot = atlas.allocate(g.w, g.h);
+        if (!slot) continue;
+        CHECK(slot->x + g.w + 1 <= 256);
+        CHECK(slot->y + g.h + 1 <= 256);
+        placed.push_back({slot->x, slot->y, g.w + 1, g.h + 1});
+    }
+    REQUIRE(placed.size() > 50);
+    size_t overlaps = 0;
+    for (size_t i = 0; i < placed.size(); ++i) {
+        for (size_t j = i + 1; j < placed.size(); ++j) {
+            const Placed& a = placed[i];
+            const Placed& b = placed[j];
+            overlaps += a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+        }
+    }
+    CHECK(overlaps == 0);
+}
+
+TEST_CASE("Atlas packing occupancy and throughput on mixed glyph sizes", "[atlas][!benchmark]") {
+    auto device = gpu::createDevice(gpu::Backend::Software, {});
+    REQUIRE(device);
+    const auto glyphs = mixedGlyphSet(20000);
+
+    const double shelf = occupancyWhenFull(*device, AtlasPacking::Shelf, glyphs);
+    const double skyline = occupancyWhenFull(*device, AtlasPacking::Skyline, glyphs);
+    WARN("occupancy when full: shelf " << shelf * 100.0 << "%, skyline " << skyline * 100.0 << "%");
+    CHECK(skyline > shelf);
+
+    // 2000 of these glyphs cover about 60% of a 1024x1024 page.
+    const std::vector<GlyphSize> page(glyphs.begin(), glyphs.begin() + 2000);
+    for (AtlasPacking packing : {AtlasPacking::Shelf, AtlasPacking::Skyline}) {
+        BENCHMARK(packing == AtlasPacking::Shelf ? "shelf: allocate 2000 glyphs"
+                                                 : "skyline: allocate 2000 glyphs") {
+            Atlas atlas(device.get(), AtlasDesc{.maxPages = 8, .packing = packing});
+            size_t placed = 0;
+            for (const GlyphSize& g : page) placed += atlas.allocate(g.w, g.h).has_value();
+            return placed;
+        };
+    }
+}
+
+TEST_CASE("Glyph atlas lays out text from the SDF threshold up from distance fields", "[atlas]") {
+    auto font = systemSansFont();
+    if (!font) SKIP("DejaVu Sans is not installed");
+    auto device = gpu::createDevice(gpu::Backend::Software, {});
+    GlyphAtlas atlas(device.get());
+    REQUIRE(atlas.loadFont(*font));
+    atlas.setSdfThreshold(32);
+    const GlyphInfo* field = atlas.getSdfGlyph('H');
+    if (!field) SKIP("FreeType cannot render distance fields");
+    const GlyphInfo reference = *field;
+    const Color white(1, 1, 1, 1);
+
+    for (const GlyphInstance& q : atlas.layoutText("HH", 0, 40, 31, white, 800, 600)) {
+        CHECK_FALSE(GlyphAtlas::isSdfPage(static_cast<uint8_t>(q.atlasPage)));
+    }
+    for (float size : {32.0f, 48.0f, 100.0f}) {
+        const auto quads = atlas.layoutText("HH", 10, 120, size, white, 800, 600);
+        REQUIRE(quads.size() == 2);
+        const float scale = size / GlyphAtlas::kSdfReferenceSize;
+        for (const GlyphInstance& q : quads) {
+            CHECK(GlyphAtlas::isSdfPage(static_cast<uint8_t>(q.atlasPage)));
+            CHECK(approx(q.screenRect[2], reference.width * scale));
+            CHECK(approx(q.screenRect[3], reference.height * scale));
+        }
+        CHECK(approx(quads[0].screenRect[0], 10 + reference.bearingX * scale));
+        // The pen advances as measureText counts at this size, not by the scaled field.
+        CHECK(approx(quads[1].screenRect[0] - quads[0].screenRect[0],
+                     atlas.measureText("H", size).width));
+    }
+}
+
+TEST_CASE("Glyph atlas measures text without rasterizing it", "[atlas]") {
+    auto font = systemSansFont();
+    if (!font) SKIP("DejaVu Sans is not installed");
+    auto device = gpu::createDevice(gpu::Backend::Software, {});
+    const Color white(1, 1, 1, 1);
+
+    GlyphAtlas measured(device.get());
+    REQUIRE(measured.loadFont(*font));
+    measured.uploadIfDirty(); // loading a font re-uploads every page
+    CHECK(measured.measureText("Hamburgefonts", 14).width > 0);
+    CHECK(measured.measureTextBox("Hamburgefonts and more words", 14, 60).height > 14);
+    CHECK_FALSE(measured.dirty());
+
+    // Measuring allocated nothing: a glyph of the measured text lands where it would on a
+    // fresh atlas.
+    GlyphAtlas fresh(device.get());
+    REQUIRE(fresh.loadFont(*font));
+    const auto a = measured.layoutText("s", 0, 20, 14, white, 800, 600);
+    const auto b = fresh.layoutText("s", 0, 20, 14, white, 800, 600);
+    REQUIRE(a.size() == 1);
+    REQUIRE(b.size() == 1);
+    CHECK(std::equal(std::begin(a[0].uvRect), std::end(a[0].uvRect), std::begin(b[0].uvRect)));
+    CHECK(measured.dirty());
+}
@@ -94,3 +94,279 @@ TEST_CASE("Element tree reconciliation creates new elements for new children", "
     REQUIRE(root->children[0]->isMounted);
     REQUIRE(mountCount == 1);
 }
+
+TEST_CASE("Clean subtree with unchanged bounds is handed back for reuse", "[element]") {
+    View rootView = SimpleWidget{ .text = "root" };
+    View child = SimpleWidget{ .text = "child" };
+    View leaf = SimpleWidget{ .text = "leaf" };
+
+    LayoutNode tree(rootView, {0, 0, 800, 600});
+    LayoutNode childNode(child, {0, 0, 400, 300});
+    childNode.children.push_back(LayoutNode(leaf, {0, 0, 100, 20}));
+    tree.children.push_back(std::move(childNode));
+
+    auto root = Element::buildTree(tree);
+    root->reconcile(tree);
+    Element* childElement = root->children[0].get();
+    REQUIRE(child.boundElement() == childElement);
+
+    {
+        Element::LayoutScope scope(root.get());
+        CHECK(Element::takeRetainedLayout(childElement, child.operator->(), {0, 0, 400, 200}) == nullptr);
+        LayoutNode* retained = Element::takeRetainedLayout(childElement, child.operator->(), {0, 0, 400, 300});
+        REQUIRE(retained != nullptr);
+        CHECK(retained->children.size() == 1);
+        // Handed out once per pass.
+        CHECK(Element::takeRetainedLayout(childElement, child.operator->(), {0, 0, 400, 300}) == nullptr);
+
+        LayoutNode next(rootView, {0, 0, 800, 600});
+        next.children.push_back(std::move(*retained));
+        tree = std::move(next);
+    }
+    root->reconcile(tree);
+    REQUIRE(root->children[0].get() == childElement);
+    REQUIRE(childElement->children.size() == 1);
+
+    // Dirtying a descendant invalidates every ancestor's retained layout.
+    childElement->children[0]->markDirty();
+    {
+        Element::LayoutScope scope(root.get());
+        CHECK(Element::takeRetainedLayout(childElement, child.operator->(), {0, 0, 400, 300}) == nullptr);
+    }
+}
+
+TEST_CASE("Layout state reaches a fresh view only through its key", "[element]") {
+    View rootView = SimpleWidget{ .text = "root" };
+    LayoutNode tree(rootView, {0, 0, 800, 600});
+    tree.children.push_back(LayoutNode(SimpleWidget{ .text = "a" }, {0, 0, 400, 600}));
+    tree.children.push_back(LayoutNode(SimpleWidget{ .key = "b", .text = "b" }, {400, 0, 400, 600}));
+    auto root = Element::buildTree(tree);
+    Element* a = root->children[0].get();
+    Element* b = root->children[1].get();
+
+    static const char tag = 0;
+    auto stateA = std::make_shared<int>(1);
+    auto stateB = std::make_shared<int>(2);
+    CHECK(Element::layoutState(&tag) == nullptr);
+    {
+        Element::LayoutScope rootScope(root.get());
+        {
+            Element::LayoutScope scope(a);
+            *Element::layoutState(&tag) = stateA;
+        }
+        {
+            Element::LayoutScope scope(b);
+            *Element::layoutState(&tag) = stateB;
+            CHECK(Element::keyedLayoutState(&tag, "b") == nullptr); // mounted views use their own
+        }
+    }
+
+    // The root's body was regenerated: its children are laid out as views not mounted yet.
+    Element::LayoutScope rootScope(root.get());
+    Element::LayoutScope scope(nullptr);
+    CHECK(Element::layoutState(&tag) == nullptr);
+    CHECK(Element::keyedLayoutState(&tag, "b") == stateB);
+    CHECK(Element::keyedLayoutState(&tag, "c") == nullptr);
+    static const char otherTag = 0;
+    CHECK(Element::keyedLayoutState(&otherTag, "b") == nullptr);
+    // Unkeyed views are not matched by position; they get their state in transferState().
+    CHECK(Element::keyedLayoutState(&tag, "") == nullptr);
+    CHECK(*stateA == 1);
+}
+
+TEST_CASE("Render versions change only for subtrees whose output may have", "[element]") {
+    View rootView = SimpleWidget{ .text = "root" };
+    View a = SimpleWidget{ .text = "a" };
+    View aLeaf = SimpleWidget{ .text = "a leaf" };
+    View b = SimpleWidget{ .text = "b" };
+
+    LayoutNode tree(rootView, {0, 0, 800, 600});
+    LayoutNode aNode(a, {0, 0, 400, 600});
+    aNode.children.push_back(LayoutNode(aLeaf, {0, 0, 100, 20}));
+    tree.children.push_back(std::move(aNode));
+    tree.children.push_back(LayoutNode(b, {400, 0, 400, 600}));
+
+    auto root = Element::buildTree(tree);
+    Element* elementA = root->children[0].get();
+    Element* leaf = elementA->children[0].get();
+    Element* elementB = root->children[1].get();
+    CHECK(leaf->renderVersion_ > 0);
+    CHECK(root->subtreeRenderVersion_ >= elementB->renderVersion_);
+
+    root->reconcile(tree);
+    const uint64_t rootVersion = root->renderVersion_;
+    const uint64_t leafVersion = leaf->renderVersion_;
+    const uint64_t bVersion = elementB->renderVersion_;
+    const uint64_t subtreeVersion = root->subtreeRenderVersion_;
+    root->reconcile(tree);
+    CHECK(root->subtreeRenderVersion_ == subtreeVersion);
+
+    // A rebuilt body re-describes everything below it.
+    elementA->markDirty();
+    root->reconcile(tree);
+    CHECK(leaf->renderVersion_ > leafVersion);
+    CHECK(elementB->renderVersion_ == bVersion);
+    CHECK(root->renderVersion_ == rootVersion);
+    CHECK(root->subtreeRenderVersion_ == leaf->renderVersion_);
+}
+
+TEST_CASE("Render-only dirty marks keep bodies and layout cached", "[element]") {
+    View rootView = SimpleWidget{ .text = "root" };
+    View a = SimpleWidget{ .text = "a" };
+    View aLeaf = SimpleWidget{ .text = "a leaf" };
+    View b = SimpleWidget{ .text = "b" };
+
+    LayoutNode tree(rootView, {0, 0, 800, 600});
+    LayoutNode aNode(a, {0, 0, 400, 600});
+    aNode.children.push_back(LayoutNode(aLeaf, {0, 0, 100, 20}));
+    tree.children.push_back(std::move(aNode));
+    tree.children.push_back(LayoutNode(b, {400, 0, 400, 600}));
+
+    auto root = Element::buildTree(tree);
+    root->reconcile(tree);
+    Element* elementA = root->children[0].get();
+    Element* leaf = elementA->children[0].get();
+    Element* elementB = root->children[1].get();
+    const uint64_t generation = currentBodyGeneration();
+    const uint64_t aVersion = elementA->renderVersion_;
+    const uint64_t leafVersion = leaf->renderVersion_;
+    const uint64_t bSubtreeVersion = elementB->subtreeRenderVersion_;
+
+    leaf->markRenderDirty();
+    CHECK(leaf->renderVersion_ > leafVersion);
+    CHECK(elementA->renderVersion_ == aVersion);
+    CHECK(elementA->subtreeRenderVersion_ == leaf->renderVersion_);
+    CHECK(root->subtreeRenderVersion_ == leaf->renderVersion_);
+    CHECK(elementB->subtreeRenderVersion_ == bSubtreeVersion);
+    CHECK_FALSE(leaf->bodyDirty);
+    CHECK_FALSE(leaf->layoutDirty);
+    CHECK_FALSE(root->layoutDirty);
+    CHECK(currentBodyGeneration() == generation);
+}
+
+static int readerBodyCalls[2] = {0, 0};
+
+struct SharedReader {
+    FLUX_VIEW_PROPERTIES;
+    Property<int> source = 0;
+    int slot = 0;
+
+    View body() const {
+        ++readerBodyCalls[slot];
+        return SimpleWidget{ .text = std::to_string(static_cast<int>(source)) };
+    }
+};
+
+struct ClickCounter {
+    FLUX_VIEW_PROPERTIES;
+    FLUX_INTERACTIVE_PROPERTIES;
+    Property<int> clicks = 0;
+
+    void init() {
+        onClick = [this] { clicks = clicks + 1; };
+    }
+};
+
+TEST_CASE("Shared property writes regenerate only the bodies that read them", "[element]") {
+    readerBodyCalls[0] = readerBodyCalls[1] = 0;
+    auto a = Property<int>::shared(1);
+    auto b = Property<int>::shared(2);
+
+    View rootView = SimpleWidget{ .text = "root" };
+    View readerA = SharedReader{ .key = "a", .source = a, .slot = 0 };
+    View readerB = SharedReader{ .key = "b", .source = b, .slot = 1 };
+    LayoutNode tree(rootView, {0, 0, 800, 600});
+    tree.children.push_back(LayoutNode(readerA, {0, 0, 400, 600}));
+    tree.children.push_back(LayoutNode(readerB, {400, 0, 400, 600}));
+
+    auto root = Element::buildTree(tree);
+    root->reconcile(tree);
+    Element* elementA = root->children[0].get();
+    Element* elementB = root->children[1].get();
+
+    readerA->body();
+    readerB->body();
+    readerA->body();
+    REQUIRE(readerBodyCalls[0] == 1);
+    REQUIRE(readerBodyCalls[1] == 1);
+
+    a = 5;
+    CHECK(elementA->bodyDirty);
+    CHECK(root->layoutDirty);
+    CHECK_FALSE(elementB->bodyDirty);
+    CHECK_FALSE(elementB->layoutDirty);
+
+    readerA->body();
+    readerB->body();
+    CHECK(readerBodyCalls[0] == 2);
+    CHECK(readerBodyCalls[1] == 1);
+
+    // Moving to another slot keeps the subscription with the element.
+    LayoutNode onlyB(rootView, {0, 0, 800, 600});
+    onlyB.children.push_back(LayoutNode(readerB, {400, 0, 400, 600}));
+    root->reconcile(onlyB);
+    b = 7;
+    CHECK(root->children[0]->bodyDirty);
+    readerB->body();
+    CHECK(readerBodyCalls[1] == 2);
+}
+
+TEST_CASE("Inline property written by an event handler dirties only its element", "[element]") {
+    View rootView = SimpleWidget{ .text = "root" };
+    View counter = ClickCounter{};
+    View sibling = SimpleWidget{ .text = "sibling" };
+    LayoutNode tree(rootView, {0, 0, 800, 600});
+    tree.children.push_back(LayoutNode(counter, {0, 0, 400, 600}));
+    tree.children.push_back(LayoutNode(sibling, {400, 0, 400, 600}));
+
+    auto root = Element::buildTree(tree);
+    root->reconcile(tree);
+    Element* counterElement = root->children[0].get();
+    Element* siblingElement = root->children[1].get();
+
+    CHECK(counter.handleMouseUp(10, 10, 0));
+    CHECK(counterElement->bodyDirty);
+    CHECK(root->layoutDirty);
+    CHECK_FALSE(siblingElement->layoutDirty);
+}
+
+TEST_CASE("Batched property writes invalidate once when the outermost batch closes", "[element]") {
+    readerBodyCalls[0] = readerBodyCalls[1] = 0;
+    auto a = Property<int>::shared(1);
+    auto b = Property<int>::shared(2);
+
+    View rootView = SimpleWidget{ .text = "root" };
+    View readerA = SharedReader{ .key = "a", .source = a, .slot = 0 };
+    View readerB = SharedReader{ .key = "b", .source = b, .slot = 1 };
+    LayoutNode tree(rootView, {0, 0, 800, 600});
+    tree.children.push_back(LayoutNode(readerA, {0, 0, 400, 600}));
+    tree.children.push_back(LayoutNode(readerB, {400, 0, 400, 600}));
+
+    auto root = Element::buildTree(tree);
+    root->reconcile(tree);
+    Element* elementA = root->children[0].get();
+    Element* elementB = root->children[1].get();
+    readerA->body();
+    readerB->body();
+    root->layoutDirty = false;
+
+    batch([&] {
+        PropertyBatch inner;
+        for (int i = 0; i < 200; ++i) a = 10 + i;
+        CHECK_FALSE(elementA->bodyDirty);
+    });
+    // The outer batch was still open when the inner one closed.
+    CHECK(elementA->bodyDirty);
+    CHECK(root->layoutDirty);
+    CHECK_FALSE(elementB->bodyDirty);
+    CHECK_FALSE(elementB->layoutDirty);
+
+    readerA->body();
+    readerB->body();
+    CHECK(readerBodyCalls[0] == 2);
+    CHECK(readerBodyCalls[1] == 1);
+    CHECK(a.get() == 209);
+
+    CHECK(batch([&] { b = 3; return b.get(); }) == 3);
+    CHECK(elementB->bodyDirty);
+}
@@ -0,0 +1,81 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Flux/Platform/FontCoverageIndex.hpp>
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+using namespace flux;
+namespace fs = std::filesystem;
+
+namespace {
+
+std::optional<fs::path> systemSansFont() {
+    for (const char* path : {"/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
+                             "/usr/share/fonts/TTF/DejaVuSans.ttf",
+                             "/usr/share/fonts/dejavu/DejaVuSans.ttf"}) {
+        if (fs::exists(path)) return fs::path(path);
+    }
+    return std::nullopt;
+}
+
+/// A fresh directory under the temp dir, removed with its contents on destruction.
+struct TempDir {
+    fs::path path;
+    TempDir() {
+        const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+        path = fs::temp_directory_path() / ("flux-fci-" + std::to_string(stamp));
+        fs::create_directories(path / "fonts" / "sub");
+    }
+    ~TempDir() {
+        std::error_code ec;
+        fs::remove_all(path, ec);
+    }
+};
+
+} // namespace
+
+TEST_CASE("FontCoverageIndex maps codepoints to the font files covering them", "[fonts]") {
+    auto font = systemSansFont();
+    if (!font) SKIP("DejaVu Sans is not installed");
+    TempDir tmp;
+    const fs::path a = tmp.path / "fonts" / "a.ttf";
+    const fs::path b = tmp.path / "fonts" / "sub" / "b.ttf";
+    fs::copy_file(*font, b);
+    fs::copy_file(*font, a);
+    const std::vector<std::string> dirs = {(tmp.path / "fonts").string()};
+
+    auto index = FontCoverageIndex::build(dirs);
+    CHECK(index.fontCount() == 2);
+    // Equal faces cover the same codepoints; the first path wins all of them.
+    CHECK(index.find('A') == a.string());
+    CHECK(index.find(0x0416) == a.string()); // Cyrillic Zhe
+    CHECK_FALSE(index.find(0x4E00).has_value()); // CJK, not in DejaVu
+    CHECK_FALSE(index.find(0x10FFFD).has_value());
+}
+
+TEST_CASE("FontCoverageIndex reloads a saved index until a directory changes", "[fonts]") {
+    auto font = systemSansFont();
+    if (!font) SKIP("DejaVu Sans is not installed");
+    TempDir tmp;
+    const fs::path fonts = tmp.path / "fonts";
+    fs::copy_file(*font, fonts / "sub" / "sans.ttf");
+    const std::vector<std::string> dirs = {fonts.string(), (tmp.path / "missing").string()};
+    const std::string cache = (tmp.path / "cache" / "coverage.bin").string();
+
+    CHECK_FALSE(FontCoverageIndex::load(cache, dirs).has_value());
+    const auto built = FontCoverageIndex::build(dirs);
+    REQUIRE(built.save(cache));
+
+    auto loaded = FontCoverageIndex::load(cache, dirs);
+    REQUIRE(loaded.has_value());
+    CHECK(loaded->rangeCount() == built.rangeCount());
+    CHECK(loaded->find('A') == (fonts / "sub" / "sans.ttf").string());
+    // Other directories are another index.
+    CHECK_FALSE(FontCoverageIndex::load(cache, {fonts.string()}).has_value());
+
+    // A font added or removed below a root changes its directory's time.
+    const fs::path sub = fonts / "sub";
+    fs::last_write_time(sub, fs::last_write_time(sub) + std::chrono::seconds(5));
+    CHECK_FALSE(FontCoverageIndex::load(cache, dirs).has_value());
+}
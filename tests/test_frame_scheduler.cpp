@@ -0,0 +1,69 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Flux/Core/FrameScheduler.hpp>
+
+using namespace flux;
+using namespace std::chrono_literals;
+using Clock = FrameScheduler::Clock;
+
+TEST_CASE("FrameScheduler coalesces requests into one frame per interval", "[framescheduler]") {
+    FrameScheduler scheduler;
+    scheduler.setTargetFrameRate(100);
+    const Clock::time_point t0{};
+
+    // Nothing pending: sleep until an event.
+    CHECK_FALSE(scheduler.timeUntilFrame(false, t0).has_value());
+
+    // The first request after idle renders at once.
+    CHECK(scheduler.frameDue(true, t0));
+    scheduler.frameRendered(t0);
+
+    // Requests within the interval wait for its end.
+    CHECK_FALSE(scheduler.frameDue(true, t0 + 2ms));
+    CHECK(*scheduler.timeUntilFrame(true, t0 + 2ms) == 8ms);
+    CHECK(scheduler.frameDue(true, t0 + 10ms));
+
+    // Frames requested long after the last one do not wait.
+    CHECK(scheduler.frameDue(true, t0 + 1s));
+}
+
+TEST_CASE("FrameScheduler rounds the interval to whole display refreshes", "[framescheduler]") {
+    FrameScheduler scheduler;
+    scheduler.setTargetFrameRate(60);
+    CHECK(scheduler.frameInterval() > 16ms);
+    CHECK(scheduler.frameInterval() < 17ms);
+
+    // 60 fps on a 120 Hz display: every other refresh.
+    scheduler.setRefreshRate(120);
+    CHECK(scheduler.frameInterval() > 16ms);
+    CHECK(scheduler.frameInterval() < 17ms);
+
+    // 60 fps on a 59.94 Hz display: every refresh, not every other one.
+    scheduler.setRefreshRate(59.94);
+    CHECK(scheduler.frameInterval() > 16ms);
+    CHECK(scheduler.frameInterval() < 17ms);
+
+    // Faster than the display: one refresh.
+    scheduler.setTargetFrameRate(240);
+    scheduler.setRefreshRate(60);
+    CHECK(scheduler.frameInterval() > 16ms);
+
+    // Unlimited: render whenever requested.
+    scheduler.setTargetFrameRate(0);
+    CHECK(scheduler.frameInterval() == Clock::duration::zero());
+}
+
+TEST_CASE("FrameScheduler renders timed frames without a redraw request", "[framescheduler]") {
+    FrameScheduler scheduler;
+    const Clock::time_point t0{};
+    scheduler.frameRendered(t0);
+
+    scheduler.requestFrameAt(t0 + 500ms);
+    scheduler.requestFrameAt(t0 + 800ms);
+    CHECK(*scheduler.timeUntilFrame(false, t0 + 100ms) == 400ms);
+    CHECK_FALSE(scheduler.frameDue(false, t0 + 499ms));
+    CHECK(scheduler.frameDue(false, t0 + 500ms));
+
+    // Rendering at or after the timed frame consumes it.
+    scheduler.frameRendered(t0 + 500ms);
+    CHECK_FALSE(scheduler.timeUntilFrame(false, t0 + 501ms).has_value());
+}
@@ -1,5 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include <Flux/Layout/LayoutEngine.hpp>
+#include <Flux/Views/VStack.hpp>
+#include <Flux/Views/HStack.hpp>
+#include <Flux/Views/LazyList.hpp>
 #include <cmath>
 
 using namespace flux;
@@ -168,3 +171,85 @@ TEST_CASE("Min/max constraints are respected", "[layout]") {
     );
     CHECK(rects[0].height <= 50.1f);
 }
+
+namespace {
+
+struct FixedTextMeasurement : TextMeasurement {
+    Size measureText(const std::string& text, const TextStyle&) override {
+        return {8.0f * static_cast<float>(text.size()), 16.0f};
+    }
+    Size measureTextBox(const std::string& text, const TextStyle& style, float) override {
+        return measureText(text, style);
+    }
+};
+
+int leafPreferredSizeCalls = 0;
+int leafHeightForWidthCalls = 0;
+
+struct MeasuredLeaf {
+    FLUX_VIEW_PROPERTIES;
+
+    Size preferredSize(TextMeasurement&) const {
+        ++leafPreferredSizeCalls;
+        return {40, 20};
+    }
+
+    float heightForWidth(float, TextMeasurement&) const {
+        ++leafHeightForWidthCalls;
+        return 20;
+    }
+};
+
+} // namespace
+
+TEST_CASE("Nested stacks measure each view once per distinct width", "[layout]") {
+    leafPreferredSizeCalls = 0;
+    leafHeightForWidthCalls = 0;
+
+    View nested = MeasuredLeaf{};
+    for (int depth = 0; depth < 10; ++depth) {
+        if (depth % 2 == 0) {
+            nested = HStack{ .children = {nested, MeasuredLeaf{}} };
+        } else {
+            nested = VStack{ .children = {nested, MeasuredLeaf{}} };
+        }
+    }
+
+    FixedTextMeasurement tm;
+    float h1 = nested.heightForWidth(400, tm);
+    Size s1 = nested.preferredSize(tm);
+    int preferredCalls = leafPreferredSizeCalls;
+    int heightCalls = leafHeightForWidthCalls;
+
+    // 11 leaves, each asked for its preferred size once and its height for a
+    // single width (no leaf has expansion bias, so widths never diverge).
+    CHECK(preferredCalls == 11);
+    CHECK(heightCalls <= 11);
+
+    CHECK(nested.heightForWidth(400, tm) == h1);
+    CHECK(nested.preferredSize(tm) == s1);
+    CHECK(leafPreferredSizeCalls == preferredCalls);
+    CHECK(leafHeightForWidthCalls == heightCalls);
+}
+
+TEST_CASE("Lazy list materializes only rows near the viewport", "[layout][lazylist]") {
+    // 50k rows of 20px in a 200px viewport with 40px overscan: 14 rows, wherever we scroll.
+    CHECK(lazyListVisibleRange(50000, 20, 0, 200, 40) == LazyListRange{0, 12});
+    CHECK(lazyListVisibleRange(50000, 20, 500000, 200, 40) == LazyListRange{24998, 25012});
+    CHECK(lazyListVisibleRange(50000, 20, 999800, 200, 40) == LazyListRange{49988, 50000});
+    CHECK(lazyListVisibleRange(500, 20, 5000, 200, 40).size() ==
+          lazyListVisibleRange(5000000, 20, 5000, 200, 40).size());
+
+    CHECK(lazyListVisibleRange(0, 20, 0, 200, 40).size() == 0);
+    CHECK(lazyListVisibleRange(10, 0, 0, 200, 40).size() == 0);
+    CHECK(lazyListVisibleRange(10, 20, 0, 200, 40) == LazyListRange{0, 10});
+}
+
+TEST_CASE("Lazy list rows measure through to their content", "[layout][lazylist]") {
+    leafHeightForWidthCalls = 0;
+    FixedTextMeasurement tm;
+    View row = LazyListRow{ .key = "7", .content = MeasuredLeaf{} };
+    CHECK(row.getKey() == "7");
+    CHECK(row.heightForWidth(300, tm) == 20);
+    CHECK(leafHeightForWidthCalls == 1);
+}
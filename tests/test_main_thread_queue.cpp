@@ -0,0 +1,160 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Flux/Core/MainThreadQueue.hpp>
+#include <Flux/Core/Property.hpp>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace flux;
+
+namespace {
+
+std::atomic<int> wakeCount{0};
+void countWake() { wakeCount.fetch_add(1, std::memory_order_relaxed); }
+
+} // namespace
+
+TEST_CASE("MainThreadQueue runs tasks in posting order", "[mainthreadqueue]") {
+    MainThreadQueue queue;
+    std::vector<int> order;
+    for (int i = 0; i < 5; ++i) queue.post([&order, i] { order.push_back(i); });
+
+    auto stats = queue.drain();
+    CHECK(stats.executed == 5);
+    CHECK(stats.coalesced == 0);
+    CHECK(order == std::vector<int>{0, 1, 2, 3, 4});
+    CHECK(queue.empty());
+    CHECK(queue.drain().executed == 0);
+}
+
+TEST_CASE("MainThreadQueue keeps only the last task per key", "[mainthreadqueue]") {
+    MainThreadQueue queue;
+    int a = 0, b = 0;
+    std::vector<char> order;
+    queue.post(&a, [&] { a = 1; order.push_back('a'); });
+    queue.post(&b, [&] { b = 1; order.push_back('b'); });
+    queue.post(&a, [&] { a = 2; order.push_back('A'); });
+
+    auto stats = queue.drain();
+    CHECK(stats.executed == 2);
+    CHECK(stats.coalesced == 1);
+    CHECK(a == 2);
+    CHECK(b == 1);
+    // A coalesced task runs in the slot of the write that survived.
+    CHECK(order == std::vector<char>{'b', 'A'});
+}
+
+TEST_CASE("MainThreadQueue wakes once per burst", "[mainthreadqueue]") {
+    MainThreadQueue queue;
+    queue.setWakeHandler(&countWake);
+    wakeCount = 0;
+
+    for (int i = 0; i < 100; ++i) queue.post([] {});
+    CHECK(wakeCount == 1);
+
+    queue.drain();
+    queue.post([] {});
+    CHECK(wakeCount == 2);
+    queue.drain();
+}
+
+TEST_CASE("MainThreadQueue accepts posts from many threads", "[mainthreadqueue]") {
+    MainThreadQueue queue;
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 2000;
+
+    // Main-thread state only; producers never touch it directly.
+    std::vector<std::vector<int>> seen(kThreads);
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t) {
+        producers.emplace_back([&queue, &seen, t] {
+            for (int i = 0; i < kPerThread; ++i) {
+                queue.post([&seen, t, i] { seen[t].push_back(i); });
+            }
+        });
+    }
+
+    // Drain concurrently with the producers, the way the event loop would.
+    std::thread joiner([&] {
+        for (auto& p : producers) p.join();
+        done = true;
+    });
+    size_t executed = 0;
+    while (!done) executed += queue.drain().executed;
+    joiner.join();
+    executed += queue.drain().executed;
+
+    CHECK(executed == size_t{kThreads} * kPerThread);
+    for (int t = 0; t < kThreads; ++t) {
+        REQUIRE(seen[t].size() == kPerThread);
+        // Each producer's tasks run in the order it posted them.
+        bool ordered = true;
+        for (int i = 0; i < kPerThread; ++i) ordered = ordered && seen[t][i] == i;
+        CHECK(ordered);
+    }
+}
+
+TEST_CASE("Property::post coalesces a burst of writes into one", "[mainthreadqueue][property]") {
+    MainThreadQueue& queue = MainThreadQueue::instance();
+    queue.drain();
+
+    Property<std::string> text = Property<std::string>::shared("");
+    Property<int> tokens = Property<int>::shared(0);
+    Property<int> boundTokens = tokens;
+
+    std::thread producer([&] {
+        std::string streamed;
+        for (int i = 0; i < 1000; ++i) {
+            streamed += "x";
+            text.post(streamed);
+            tokens.post(i + 1);
+        }
+    });
+    producer.join();
+
+    CHECK(text.get().empty());
+    auto stats = queue.drain();
+    CHECK(stats.executed == 2);
+    CHECK(stats.coalesced == 1998);
+    CHECK(text.get().size() == 1000);
+    CHECK(tokens.get() == 1000);
+    CHECK(boundTokens.get() == 1000);
+}
+
+TEST_CASE("A drained burst of posted writes requests one redraw", "[mainthreadqueue][property]") {
+    MainThreadQueue& queue = MainThreadQueue::instance();
+    queue.drain();
+
+    std::vector<Property<int>> values;
+    for (int p = 0; p < 4; ++p) values.push_back(Property<int>::shared(0));
+    std::thread producer([&] {
+        for (int i = 0; i < 1000; ++i) values[i % 4].post(i);
+    });
+    producer.join();
+
+    const uint64_t before = redrawRequestCount();
+    auto stats = queue.drain();
+    CHECK(stats.executed == 4);
+    CHECK(redrawRequestCount() - before == 1);
+    CHECK(values[0].get() == 996);
+    CHECK(values[3].get() == 999);
+
+    queue.drain();
+    CHECK(redrawRequestCount() - before == 1);
+}
+
+TEST_CASE("Property<std::vector>::post applies on drain", "[mainthreadqueue][property]") {
+    MainThreadQueue& queue = MainThreadQueue::instance();
+    queue.drain();
+
+    Property<std::vector<int>> items = Property<std::vector<int>>::shared({});
+    std::thread producer([&] { items.post({1, 2, 3}); });
+    producer.join();
+
+    CHECK(items.get().empty());
+    queue.drain();
+    CHECK(items.get() == std::vector<int>{1, 2, 3});
+}
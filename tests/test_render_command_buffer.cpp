@@ -0,0 +1,557 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Flux/Graphics/RenderCommandBuffer.hpp>
+#include <Flux/Graphics/CommandCompiler.hpp>
+#include <Flux/Graphics/GlyphAtlas.hpp>
+#include <Flux/GPU/Device.hpp>
+#include <cstring>
+#include <string>
+
+using namespace flux;
+
+namespace {
+
+// One element subtree as the Renderer records it; returns the BeginElement offset.
+uint32_t recordElement(RenderCommandBuffer& buf, uintptr_t id, uint64_t version) {
+    uint32_t begin = buf.pushBeginElement(id, version);
+    buf.pushSave();
+    buf.pushTranslate(10, 20);
+    buf.pushSetFillStyle(FillStyle::solid(Color(1, 0, 0, 1)));
+    buf.pushDrawRect({0, 0, 30, 40}, CornerRadius(4));
+    buf.pushSetTextStyle(TextStyle{});
+    buf.pushDrawText(buf.internString("label"), {1, 2}, HorizontalAlignment::leading, VerticalAlignment::top);
+    buf.pushDrawImage(7, {0, 0, 8, 8}, ImageFit::Fill, CornerRadius(), 1.0f);
+    buf.pushRestore();
+    buf.pushEndElement(begin);
+    return begin;
+}
+
+} // namespace
+
+TEST_CASE("Appended command range is re-pooled and rebased", "[commandbuffer]") {
+    RenderCommandBuffer previous;
+    previous.pushClear(Color(0, 0, 0, 1));
+    uint32_t begin = recordElement(previous, 0x1234, 7);
+
+    RenderCommandBuffer current;
+    current.internString("something else");
+    current.pushSetFillStyle(FillStyle::solid(Color(0, 0, 1, 1)));
+    current.pushClear(Color(0, 0, 0, 1));
+    current.pushSave();
+    uint32_t start = current.appendRange(previous, begin, static_cast<uint32_t>(previous.size()));
+    CHECK(current.size() - start == previous.size() - begin);
+
+    auto r = current.reader();
+    r.seekTo(start);
+    REQUIRE(r.nextOp() == CmdOp::BeginElement);
+    CHECK(r.readUint32() == 0x1234);
+    CHECK(r.readUint32() == 0);
+    CHECK(r.readUint32() == 7);
+    CHECK(r.readUint32() == 0);
+    uint32_t endOffset = r.readUint32();
+
+    REQUIRE(r.nextOp() == CmdOp::Save);
+    REQUIRE(r.nextOp() == CmdOp::Translate);
+    CHECK(r.readFloat() == 10);
+    CHECK(r.readFloat() == 20);
+    REQUIRE(r.nextOp() == CmdOp::SetFillStyle);
+    CHECK(current.fillStyle(r.readUint32()).solid().color == Color(1, 0, 0, 1));
+    REQUIRE(r.nextOp() == CmdOp::DrawRect);
+    for (int i = 0; i < 8; ++i) r.readFloat();
+    REQUIRE(r.nextOp() == CmdOp::SetTextStyle);
+    r.readUint32();
+    REQUIRE(r.nextOp() == CmdOp::DrawText);
+    CHECK(current.str(r.readUint32()) == "label");
+    for (int i = 0; i < 4; ++i) r.readUint32();
+    REQUIRE(r.nextOp() == CmdOp::DrawImage);
+    CHECK(r.readInt32() == 7);
+    for (int i = 0; i < 10; ++i) r.readUint32();
+    REQUIRE(r.nextOp() == CmdOp::Restore);
+    CHECK(r.wordOffset() == endOffset);
+    REQUIRE(r.nextOp() == CmdOp::EndElement);
+    CHECK_FALSE(r.hasNext());
+}
+
+TEST_CASE("Compiler reuses the output of a replayed element", "[commandbuffer]") {
+    CommandCompiler compiler;
+
+    RenderCommandBuffer first;
+    first.pushClear(Color(0, 0, 0, 1));
+    first.pushDrawRect({0, 0, 5, 5}, CornerRadius());
+    uint32_t begin = first.pushBeginElement(0xbeef, 1);
+    first.pushSave();
+    first.pushSetFillStyle(FillStyle::solid(Color(1, 0, 0, 1)));
+    first.pushDrawRect({0, 0, 30, 40}, CornerRadius(4));
+    first.pushDrawImage(3, {0, 0, 8, 8}, ImageFit::Fill, CornerRadius(), 1.0f);
+    first.pushRestore();
+    first.pushEndElement(begin);
+
+    CompiledBatches a;
+    compiler.compile(first, 100, 100, 1, 1, a);
+    CHECK(compiler.lastCacheStats().misses == 1);
+
+    // Different preamble: the copy lands at another offset, after other instances.
+    RenderCommandBuffer second;
+    second.pushClear(Color(0, 0, 0, 1));
+    second.pushDrawRect({0, 0, 5, 5}, CornerRadius());
+    second.pushDrawImage(4, {0, 0, 2, 2}, ImageFit::Fill, CornerRadius(), 1.0f);
+    second.appendRange(first, begin, static_cast<uint32_t>(first.size()));
+
+    CompiledBatches b;
+    compiler.compile(second, 100, 100, 1, 1, b);
+    CHECK(compiler.lastCacheStats().hits == 1);
+    CHECK(compiler.lastCacheStats().misses == 0);
+
+    REQUIRE(b.groups.size() == 1);
+    const DrawGroup& g = b.groups[0];
+    REQUIRE(g.imageDraws.size() == 2);
+    CHECK(g.imageDraws[0].imageId == 4);
+    CHECK(g.imageDraws[1].imageId == 3);
+    REQUIRE(g.drawOps.size() == 4);
+    CHECK(g.drawOps[2].type == DrawOpType::Rect);
+    CHECK(g.drawOps[2].offset == 1);
+    CHECK(g.drawOps[3].type == DrawOpType::Image);
+    CHECK(g.drawOps[3].offset == 1);
+    REQUIRE(b.rects.size() == 2);
+    CHECK(b.rects[1].rect[2] == a.rects[1].rect[2]);
+    CHECK(b.rects[1].fillColor[0] == a.rects[1].fillColor[0]);
+}
+
+namespace {
+
+void recordBox(RenderCommandBuffer& buf, uintptr_t id, uint64_t version, float x, Color color) {
+    uint32_t begin = buf.pushBeginElement(id, version);
+    buf.pushSave();
+    buf.pushTranslate(x, 10);
+    buf.pushSetFillStyle(FillStyle::solid(color));
+    buf.pushDrawRect({0, 0, 20, 20}, CornerRadius());
+    buf.pushRestore();
+    buf.pushEndElement(begin);
+}
+
+bool covers(const std::vector<Rect>& damage, float x, float y) {
+    for (const Rect& r : damage) {
+        if (r.contains({x, y})) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+TEST_CASE("Compiler damage covers only elements whose output changed", "[commandbuffer]") {
+    CommandCompiler compiler;
+    auto frame = [](uint64_t bVersion, float bX, Color bColor, bool withC) {
+        RenderCommandBuffer buf;
+        buf.pushClear(Color(0, 0, 0, 1));
+        recordBox(buf, 0xa, 1, 10, Color(1, 0, 0, 1));
+        recordBox(buf, 0xb, bVersion, bX, bColor);
+        if (withC) recordBox(buf, 0xc, 1, 200, Color(0, 0, 1, 1));
+        return buf;
+    };
+
+    CompiledBatches out;
+    compiler.compile(frame(1, 100, Color(0, 1, 0, 1), true), 400, 100, 1, 1, out);
+    CHECK(out.fullDamage);
+
+    compiler.compile(frame(1, 100, Color(0, 1, 0, 1), true), 400, 100, 1, 1, out);
+    CHECK_FALSE(out.fullDamage);
+    CHECK(out.damage.empty());
+
+    // Re-recorded with identical output: nothing to redraw.
+    compiler.compile(frame(2, 100, Color(0, 1, 0, 1), true), 400, 100, 1, 1, out);
+    CHECK(out.damage.empty());
+
+    // Moved: both the old and the new position are damaged, the neighbours are not.
+    compiler.compile(frame(3, 150, Color(0, 1, 0, 1), true), 400, 100, 1, 1, out);
+    CHECK(covers(out.damage, 110, 20));
+    CHECK(covers(out.damage, 160, 20));
+    CHECK_FALSE(covers(out.damage, 20, 20));
+    CHECK_FALSE(covers(out.damage, 210, 20));
+    REQUIRE(out.groups.size() == 1);
+    REQUIRE(out.groups[0].drawOps.size() == 1);
+    const Rect& merged = out.groups[0].drawOps[0].bounds;
+    CHECK(merged.x <= 10);
+    CHECK(merged.x + merged.width >= 220);
+
+    // Removed: its last extent is damaged.
+    compiler.compile(frame(3, 150, Color(0, 1, 0, 1), false), 400, 100, 1, 1, out);
+    CHECK(covers(out.damage, 210, 20));
+    CHECK_FALSE(covers(out.damage, 160, 20));
+
+    compiler.compile(frame(3, 150, Color(0, 1, 0, 1), false), 500, 100, 1, 1, out);
+    CHECK(out.fullDamage);
+}
+
+TEST_CASE("Compiler merges adjacent draws of the same pipeline", "[commandbuffer]") {
+    RenderCommandBuffer buf;
+    buf.pushSetFillStyle(FillStyle::solid(Color(1, 0, 0, 1)));
+    for (int i = 0; i < 3; ++i) buf.pushDrawRect({i * 10.f, 0, 8, 8}, CornerRadius());
+    buf.pushDrawCircle({4, 24}, 4);
+    buf.pushDrawRect({0, 20, 8, 8}, CornerRadius());
+    buf.pushDrawImage(5, {0, 0, 8, 8}, ImageFit::Fill, CornerRadius(), 1.0f);
+    buf.pushDrawImage(5, {10, 0, 8, 8}, ImageFit::Fill, CornerRadius(), 1.0f);
+    buf.pushDrawImage(6, {20, 0, 8, 8}, ImageFit::Fill, CornerRadius(), 1.0f);
+
+    CommandCompiler compiler;
+    CompiledBatches out;
+    compiler.compile(buf, 100, 100, 1, 1, out);
+    CHECK(compiler.lastDrawCallStats().beforeMerge == 8);
+    CHECK(compiler.lastDrawCallStats().afterMerge == 5);
+
+    REQUIRE(out.groups.size() == 1);
+    const auto& ops = out.groups[0].drawOps;
+    REQUIRE(ops.size() == 5);
+    CHECK(ops[0].type == DrawOpType::Rect);
+    CHECK(ops[0].offset == 0);
+    CHECK(ops[0].count == 3);
+    CHECK(ops[0].bounds.x + ops[0].bounds.width >= 28);
+    CHECK(ops[1].type == DrawOpType::Circle);
+    CHECK(ops[2].type == DrawOpType::Rect);
+    CHECK(ops[2].offset == 3);
+    CHECK(ops[3].type == DrawOpType::Image);
+    CHECK(ops[3].count == 2);
+    CHECK(ops[4].type == DrawOpType::Image);
+    CHECK(ops[4].offset == 2);
+}
+
+TEST_CASE("Compiler batches non-overlapping draws across pipelines", "[commandbuffer]") {
+    CommandCompiler compiler;
+    CompiledBatches out;
+
+    // Four "buttons": a background rect with a circle on top, side by side.
+    RenderCommandBuffer buttons;
+    buttons.pushSetFillStyle(FillStyle::solid(Color(1, 0, 0, 1)));
+    for (int i = 0; i < 4; ++i) {
+        buttons.pushDrawRect({i * 40.f, 0, 30, 20}, CornerRadius());
+        buttons.pushDrawCircle({i * 40.f + 15, 10}, 5);
+    }
+    compiler.compile(buttons, 200, 100, 1, 1, out);
+    CHECK(compiler.lastDrawCallStats().beforeMerge == 8);
+    CHECK(compiler.lastDrawCallStats().afterMerge == 2);
+    REQUIRE(out.groups.size() == 1);
+    REQUIRE(out.groups[0].drawOps.size() == 2);
+    CHECK(out.groups[0].drawOps[0].type == DrawOpType::Rect);
+    CHECK(out.groups[0].drawOps[0].count == 4);
+    CHECK(out.groups[0].drawOps[1].type == DrawOpType::Circle);
+    CHECK(out.groups[0].drawOps[1].count == 4);
+    for (uint32_t i = 1; i < 4; ++i) {
+        const uint32_t base = out.groups[0].rectOffset;
+        CHECK(out.rects[base + i - 1].rect[0] < out.rects[base + i].rect[0]);
+    }
+
+    // A rect drawn over a circle has to stay after it.
+    RenderCommandBuffer stacked;
+    stacked.pushSetFillStyle(FillStyle::solid(Color(1, 0, 0, 1)));
+    stacked.pushDrawRect({0, 0, 30, 20}, CornerRadius());
+    stacked.pushDrawCircle({15, 10}, 5);
+    stacked.pushDrawRect({10, 5, 10, 10}, CornerRadius());
+    compiler.compile(stacked, 200, 100, 1, 1, out);
+    REQUIRE(out.groups.size() == 1);
+    REQUIRE(out.groups[0].drawOps.size() == 3);
+    CHECK(out.groups[0].drawOps[0].type == DrawOpType::Rect);
+    CHECK(out.groups[0].drawOps[1].type == DrawOpType::Circle);
+    CHECK(out.groups[0].drawOps[2].type == DrawOpType::Rect);
+}
+
+TEST_CASE("Command buffers compare by content", "[commandbuffer]") {
+    auto record = [](const Color& fill, float pathX) {
+        RenderCommandBuffer buf;
+        buf.pushSetFillStyle(FillStyle::solid(fill));
+        buf.pushDrawRect({0, 0, 10, 10}, CornerRadius());
+        Path p;
+        p.rect({pathX, 0, 5, 5});
+        buf.pushDrawPath(p);
+        return buf;
+    };
+    const RenderCommandBuffer a = record(Color(1, 0, 0, 1), 0);
+    CHECK(a.contentEquals(record(Color(1, 0, 0, 1), 0)));
+    // Same command words; only the pooled fill or path differs.
+    CHECK_FALSE(a.contentEquals(record(Color(0, 1, 0, 1), 0)));
+    CHECK_FALSE(a.contentEquals(record(Color(1, 0, 0, 1), 3)));
+}
+
+TEST_CASE("Compiler reuses moved subtrees by translating their output", "[commandbuffer]") {
+    // A clipped, horizontally scrolled container re-recorded each frame around
+    // children whose recordings are unchanged.
+    auto frame = [](uint64_t version, float scroll) {
+        RenderCommandBuffer buf;
+        buf.pushClear(Color(0, 0, 0, 1));
+        uint32_t begin = buf.pushBeginElement(0x1, version);
+        buf.pushSave();
+        Path clip;
+        clip.rect({0, 0, 150, 100});
+        buf.pushClipPath(clip);
+        buf.pushTranslate(-scroll, 0);
+        recordBox(buf, 0x10, 1, 10, Color(1, 0, 0, 1));
+        recordBox(buf, 0x11, 1, 60, Color(0, 1, 0, 1));
+        recordBox(buf, 0x12, 1, 160, Color(0, 0, 1, 1));
+        buf.pushRestore();
+        buf.pushEndElement(begin);
+        return buf;
+    };
+
+    CommandCompiler compiler;
+    CompiledBatches out;
+    compiler.compile(frame(1, 0), 400, 100, 1, 1, out);
+    compiler.compile(frame(2, 30), 400, 100, 1, 1, out);
+    CHECK(compiler.lastCacheStats().hits == 3);
+    CHECK(compiler.lastCacheStats().translated == 3);
+    CHECK(compiler.lastCacheStats().misses == 1);
+
+    CommandCompiler fresh;
+    CompiledBatches expected;
+    fresh.compile(frame(2, 30), 400, 100, 1, 1, expected);
+    REQUIRE(out.rects.size() == expected.rects.size());
+    for (size_t i = 0; i < out.rects.size(); ++i) {
+        CHECK(out.rects[i].rect[0] == expected.rects[i].rect[0]);
+        CHECK(out.rects[i].rect[1] == expected.rects[i].rect[1]);
+    }
+
+    CHECK(covers(out.damage, 20, 20));   // where the first box was
+    CHECK(covers(out.damage, 40, 20));   // where the second box is now
+    CHECK(covers(out.damage, 140, 20));  // the third box scrolled into view
+    CHECK_FALSE(covers(out.damage, 200, 20));
+}
+
+TEST_CASE("Compiler reuses clipped subtrees with their draw groups", "[commandbuffer]") {
+    // A panel under a window clip, holding a clipped container; only the panel moves.
+    auto frame = [](float panelX) {
+        RenderCommandBuffer buf;
+        buf.pushClear(Color(0, 0, 0, 1));
+        Path window;
+        window.rect({0, 0, 180, 100});
+        buf.pushClipPath(window);
+        buf.pushTranslate(panelX, 0);
+        uint32_t panel = buf.pushBeginElement(0x2, 1);
+        recordBox(buf, 0x20, 1, 0, Color(1, 1, 1, 1));
+        uint32_t begin = buf.pushBeginElement(0x1, 1);
+        buf.pushSave();
+        Path clip;
+        clip.rect({0, 0, 150, 100});
+        buf.pushClipPath(clip);
+        recordBox(buf, 0x10, 1, 10, Color(1, 0, 0, 1));
+        recordBox(buf, 0x11, 1, 160, Color(0, 0, 1, 1));
+        buf.pushRestore();
+        buf.pushEndElement(begin);
+        recordBox(buf, 0x21, 1, 120, Color(0, 1, 0, 1));
+        buf.pushEndElement(panel);
+        return buf;
+    };
+
+    auto checkMatchesFresh = [](const CompiledBatches& out, const RenderCommandBuffer& buf) {
+        CommandCompiler fresh;
+        CompiledBatches expected;
+        fresh.compile(buf, 400, 100, 1, 1, expected);
+        REQUIRE(out.groups.size() == expected.groups.size());
+        for (size_t i = 0; i < out.groups.size(); ++i) {
+            CHECK(out.groups[i].scissor == expected.groups[i].scissor);
+            CHECK(out.groups[i].rectOffset == expected.groups[i].rectOffset);
+            CHECK(out.groups[i].rectCount == expected.groups[i].rectCount);
+        }
+        REQUIRE(out.rects.size() == expected.rects.size());
+        for (size_t i = 0; i < out.rects.size(); ++i) {
+            CHECK(out.rects[i].rect[0] == expected.rects[i].rect[0]);
+            CHECK(out.rects[i].rect[1] == expected.rects[i].rect[1]);
+        }
+    };
+
+    CommandCompiler compiler;
+    CompiledBatches out;
+    compiler.compile(frame(0), 400, 100, 1, 1, out);
+    CHECK(compiler.lastCacheStats().misses == 6);
+
+    compiler.compile(frame(0), 400, 100, 1, 1, out);
+    CHECK(compiler.lastCacheStats().hits == 1);
+    CHECK(compiler.lastCacheStats().misses == 0);
+    checkMatchesFresh(out, frame(0));
+    CHECK(out.damage.empty());
+
+    // Moved, the container's own clip follows it while the window clip stays put.
+    compiler.compile(frame(50), 400, 100, 1, 1, out);
+    CHECK(compiler.lastCacheStats().hits == 1);
+    CHECK(compiler.lastCacheStats().translated == 1);
+    checkMatchesFresh(out, frame(50));
+    bool clippedGroup = false;
+    for (const auto& g : out.groups) {
+        if (g.scissor == ScissorState{true, 50, 0, 130, 100}) clippedGroup = true;
+    }
+    CHECK(clippedGroup);
+
+    // Moved again: damage follows from the last position, not the cached one.
+    compiler.compile(frame(60), 400, 100, 1, 1, out);
+    checkMatchesFresh(out, frame(60));
+    CHECK(covers(out.damage, 55, 20));
+    CHECK(covers(out.damage, 75, 20));
+    CHECK_FALSE(covers(out.damage, 45, 20));
+}
+
+TEST_CASE("Compiler stores each element's own output once", "[commandbuffer]") {
+    // A chain of nested elements, each drawing one box before its child.
+    constexpr int kDepth = 8;
+    auto frame = [](uint64_t leafVersion, float x) {
+        RenderCommandBuffer buf;
+        buf.pushClear(Color(0, 0, 0, 1));
+        buf.pushTranslate(x, 0);
+        std::vector<uint32_t> begins;
+        for (int i = 0; i < kDepth; ++i) {
+            begins.push_back(buf.pushBeginElement(0x100 + i, leafVersion));
+            buf.pushSetFillStyle(FillStyle::solid(Color(1, 0, 0, 1)));
+            buf.pushDrawRect({static_cast<float>(i * 30), 10, 20, 20}, CornerRadius());
+        }
+        recordBox(buf, 0x200, 1, 300, Color(0, 1, 0, 1));
+        for (int i = kDepth - 1; i >= 0; --i) buf.pushEndElement(begins[i]);
+        return buf;
+    };
+
+    CommandCompiler compiler;
+    CompiledBatches out;
+    compiler.compile(frame(1, 0), 400, 100, 1, 1, out);
+    CHECK(compiler.lastCacheStats().storedInstances == kDepth + 1);
+
+    // Every ancestor of the changed leaf misses, but stores only its own box.
+    compiler.compile(frame(2, 0), 400, 100, 1, 1, out);
+    CHECK(compiler.lastCacheStats().misses == kDepth);
+    CHECK(compiler.lastCacheStats().hits == 1);
+    CHECK(compiler.lastCacheStats().storedInstances == kDepth);
+
+    // The whole chain replays through its children's entries.
+    compiler.compile(frame(2, 40), 400, 100, 1, 1, out);
+    CHECK(compiler.lastCacheStats().hits == 1);
+    CHECK(compiler.lastCacheStats().storedInstances == 0);
+
+    CommandCompiler fresh;
+    CompiledBatches expected;
+    fresh.compile(frame(2, 40), 400, 100, 1, 1, expected);
+    REQUIRE(out.rects.size() == expected.rects.size());
+    for (size_t i = 0; i < out.rects.size(); ++i) {
+        CHECK(out.rects[i].rect[0] == expected.rects[i].rect[0]);
+        CHECK(out.rects[i].rect[1] == expected.rects[i].rect[1]);
+    }
+}
+
+TEST_CASE("Parallel compile matches the serial compile", "[commandbuffer]") {
+    // Each compiler rasterizes into its own atlas, so glyph UVs match only if both add
+    // the same glyphs in the same order.
+    auto device = gpu::createDevice(gpu::Backend::Software, {});
+    GlyphAtlas serialAtlas(device.get());
+    GlyphAtlas parallelAtlas(device.get());
+    if (!serialAtlas.ensureFontLoaded("default", FontWeight::regular) ||
+        !parallelAtlas.ensureFontLoaded("default", FontWeight::regular)) {
+        SKIP("No default font resolves on this system");
+    }
+
+    // A scrolled list of rows under a window element; rows hold nested boxes, some clipped,
+    // and a label whose words change with the row's version.
+    constexpr int kRows = 64;
+    auto label = [](int row, uint64_t version) -> std::string {
+        switch (version % 4) {
+            case 2: return "quick";
+            case 3: return "brown";
+            case 0: return "jumps";
+            default: return "Row " + std::to_string(row);
+        }
+    };
+    auto frame = [&](float scrollY, int changed, uint64_t version, bool swap) {
+        RenderCommandBuffer buf;
+        buf.pushClear(Color(0, 0, 0, 1));
+        buf.pushTranslate(0, scrollY);
+        uint32_t window = buf.pushBeginElement(0x1, version);
+        buf.pushSave();
+        for (int i = 0; i < kRows; ++i) {
+            const int row = swap && (i == 3 || i == 40) ? 43 - i : i;
+            const uint64_t rowVersion = changed < 0 || row == changed ? version : 1;
+            uint32_t begin = buf.pushBeginElement(0x100 + row, rowVersion);
+            buf.pushSave();
+            buf.pushTranslate(0, static_cast<float>(row * 12));
+            if (row % 5 == 0) {
+                Path clip;
+                clip.rect({0, 0, 90, 12});
+                buf.pushClipPath(clip);
+            }
+            buf.pushSetFillStyle(FillStyle::solid(Color(0.1f * (row % 10), 0, 1, 1)));
+            buf.pushDrawRect({0, 0, 200, 12}, CornerRadius(static_cast<float>(rowVersion)));
+            recordBox(buf, 0x10000 + row * 4, rowVersion, 4, Color(1, 0, 0, 1));
+            recordBox(buf, 0x10001 + row * 4, 1, 80, Color(0, 1, 0, 1));
+            buf.pushSetStrokeStyle(StrokeStyle::solid(Color(1, 1, 1, 1), 1));
+            buf.pushDrawLine({0, 11}, {200, 11});
+            buf.pushDrawCircle({190, 6}, 4);
+            TextStyle style;
+            style.size = static_cast<float>(10 + row % 3);
+            buf.pushSetFillStyle(FillStyle::solid(Color(1, 1, 1, 1)));
+            buf.pushSetTextStyle(style);
+            buf.pushDrawText(buf.internString(label(row, rowVersion)), {100, 0},
+                             HorizontalAlignment::leading, VerticalAlignment::top);
+            buf.pushRestore();
+            buf.pushEndElement(begin);
+        }
+        buf.pushRestore();
+        buf.pushEndElement(window);
+        return buf;
+    };
+
+    auto requireSame = [](const CompiledBatches& a, const CompiledBatches& b) {
+        auto sameBytes = [](const auto& x, const auto& y) {
+            return x.size() == y.size() &&
+                   (x.empty() || std::memcmp(x.data(), y.data(), x.size() * sizeof(x[0])) == 0);
+        };
+        CHECK(sameBytes(a.rects, b.rects));
+        CHECK(sameBytes(a.circles, b.circles));
+        CHECK(sameBytes(a.lines, b.lines));
+        CHECK(sameBytes(a.pathVertices, b.pathVertices));
+        CHECK(sameBytes(a.glyphs, b.glyphs));
+        REQUIRE(a.groups.size() == b.groups.size());
+        for (size_t i = 0; i < a.groups.size(); ++i) {
+            const DrawGroup& ga = a.groups[i];
+            const DrawGroup& gb = b.groups[i];
+            CHECK(ga.scissor == gb.scissor);
+            CHECK(ga.rectOffset == gb.rectOffset);
+            CHECK(ga.rectCount == gb.rectCount);
+            CHECK(ga.circleCount == gb.circleCount);
+            CHECK(ga.lineCount == gb.lineCount);
+            CHECK(ga.glyphOffset == gb.glyphOffset);
+            CHECK(ga.glyphCount == gb.glyphCount);
+            REQUIRE(ga.drawOps.size() == gb.drawOps.size());
+            for (size_t k = 0; k < ga.drawOps.size(); ++k) {
+                CHECK(ga.drawOps[k].type == gb.drawOps[k].type);
+                CHECK(ga.drawOps[k].offset == gb.drawOps[k].offset);
+                CHECK(ga.drawOps[k].count == gb.drawOps[k].count);
+                CHECK(ga.drawOps[k].pageIndex == gb.drawOps[k].pageIndex);
+            }
+        }
+        REQUIRE(a.damage.size() == b.damage.size());
+        for (size_t i = 0; i < a.damage.size(); ++i) CHECK(a.damage[i] == b.damage[i]);
+        CHECK(a.fullDamage == b.fullDamage);
+    };
+
+    CommandCompiler serial;
+    CommandCompiler parallel;
+    serial.setGlyphAtlas(&serialAtlas);
+    parallel.setGlyphAtlas(&parallelAtlas);
+    parallel.setWorkerThreads(3);
+    CompiledBatches expected, out;
+    struct Step { float scrollY; int changed; uint64_t version; bool swap; bool newGlyphs; };
+    const Step steps[] = {
+        {0, -1, 1, false, true},    // everything compiles; no glyph is rasterized yet
+        {0, 7, 2, false, true},     // one row changes
+        {-30, 7, 2, false, false},  // scrolled: the window replays translated
+        {-30, 50, 3, true, true},   // two rows trade places
+        {-42, -1, 4, true, true},   // every row changes while scrolling
+        {-42, -1, 4, true, false},  // unchanged
+        {-42, -1, 5, true, false},  // every row changes back to glyphs already rasterized
+    };
+    size_t fallbacks = 0;
+    for (const Step& s : steps) {
+        RenderCommandBuffer buf = frame(s.scrollY, s.changed, s.version, s.swap);
+        serial.compile(buf, 400, 600, 1, 1, expected);
+        parallel.compile(buf, 400, 600, 1, 1, out);
+        REQUIRE_FALSE(expected.glyphs.empty());
+        requireSame(out, expected);
+        CHECK(parallel.lastCacheStats().hits == serial.lastCacheStats().hits);
+        CHECK(parallel.lastCacheStats().misses == serial.lastCacheStats().misses);
+        CHECK(parallel.lastCacheStats().translated == serial.lastCacheStats().translated);
+        if (!s.newGlyphs) CHECK(parallel.lastParallelStats().fallbacks == 0);
+        fallbacks += parallel.lastParallelStats().fallbacks;
+    }
+    // Jobs that met unrasterized glyphs were compiled serially; the last step's ran on workers.
+    CHECK(fallbacks > 0);
+    CHECK(parallel.lastParallelStats().jobs > 0);
+}
@@ -0,0 +1,143 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <Flux/Views/RowHeightIndex.hpp>
+#include <cmath>
+#include <random>
+
+using namespace flux;
+
+namespace {
+
+// Reference answers by linear summation.
+double naiveOffset(const RowHeightIndex& index, size_t row) {
+    double total = 0.0;
+    for (size_t i = 0; i < row; ++i) total += index.height(i);
+    return total;
+}
+
+size_t naiveRowAt(const RowHeightIndex& index, double offset) {
+    double y = 0.0;
+    for (size_t i = 0; i < index.size(); ++i) {
+        y += index.height(i);
+        if (offset < y) return i;
+    }
+    return index.size() ? index.size() - 1 : 0;
+}
+
+} // namespace
+
+TEST_CASE("Row height index counts unmeasured rows at the estimate", "[rowheightindex]") {
+    RowHeightIndex index(100, 20.0f);
+    CHECK(index.totalHeight() == 2000.0);
+    CHECK(index.offsetOf(10) == 200.0);
+    CHECK(index.rowAt(0) == 0);
+    CHECK(index.rowAt(199.5) == 9);
+    CHECK(index.rowAt(200) == 10);
+    CHECK(index.rowAt(1e9) == 99);
+    CHECK_FALSE(index.isMeasured(3));
+
+    // Re-estimating moves every unmeasured row without touching measured ones.
+    index.setHeight(0, 50.0f);
+    index.setEstimatedHeight(30.0f);
+    CHECK(index.isMeasured(0));
+    CHECK(index.offsetOf(1) == 50.0);
+    CHECK(index.totalHeight() == 50.0 + 99 * 30.0);
+    CHECK(index.averageMeasuredHeight() == 50.0f);
+}
+
+TEST_CASE("Row height index matches linear sums as rows are measured", "[rowheightindex]") {
+    RowHeightIndex index(1000, 24.0f);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<size_t> pickRow(0, 999);
+    std::uniform_real_distribution<float> pickHeight(0.0f, 80.0f);
+
+    for (int step = 0; step < 500; ++step) {
+        index.setHeight(pickRow(rng), std::floor(pickHeight(rng)));
+        if (step % 50 != 0) continue;
+        for (size_t row : {size_t{0}, size_t{1}, size_t{499}, size_t{998}, size_t{1000}}) {
+            CHECK(index.offsetOf(row) == naiveOffset(index, row));
+        }
+        for (double offset : {0.0, 13.0, 5000.0, 12345.5, index.totalHeight() - 1.0}) {
+            INFO("offset = " << offset);
+            CHECK(index.rowAt(offset) == naiveRowAt(index, offset));
+        }
+    }
+
+    // Zero-height rows are skipped over rather than returned.
+    index.setHeight(5, 0.0f);
+    CHECK(index.rowAt(index.offsetOf(5)) == naiveRowAt(index, index.offsetOf(5)));
+}
+
+TEST_CASE("Row height index keeps measurements across resize", "[rowheightindex]") {
+    RowHeightIndex index(10, 10.0f);
+    index.setHeight(2, 40.0f);
+    index.setHeight(8, 40.0f);
+
+    index.resize(5);
+    CHECK(index.measuredCount() == 1);
+    CHECK(index.totalHeight() == 4 * 10.0 + 40.0);
+
+    index.resize(20);
+    CHECK(index.isMeasured(2));
+    CHECK_FALSE(index.isMeasured(8));
+    CHECK(index.offsetOf(20) == 19 * 10.0 + 40.0);
+
+    index.clearMeasurements();
+    CHECK(index.measuredCount() == 0);
+    CHECK(index.totalHeight() == 200.0);
+}
+
+TEST_CASE("Row height index grows in place as rows are appended", "[rowheightindex]") {
+    RowHeightIndex index(3, 20.0f);
+    index.setHeight(1, 50.0f);
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> pickHeight(0, 80);
+
+    // A log view: one row appended and measured at a time.
+    for (size_t n = 4; n <= 300; ++n) {
+        index.resize(n);
+        REQUIRE(index.size() == n);
+        CHECK_FALSE(index.isMeasured(n - 1));
+        CHECK(index.totalHeight() == naiveOffset(index, n));
+        if (n % 3 == 0) index.setHeight(n - 1, static_cast<float>(pickHeight(rng)));
+        if (n % 37 == 0) {
+            for (size_t row : {size_t{0}, size_t{2}, n / 2, n - 1, n}) {
+                CHECK(index.offsetOf(row) == naiveOffset(index, row));
+            }
+            for (double offset : {0.0, 70.0, index.totalHeight() / 3.0, index.totalHeight() - 1.0}) {
+                INFO("n = " << n << ", offset = " << offset);
+                CHECK(index.rowAt(offset) == naiveRowAt(index, offset));
+            }
+        }
+    }
+    CHECK(index.isMeasured(1));
+    CHECK(index.measuredCount() == 1 + 99);
+}
+
+TEST_CASE("Row height index lookups over a million rows", "[rowheightindex][!benchmark]") {
+    constexpr size_t kRows = 1'000'000;
+    RowHeightIndex index(kRows, 32.0f);
+    for (size_t i = 0; i < kRows; i += 7) index.setHeight(i, 16.0f + static_cast<float>(i % 64));
+    const double total = index.totalHeight();
+
+    BENCHMARK("rowAt") {
+        size_t acc = 0;
+        for (int i = 0; i < 1000; ++i) acc += index.rowAt(total * i / 1000.0);
+        return acc;
+    };
+
+    BENCHMARK("offsetOf") {
+        double acc = 0.0;
+        for (size_t i = 0; i < kRows; i += 1000) acc += index.offsetOf(i);
+        return acc;
+    };
+
+    size_t next = 0;
+    BENCHMARK("setHeight") {
+        for (int i = 0; i < 1000; ++i) {
+            index.setHeight(next, 20.0f + static_cast<float>(i % 30));
+            next = (next + 7919) % kRows;
+        }
+        return index.measuredCount();
+    };
+}
@@ -0,0 +1,385 @@
+#include <catch2/catch_test_macros.hpp>
+#include <Flux/GPU/Device.hpp>
+#include <Flux/GPU/FrameRing.hpp>
+#include <Flux/Graphics/CommandCompiler.hpp>
+#include <Flux/Graphics/GPURendererBackend.hpp>
+#include <algorithm>
+#include <cmath>
+
+using namespace flux;
+
+namespace {
+
+struct Pixel {
+    int r, g, b, a;
+};
+
+Pixel pixelAt(gpu::Device& device, int x, int y) {
+    std::vector<uint8_t> out;
+    REQUIRE(device.readPixels(x, y, 1, 1, out));
+    REQUIRE(out.size() == 4);
+    return {out[0], out[1], out[2], out[3]};
+}
+
+std::unique_ptr<gpu::RenderPipeline> makePipeline(gpu::Device& device, gpu::ShaderProgram program,
+                                                  uint32_t stride) {
+    gpu::RenderPipelineDesc desc;
+    desc.program = program;
+    desc.vertexBuffers = {{sizeof(float) * 2, false, {}}, {stride, true, {}}};
+    desc.colorFormat = device.swapchainFormat();
+    return device.createRenderPipeline(desc);
+}
+
+std::unique_ptr<gpu::Buffer> makeBuffer(gpu::Device& device, const void* data, size_t size) {
+    auto buffer = device.createBuffer({size, gpu::BufferUsage::Vertex});
+    buffer->write(data, size);
+    return buffer;
+}
+
+SDFQuadInstance solidRect(float x, float y, float w, float h, float r, float g, float b, float a) {
+    SDFQuadInstance inst{};
+    inst.rect[0] = x; inst.rect[1] = y; inst.rect[2] = w; inst.rect[3] = h;
+    inst.fillColor[0] = r; inst.fillColor[1] = g; inst.fillColor[2] = b; inst.fillColor[3] = a;
+    inst.opacity = 1.0f;
+    return inst;
+}
+
+} // namespace
+
+TEST_CASE("Software device clears and rasterizes SDF rects across tiles", "[gpu][software]") {
+    auto device = gpu::createDevice(gpu::Backend::Software, {});
+    device->resize(200, 150);
+    auto pipeline = makePipeline(*device, gpu::ShaderProgram::SDFRect, sizeof(SDFQuadInstance));
+
+    // Spans the 64px tile boundaries in both axes.
+    SDFQuadInstance inst = solidRect(50, 40, 100, 60, 1, 0, 0, 1);
+    auto instances = makeBuffer(*device, &inst, sizeof(inst));
+
+    REQUIRE(device->beginFrame());
+    gpu::RenderPassDesc pass;
+    pass.clearColor = {0, 0, 1, 1};
+    auto* enc = device->beginRenderPass(pass);
+    REQUIRE(enc != nullptr);
+    enc->setPipeline(pipeline.get());
+    enc->setVertexBuffer(1, instances.get());
+    enc->draw(6, 1, 0, 0);
+    device->endRenderPass();
+    device->endFrame();
+
+    Pixel inside = pixelAt(*device, 100, 70);
+    CHECK(inside.r == 255);
+    CHECK(inside.b == 0);
+    Pixel corner = pixelAt(*device, 51, 41);
+    CHECK(corner.r > 200);
+    Pixel outside = pixelAt(*device, 10, 10);
+    CHECK(outside.r == 0);
+    CHECK(outside.b == 255);
+    Pixel farCorner = pixelAt(*device, 199, 149);
+    CHECK(farCorner.b == 255);
+}
+
+TEST_CASE("Software device honours scissor and shades shared path edges once", "[gpu][software]") {
+    auto device = gpu::createDevice(gpu::Backend::Software, {});
+    device->resize(64, 64);
+
+    gpu::RenderPipelineDesc desc;
+    desc.program = gpu::ShaderProgram::Path;
+    desc.vertexBuffers = {{sizeof(PathVertex), false, {}}};
+    auto pathPipeline = device->createRenderPipeline(desc);
+
+    // Two triangles forming a 40×40 half-transparent white square; the diagonal is shared.
+    auto v = [](float x, float y) { return PathVertex{x, y, {1, 1, 1, 0.5f}, {64, 64}}; };
+    PathVertex verts[] = {v(10, 10), v(50, 10), v(50, 50), v(10, 10), v(50, 50), v(10, 50)};
+    auto vb = makeBuffer(*device, verts, sizeof(verts));
+
+    REQUIRE(device->beginFrame());
+    gpu::RenderPassDesc pass;
+    pass.clearColor = {0, 0, 0, 1};
+    auto* enc = device->beginRenderPass(pass);
+    enc->setScissorRect(0, 0, 40, 64);
+    enc->setPipeline(pathPipeline.get());
+    enc->setVertexBuffer(0, vb.get());
+    enc->draw(6, 1, 0, 0);
+    device->endRenderPass();
+    device->endFrame();
+
+    std::vector<uint8_t> row;
+    REQUIRE(device->readPixels(10, 30, 30, 1, row));
+    for (size_t i = 0; i < row.size(); i += 4) {
+        INFO("x = " << 10 + i / 4);
+        CHECK(row[i] == 128);
+    }
+    CHECK(pixelAt(*device, 45, 30).r == 0);  // clipped by scissor
+    CHECK(pixelAt(*device, 30, 55).r == 0);  // outside the square
+}
+
+TEST_CASE("Software device snapshots instance data at draw time", "[gpu][software]") {
+    auto device = gpu::createDevice(gpu::Backend::Software, {});
+    device->resize(32, 16);
+    auto pipeline = makePipeline(*device, gpu::ShaderProgram::Image, sizeof(ImageInstance));
+
+    const uint8_t green[4] = {0, 255, 0, 255};
+    auto texture = device->createTexture({1, 1, gpu::PixelFormat::RGBA8});
+    texture->write(green, 0, 0, 1, 1);
+
+    ImageInstance inst{};
+    inst.screenRect[2] = 16; inst.screenRect[3] = 16;
+    inst.uvRect[2] = 1; inst.uvRect[3] = 1;
+    for (float& t : inst.tint) t = 1.0f;
+    auto instances = device->createBuffer({sizeof(inst), gpu::BufferUsage::Vertex});
+
+    REQUIRE(device->beginFrame());
+    auto* enc = device->beginRenderPass({});
+    enc->setPipeline(pipeline.get());
+    enc->setVertexBuffer(1, instances.get());
+    enc->setFragmentTexture(0, texture.get());
+    instances->write(&inst, sizeof(inst));
+    enc->draw(6, 1);
+    // Rewriting a buffer between draws must not change what the earlier draw sees.
+    inst.screenRect[0] = 16;
+    instances->write(&inst, sizeof(inst));
+    enc->draw(6, 1);
+    device->endRenderPass();
+    device->endFrame();
+
+    CHECK(pixelAt(*device, 8, 8).g == 255);
+    CHECK(pixelAt(*device, 24, 8).g == 255);
+}
+
+TEST_CASE("Software device scales distance-field glyphs with a one-pixel edge", "[gpu][software]") {
+    auto device = gpu::createDevice(gpu::Backend::Software, {});
+    device->resize(64, 64);
+    auto pipeline = makePipeline(*device, gpu::ShaderProgram::GlyphSDF, sizeof(GlyphInstance));
+
+    // A disc of radius 5 in a 16x16 field, 0.5 on the outline and 4 texels of spread.
+    std::vector<uint8_t> field(16 * 16);
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 16; ++x) {
+            const float d = 5.0f - std::hypot(x + 0.5f - 8.0f, y + 0.5f - 8.0f);
+            field[y * 16 + x] =
+                static_cast<uint8_t>(std::clamp(0.5f + d / 8.0f, 0.0f, 1.0f) * 255.0f + 0.5f);
+        }
+    }
+    auto texture = device->createTexture({16, 16, gpu::PixelFormat::R8});
+    texture->write(field.data(), 0, 0, 16, 16);
+
+    // Drawn 4x larger than the field: a disc of radius 20 centred at (32, 32).
+    GlyphInstance inst{};
+    inst.screenRect[0] = 0; inst.screenRect[1] = 0;
+    inst.screenRect[2] = 64; inst.screenRect[3] = 64;
+    inst.uvRect[2] = 1; inst.uvRect[3] = 1;
+    for (float& c : inst.color) c = 1.0f;
+    inst.viewport[0] = 64; inst.viewport[1] = 64;
+    auto instances = makeBuffer(*device, &inst, sizeof(inst));
+
+    REQUIRE(device->beginFrame());
+    gpu::RenderPassDesc pass;
+    pass.clearColor = {0, 0, 0, 1};
+    auto* enc = device->beginRenderPass(pass);
+    enc->setPipeline(pipeline.get());
+    enc->setVertexBuffer(1, instances.get());
+    enc->setFragmentTexture(0, texture.get());
+    enc->draw(6, 1);
+    device->endRenderPass();
+    device->endFrame();
+
+    CHECK(pixelAt(*device, 32, 32).r == 255);
+    CHECK(pixelAt(*device, 32 + 17, 32).r == 255);   // 2.5px inside the outline
+    CHECK(pixelAt(*device, 32 + 22, 32).r == 0);     // 2.5px outside
+    // Centre (44.5, 47.5) is 0.09px inside: partly covered, not a blurred edge.
+    const int edge = pixelAt(*device, 44, 47).r;
+    CHECK(edge > 60);
+    CHECK(edge < 230);
+    CHECK(pixelAt(*device, 2, 2).r == 0);
+}
+
+TEST_CASE("Frame ring sub-allocates mapped ranges that draw at their offsets", "[gpu][software]") {
+    auto device = gpu::createDevice(gpu::Backend::Software, {});
+    device->resize(64, 16);
+    auto pipeline = makePipeline(*device, gpu::ShaderProgram::SDFRect, sizeof(SDFQuadInstance));
+    gpu::FrameRing ring(device.get(), 320);
+
+    REQUIRE(device->beginFrame());
+    ring.beginFrame();
+    std::vector<SDFQuadInstance> red = {solidRect(0, 0, 16, 16, 1, 0, 0, 1)};
+    std::vector<SDFQuadInstance> green = {solidRect(16, 0, 16, 16, 0, 1, 0, 1),
+                                          solidRect(32, 0, 16, 16, 0, 1, 0, 1)};
+    gpu::RingSlice a = ring.upload(red);
+    gpu::RingSlice b = ring.upload(green);
+    REQUIRE(a);
+    REQUIRE(b);
+    CHECK(a.buffer == b.buffer);
+    CHECK(b.offset >= sizeof(SDFQuadInstance));
+    CHECK(b.offset % 16 == 0);
+    // Does not fit in the 320-byte buffer: spills into a second one.
+    gpu::RingSlice c = ring.upload(std::vector<SDFQuadInstance>{solidRect(48, 0, 16, 16, 0, 0, 1, 1)});
+    REQUIRE(c);
+    CHECK(c.buffer != a.buffer);
+    CHECK(ring.bytesAllocated() == 4 * sizeof(SDFQuadInstance));
+
+    auto* enc = device->beginRenderPass({});
+    enc->setPipeline(pipeline.get());
+    enc->setVertexBuffer(1, a.buffer, a.offset);
+    enc->draw(6, 1);
+    enc->setVertexBuffer(1, b.buffer, b.offset);
+    enc->draw(6, 2);
+    enc->setVertexBuffer(1, c.buffer, c.offset);
+    enc->draw(6, 1);
+    device->endRenderPass();
+    ring.flush();
+    device->endFrame();
+
+    CHECK(pixelAt(*device, 8, 8).r == 255);
+    CHECK(pixelAt(*device, 24, 8).g == 255);
+    CHECK(pixelAt(*device, 40, 8).g == 255);
+    CHECK(pixelAt(*device, 56, 8).b == 255);
+
+    // The next frame on this slot gets one buffer large enough for everything.
+    REQUIRE(device->beginFrame());
+    ring.beginFrame();
+    gpu::RingSlice d = ring.upload(red);
+    gpu::RingSlice e = ring.upload(green);
+    gpu::RingSlice f = ring.upload(red);
+    CHECK(d.buffer == e.buffer);
+    CHECK(e.buffer == f.buffer);
+    CHECK(d.offset == 0);
+    device->endFrame();
+}
+
+TEST_CASE("Pipelined backend draws the frames queued to its render thread", "[gpu][software]") {
+    auto frame = [](float x, Color color) {
+        RenderCommandBuffer buf;
+        buf.pushClear(Color(0, 0, 0, 1));
+        uint32_t begin = buf.pushBeginElement(0x1, static_cast<uint64_t>(x) + 1);
+        buf.pushSetFillStyle(FillStyle::solid(color));
+        buf.pushDrawRect({x, 0, 16, 16}, CornerRadius());
+        buf.pushEndElement(begin);
+        return buf;
+    };
+
+    auto syncDevice = gpu::createDevice(gpu::Backend::Software, {});
+    auto pipeDevice = gpu::createDevice(gpu::Backend::Software, {});
+    syncDevice->resize(96, 16);
+    pipeDevice->resize(96, 16);
+    GPURendererBackend sync(syncDevice.get());
+    GPURendererBackend pipelined(pipeDevice.get());
+    sync.setViewportSize(96, 16);
+    pipelined.setViewportSize(96, 16);
+    pipelined.setPipelined(true);
+    REQUIRE(pipelined.pipelined());
+
+    // More frames than fit in the queue: execute() waits for the render thread.
+    for (int i = 0; i < 6; ++i) {
+        RenderCommandBuffer buf = frame(static_cast<float>(i * 16), Color(1, 0, 0, 1));
+        sync.execute(buf);
+        pipelined.execute(buf);
+    }
+    pipelined.finishFrames();
+    std::vector<uint8_t> expected, actual;
+    REQUIRE(syncDevice->readPixels(0, 0, 96, 16, expected));
+    REQUIRE(pipeDevice->readPixels(0, 0, 96, 16, actual));
+    CHECK(actual == expected);
+    CHECK(pixelAt(*pipeDevice, 88, 8).r == 255);
+    CHECK(pixelAt(*pipeDevice, 8, 8).r == 0);
+
+    // A viewport change drains the queue before it applies.
+    RenderCommandBuffer last = frame(8, Color(0, 1, 0, 1));
+    pipelined.execute(last);
+    pipelined.setViewportSize(96, 16);
+    CHECK(pixelAt(*pipeDevice, 12, 8).g == 255);
+
+    pipelined.setPipelined(false);
+    CHECK_FALSE(pipelined.pipelined());
+}
+
+TEST_CASE("Backend recompiles an unchanged frame after the glyph atlas generation moves", "[gpu][software]") {
+    RenderCommandBuffer buf;
+    buf.pushClear(Color(0, 0, 0, 1));
+    uint32_t begin = buf.pushBeginElement(0x1, 1);
+    buf.pushSetFillStyle(FillStyle::solid(Color(1, 0, 0, 1)));
+    buf.pushDrawRect({0, 0, 16, 16}, CornerRadius());
+    buf.pushEndElement(begin);
+
+    auto device = gpu::createDevice(gpu::Backend::Software, {});
+    device->resize(32, 16);
+    GPURendererBackend backend(device.get());
+    backend.setViewportSize(32, 16);
+    REQUIRE(backend.glyphAtlas() != nullptr);
+
+    backend.execute(buf);
+    backend.execute(buf);
+    CHECK(backend.skippedCompiles() == 1);
+
+    // Glyph quads compiled before the bump may point at pages that changed.
+    backend.glyphAtlas()->setSdfThreshold(48);
+    backend.execute(buf);
+    CHECK(backend.skippedCompiles() == 1);
+    backend.execute(buf);
+    CHECK(backend.skippedCompiles() == 2);
+    CHECK(pixelAt(*device, 8, 8).r == 255);
+}
+
+TEST_CASE("Backend copies only the changed ranges of an instance stream", "[gpu][software]") {
+    // Only the element at `changed` records a new version and color.
+    auto frame = [](int changed, uint32_t version) {
+        RenderCommandBuffer buf;
+        buf.pushClear(Color(0, 0, 0, 1));
+        for (int i = 0; i < 64; ++i) {
+            uint32_t begin = buf.pushBeginElement(0x100 + i, i == changed ? version : 1);
+            const Color color = i == changed && version % 2 == 0 ? Color(0, 1, 0, 1)
+                                                                 : Color(1, 0, 0, 1);
+            buf.pushSetFillStyle(FillStyle::solid(color));
+            buf.pushDrawRect({static_cast<float>(i % 16) * 8, static_cast<float>(i / 16) * 8, 8, 8},
+                             CornerRadius());
+            buf.pushEndElement(begin);
+        }
+        return buf;
+    };
+
+    auto device = gpu::createDevice(gpu::Backend::Software, {});
+    device->resize(128, 32);
+    GPURendererBackend backend(device.get());
+    backend.setViewportSize(128, 32);
+
+    backend.execute(frame(-1, 1));
+    const size_t full = backend.streamBytesCopied();
+    CHECK(full >= 64 * sizeof(SDFQuadInstance));
+
+    // One instance changed: at most the two blocks it straddles are copied.
+    backend.execute(frame(37, 2));
+    CHECK(backend.streamBytesCopied() > 0);
+    CHECK(backend.streamBytesCopied() <= 512);
+    CHECK(pixelAt(*device, 5 * 8 + 4, 2 * 8 + 4).g == 255);
+    CHECK(pixelAt(*device, 6 * 8 + 4, 2 * 8 + 4).r == 255);
+
+    // Back to the first frame's color; nothing else moved.
+    backend.execute(frame(37, 3));
+    CHECK(backend.streamBytesCopied() <= 512);
+    CHECK(pixelAt(*device, 5 * 8 + 4, 2 * 8 + 4).r == 255);
+}
+
+TEST_CASE("Backend compiles on the software device's workers", "[gpu][software]") {
+    auto device = gpu::createDevice(gpu::Backend::Software, {});
+    device->resize(32, 16);
+    REQUIRE(device->workerPool() != nullptr);
+    GPURendererBackend backend(device.get());
+    backend.setViewportSize(32, 16);
+
+    backend.setCompileThreads(3);
+    CHECK(backend.compiler().workerPool() == device->workerPool());
+
+    RenderCommandBuffer buf;
+    buf.pushClear(Color(0, 0, 0, 1));
+    for (uint32_t i = 0; i < 2; ++i) {
+        uint32_t begin = buf.pushBeginElement(0x10 + i, 1);
+        buf.pushSetFillStyle(FillStyle::solid(i == 0 ? Color(1, 0, 0, 1) : Color(0, 1, 0, 1)));
+        buf.pushDrawRect({static_cast<float>(i) * 16, 0, 16, 16}, CornerRadius());
+        buf.pushEndElement(begin);
+    }
+    backend.execute(buf);
+    CHECK(pixelAt(*device, 8, 8).r == 255);
+    CHECK(pixelAt(*device, 24, 8).g == 255);
+
+    backend.setCompileThreads(0);
+    CHECK(backend.compiler().workerPool() == nullptr);
+}